@@ -1,4 +1,4 @@
-QT += core gui widgets network websockets
+QT += core gui widgets network websockets concurrent
 CONFIG += c++20
 TEMPLATE = app
 TARGET = PaperTrader
@@ -14,12 +14,27 @@ SOURCES += \
     core/papertraderapp.cpp \
     core/marketdataprovider.cpp \
     core/chartmanager.cpp \
+    core/candlestore.cpp \
     core/ordermanager.cpp \
+    core/orderhistory.cpp \
+    core/orderindex.cpp \
+    core/orderoverlaystore.cpp \
     core/portfoliomanager.cpp \
     core/executionsimulator.cpp \
+    core/exchangesimulator.cpp \
+    core/stoptriggerindex.cpp \
+    core/timerwheel.cpp \
+    core/basketimport.cpp \
+    core/indicatorengine.cpp \
+    core/indicatorkernels.cpp \
+    core/tickdecimator.cpp \
     core/storagemanager.cpp \
     ui/mainwindow.cpp \
     ui/chartwidget.cpp \
+    ui/chartrenderer.cpp \
+    ui/models/orderhistorymodel.cpp \
+    ui/models/ordersmodel.cpp \
+    ui/models/positionsmodel.cpp \
     ui/controllers/tradingcontroller.cpp \
     ui/controllers/chartcontroller.cpp
 
@@ -28,18 +43,37 @@ HEADERS += \
     core/papertraderapp.h \
     core/marketdataprovider.h \
     core/chartmanager.h \
+    core/candlestore.h \
     core/ordermanager.h \
+    core/orderhistory.h \
+    core/densemap.h \
+    core/orderindex.h \
+    core/orderoverlaystore.h \
     core/portfoliomanager.h \
     core/storagemanager.h \
     core/executionsimulator.h \
+    core/exchangesimulator.h \
+    core/stoptriggerindex.h \
+    core/timerwheel.h \
+    core/basketimport.h \
+    core/indicatorengine.h \
+    core/indicatorkernels.h \
+    core/tickdecimator.h \
     core/models/candle.h \
+    core/models/candlecolumns.h \
+    core/models/candlehistory.h \
     core/models/quote.h \
     core/models/order.h \
+    core/models/ordertypes.h \
     core/models/executionreport.h \
     core/models/position.h \
     core/models/portfoliosnapshot.h \
     ui/mainwindow.h \
     ui/chartwidget.h \
+    ui/chartrenderer.h \
+    ui/models/orderhistorymodel.h \
+    ui/models/ordersmodel.h \
+    ui/models/positionsmodel.h \
     ui/controllers/tradingcontroller.h \
     ui/controllers/chartcontroller.h
 
@@ -52,6 +86,7 @@ INCLUDEPATH += \
     core \
     core/models \
     ui \
+    ui/models \
     ui/controllers
 
 # --- Build output directories ---
@@ -0,0 +1,109 @@
+#include "basketimport.h"
+
+#include <optional>
+
+namespace {
+
+std::optional<OrderSide> parseSide(const QString &text)
+{
+    if (text == QLatin1String("buy"))
+        return OrderSide::Buy;
+    if (text == QLatin1String("sell"))
+        return OrderSide::Sell;
+    return std::nullopt;
+}
+
+std::optional<OrderType> parseType(const QString &text)
+{
+    if (text == QLatin1String("market"))
+        return OrderType::Market;
+    if (text == QLatin1String("limit"))
+        return OrderType::Limit;
+    if (text == QLatin1String("stop"))
+        return OrderType::Stop;
+    if (text == QLatin1String("stop_limit"))
+        return OrderType::StopLimit;
+    if (text == QLatin1String("trailing_stop"))
+        return OrderType::TrailingStop;
+    return std::nullopt;
+}
+
+std::optional<TimeInForce> parseTimeInForce(const QString &text)
+{
+    if (text.isEmpty() || text == QLatin1String("gtc"))
+        return TimeInForce::GTC;
+    if (text == QLatin1String("ioc"))
+        return TimeInForce::IOC;
+    if (text == QLatin1String("fok"))
+        return TimeInForce::FOK;
+    if (text == QLatin1String("day"))
+        return TimeInForce::DAY;
+    return std::nullopt;
+}
+
+// Empty optional columns read as 0.
+bool parseNumber(const QStringList &fields, int column, double &value)
+{
+    value = 0.0;
+    if (column >= fields.size() || fields.at(column).isEmpty())
+        return true;
+    bool ok = false;
+    value = fields.at(column).toDouble(&ok);
+    return ok;
+}
+
+} // namespace
+
+BasketImport::Result BasketImport::parseCsv(const QString &text)
+{
+    Result result;
+    const QStringList lines = text.split(QLatin1Char('\n'));
+    result.orders.reserve(lines.size());
+
+    for (int i = 0; i < lines.size(); ++i) {
+        const QString line = lines.at(i).trimmed();
+        if (line.isEmpty() || line.startsWith(QLatin1String("#")))
+            continue;
+        if (i == 0 && line.startsWith(QLatin1String("symbol"), Qt::CaseInsensitive))
+            continue;
+
+        QStringList fields = line.split(QLatin1Char(','));
+        for (QString &field : fields)
+            field = field.trimmed().toLower();
+
+        const auto fail = [&](const QString &message) {
+            result.errors.append(QStringLiteral("line %1: %2").arg(i + 1).arg(message));
+        };
+        if (fields.size() < 4) {
+            fail(QStringLiteral("expected symbol,side,type,quantity"));
+            continue;
+        }
+
+        const auto side = parseSide(fields.at(1));
+        const auto type = parseType(fields.at(2));
+        const auto tif = parseTimeInForce(fields.size() > 6 ? fields.at(6) : QString());
+        OrderRequest request;
+        bool numbersOk = parseNumber(fields, 3, request.quantity);
+        double stop = 0.0;
+        numbersOk = parseNumber(fields, 4, request.price) && numbersOk;
+        numbersOk = parseNumber(fields, 5, stop) && numbersOk;
+        if (!side || !type || !tif || !numbersOk) {
+            fail(!side   ? QStringLiteral("unknown side")
+                 : !type ? QStringLiteral("unknown order type")
+                 : !tif  ? QStringLiteral("unknown time in force")
+                         : QStringLiteral("invalid number"));
+            continue;
+        }
+
+        request.symbol = fields.at(0).toUpper();
+        request.side = *side;
+        request.type = *type;
+        request.timeInForce = *tif;
+        if (request.type == OrderType::TrailingStop)
+            request.trailAmount = stop;
+        else
+            request.stopPrice = stop;
+        result.orders.append(request);
+    }
+    return result;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include "models/order.h"
+
+/**
+ * BasketImport: order baskets from CSV text.
+ *
+ * One order per line: symbol,side,type,quantity[,price[,stop[,tif]]].
+ * Side is buy or sell; type is market, limit, stop, stop_limit or
+ * trailing_stop; tif is gtc (default), ioc, fok or day. For trailing stops
+ * the stop column holds the trail distance. A first line starting with
+ * "symbol" is taken as a header; blank lines and lines starting with '#'
+ * are skipped.
+ */
+namespace BasketImport {
+
+struct Result {
+    QList<OrderRequest> orders;
+    QStringList errors;   // "line N: ..." for each line that was skipped
+};
+
+Result parseCsv(const QString &text);
+
+} // namespace BasketImport
@@ -0,0 +1,101 @@
+#include "candlestore.h"
+
+#include <algorithm>
+
+CandleStore::CandleStore(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void CandleStore::setDefaultIndicators(const QVector<IndicatorSpec> &specs)
+{
+    m_defaultIndicators = specs;
+}
+
+int CandleStore::indicatorId(IndicatorSpec::Kind kind) const
+{
+    for (int i = 0; i < m_defaultIndicators.size(); ++i) {
+        if (m_defaultIndicators[i].kind == kind)
+            return i;
+    }
+    return -1;
+}
+
+const CandleSeries *CandleStore::series(const QString &symbol) const
+{
+    const auto it = m_series.find(key(symbol));
+    return it != m_series.end() ? it->second.get() : nullptr;
+}
+
+CandleSeries *CandleStore::ensureSeries(const QString &symbol)
+{
+    const QString k = key(symbol);
+    auto it = m_series.find(k);
+    if (it != m_series.end())
+        return it->second.get();
+
+    auto created = std::make_unique<CandleSeries>();
+    created->symbol = k;
+    for (const IndicatorSpec &spec : m_defaultIndicators)
+        created->indicators.addIndicator(spec);
+    return m_series.emplace(k, std::move(created)).first->second.get();
+}
+
+QStringList CandleStore::symbols() const
+{
+    QStringList out;
+    for (const auto &entry : m_series)
+        out.append(entry.first);
+    return out;
+}
+
+void CandleStore::append(const Candle &c)
+{
+    CandleSeries *s = ensureSeries(c.symbol);
+    s->bars.append(c);
+    s->indicators.append(c);
+    emit candleAppended(s->symbol, s->bars.size() - 1);
+}
+
+void CandleStore::appendTick(const QString &symbol, qint64 ms, double price)
+{
+    CandleSeries *s = ensureSeries(symbol);
+    if (s->ticks.size() >= kMaxTicks)
+        s->ticks.trimFront(kMaxTicks / 4);
+    s->ticks.append(ms, price);
+    emit tickAppended(s->symbol);
+}
+
+void CandleStore::reset(const QString &symbol)
+{
+    CandleSeries *s = ensureSeries(symbol);
+    s->bars.clear();
+    s->indicators.clear();
+    s->ticks.clear();
+    emit seriesReset(s->symbol);
+}
+
+int CandleStore::prependBars(const QString &symbol, const CandleColumns &page)
+{
+    CandleSeries *s = ensureSeries(symbol);
+    const int count = std::min(page.size(), kMaxBars - s->bars.size());
+    if (count <= 0)
+        return 0;
+
+    s->bars.prepend(page, count);
+    s->indicators.recompute(s->bars);
+    emit barsPrepended(s->symbol, count);
+    return count;
+}
+
+void CandleStore::trimFront(const QString &symbol, int keep)
+{
+    CandleSeries *s = ensureSeries(symbol);
+    const int count = s->bars.size() - std::max(0, keep);
+    if (count <= 0)
+        return;
+
+    s->bars.removeFirst(count);
+    s->indicators.recompute(s->bars);
+    emit barsTrimmed(s->symbol, count);
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <map>
+#include <memory>
+
+#include "indicatorengine.h"
+#include "models/candle.h"
+#include "models/candlecolumns.h"
+#include "models/candlehistory.h"
+#include "tickdecimator.h"
+
+// One symbol's bars plus the indicators computed over them. Charts read the
+// series in place, so any number of views cost one copy of the data.
+struct CandleSeries {
+    QString symbol;
+    CandleHistory bars;
+    IndicatorEngine indicators;
+    TickColumns ticks;
+};
+
+/**
+ * CandleStore: per-symbol candle history shared by every chart.
+ *
+ * Series are created on first use with the default indicator set and live as
+ * long as the store, so views may keep pointers to them.
+ */
+class CandleStore : public QObject {
+    Q_OBJECT
+public:
+    explicit CandleStore(QObject *parent = nullptr);
+
+    // Applied to series created afterwards; ids match the order given.
+    void setDefaultIndicators(const QVector<IndicatorSpec> &specs);
+    int indicatorId(IndicatorSpec::Kind kind) const;
+
+    const CandleSeries *series(const QString &symbol) const;
+    CandleSeries *ensureSeries(const QString &symbol);
+    QStringList symbols() const;
+
+    void append(const Candle &c);
+    // Oldest ticks are trimmed in blocks once a series holds kMaxTicks.
+    void appendTick(const QString &symbol, qint64 ms, double price);
+    void reset(const QString &symbol);
+
+    // Older bars (e.g. a page read from disk) in front of the series; every
+    // existing index shifts by the count added. Indicators are recomputed.
+    // Returns the number of bars added, which stops at kMaxBars.
+    int prependBars(const QString &symbol, const CandleColumns &page);
+    // Releases all but the newest `keep` bars.
+    void trimFront(const QString &symbol, int keep);
+
+    static constexpr int kMaxTicks = 1 << 21;
+    static constexpr int kMaxBars = 500000;
+    // Bars kept in memory once a chart is back at the live edge.
+    static constexpr int kResidentBars = 20000;
+
+    static QString key(const QString &symbol) { return symbol.trimmed().toUpper(); }
+
+signals:
+    void candleAppended(const QString &symbol, int index);
+    void tickAppended(const QString &symbol);
+    void seriesReset(const QString &symbol);
+    void barsPrepended(const QString &symbol, int count);
+    void barsTrimmed(const QString &symbol, int count);
+
+private:
+    std::map<QString, std::unique_ptr<CandleSeries>> m_series;
+    QVector<IndicatorSpec> m_defaultIndicators;
+};
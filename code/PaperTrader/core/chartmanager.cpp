@@ -6,9 +6,24 @@
 #include "storagemanager.h"
 
 ChartManager::ChartManager(QObject *parent)
-    : QObject(parent)
+    : QObject(parent),
+      m_store(new CandleStore(this))
 {
     qRegisterMetaType<Quote>("Quote");
+
+    m_store->setDefaultIndicators({
+        {IndicatorSpec::Kind::SMA, 20},
+        {IndicatorSpec::Kind::EMA, 50},
+        {IndicatorSpec::Kind::Bollinger, 20, 2.0},
+        {IndicatorSpec::Kind::RSI, 14},
+        {IndicatorSpec::Kind::ATR, 14},
+        {IndicatorSpec::Kind::VWAP, 0},
+    });
+
+    // Trimmed bars are still on disk, so paging may resume.
+    connect(m_store, &CandleStore::barsTrimmed, this, [this](const QString &symbol, int) {
+        m_historyExhausted.remove(symbol);
+    });
 }
 
 void ChartManager::setMarketDataProvider(MarketDataProvider *provider)
@@ -25,7 +40,13 @@ void ChartManager::setMarketDataProvider(MarketDataProvider *provider)
 
 void ChartManager::setStorageManager(StorageManager *storage)
 {
+    if (m_storage)
+        disconnect(m_storage, nullptr, this, nullptr);
     m_storage = storage;
+    if (m_storage) {
+        connect(m_storage, &StorageManager::historyLoaded,
+                this, &ChartManager::handleHistoryLoaded);
+    }
 }
 
 void ChartManager::setFeedMode(MarketDataProvider::FeedMode mode)
@@ -47,6 +68,10 @@ bool ChartManager::startFeed(const QString &symbol)
     attachProvider(m_provider);
 
     m_lastSymbol = trimmed.toUpper();
+    // The feed may label its bars differently from the requested symbol
+    // (the synthetic feed says TEST), so the series to restart is only
+    // known once its first bar arrives.
+    m_resetOnNextCandle = true;
     m_lastQuote = {};
     m_lastQuote.symbol = m_lastSymbol;
     m_lastQuote.timestamp = QDateTime::currentDateTimeUtc();
@@ -108,11 +133,57 @@ void ChartManager::handleCandle(const Candle &c)
     m_lastQuote.bid = std::max(0.0, baseline - halfSpread);
     m_lastQuote.ask = baseline + halfSpread;
 
+    if (m_resetOnNextCandle) {
+        const QString key = CandleStore::key(m_lastSymbol);
+        m_store->reset(key);
+        m_historyExhausted.remove(key);
+        m_resetOnNextCandle = false;
+    }
+    m_store->append(c);
+    if (m_storage)
+        m_storage->appendCandle(c);
+    m_store->appendTick(c.symbol, m_lastQuote.timestamp.toMSecsSinceEpoch(), m_lastQuote.last);
+
     emit candleReceived(c);
     emit quoteUpdated(m_lastQuote);
     emit lastPriceChanged(m_lastSymbol, m_lastQuote.last);
 }
 
+void ChartManager::requestHistory(const QString &symbol)
+{
+    const QString key = CandleStore::key(symbol);
+    if (!m_storage || key.isEmpty()
+            || m_historyPending.contains(key) || m_historyExhausted.contains(key))
+        return;
+
+    const CandleSeries *series = m_store->series(key);
+    if (series && series->bars.size() >= CandleStore::kMaxBars)
+        return;
+    const qint64 beforeMs = (series && !series->bars.isEmpty())
+            ? series->bars.time.first()
+            : QDateTime::currentMSecsSinceEpoch();
+
+    m_historyPending.insert(key);
+    m_storage->requestHistory(key, beforeMs, kHistoryPageSize);
+}
+
+void ChartManager::handleHistoryLoaded(const QString &symbol, qint64 beforeMs,
+                                       const CandleColumns &page)
+{
+    m_historyPending.remove(symbol);
+
+    // A reset or trim while the page was loading makes it stale.
+    const CandleSeries *series = m_store->series(symbol);
+    if (series && !series->bars.isEmpty() && series->bars.time.first() != beforeMs)
+        return;
+
+    if (page.isEmpty()) {
+        m_historyExhausted.insert(symbol);
+        return;
+    }
+    m_store->prependBars(symbol, page);
+}
+
 void ChartManager::handleConnectionChange(bool connected)
 {
     emit connectionStateChanged(connected);
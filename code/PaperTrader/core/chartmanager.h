@@ -1,10 +1,12 @@
 #pragma once
 
 #include <QObject>
+#include <QSet>
 #include <QString>
 #include <QStringList>
 #include <QJsonObject>
 
+#include "candlestore.h"
 #include "marketdataprovider.h"
 #include "models/candle.h"
 #include "models/quote.h"
@@ -29,6 +31,12 @@ public:
     double lastPrice() const { return m_lastQuote.last; }
     Quote lastQuote() const { return m_lastQuote; }
 
+    // Per-symbol bars and indicators, updated before candleReceived fires.
+    CandleStore *candleStore() const { return m_store; }
+    const CandleSeries *activeSeries() const { return m_store->series(m_lastSymbol); }
+    // Pages older bars for a symbol in from local history, asynchronously.
+    void requestHistory(const QString &symbol);
+
     QStringList loadWatchlist() const;
     void saveWatchlist(const QStringList &symbols) const;
     QJsonObject loadSettings() const;
@@ -45,6 +53,7 @@ signals:
 private slots:
     void handleCandle(const Candle &c);
     void handleConnectionChange(bool connected);
+    void handleHistoryLoaded(const QString &symbol, qint64 beforeMs, const CandleColumns &page);
 
 private:
     void attachProvider(MarketDataProvider *provider);
@@ -54,4 +63,10 @@ private:
     MarketDataProvider::FeedMode m_mode = MarketDataProvider::FeedMode::Synthetic;
     QString m_lastSymbol;
     Quote   m_lastQuote;
+    CandleStore *m_store = nullptr;
+    bool m_resetOnNextCandle = false;
+    QSet<QString> m_historyPending;
+    QSet<QString> m_historyExhausted;
+
+    static constexpr int kHistoryPageSize = 2000;
 };
@@ -0,0 +1,80 @@
+#pragma once
+#include <QHash>
+#include <QtGlobal>
+#include <utility>
+#include <vector>
+
+/**
+ * DenseMap: values in one dense array, found by key through a hash.
+ *
+ * The hash maps a key to the value's position in the array. Erasing moves
+ * the last value into the gap and repoints its key, so the array never has
+ * holes: lookup is a hash probe plus an array read, iteration is a walk over
+ * the array, and erased storage is reused by the next insert instead of
+ * allocating a node per value.
+ */
+template <typename Key, typename T>
+class DenseMap {
+public:
+    // Replaces the value already stored under `key`, if any.
+    void insert(const Key &key, T value)
+    {
+        if (T *existing = get(key)) {
+            *existing = std::move(value);
+            return;
+        }
+        m_positions.insert(key, static_cast<quint32>(m_values.size()));
+        m_values.push_back(std::move(value));
+        m_keys.push_back(key);
+    }
+
+    bool erase(const Key &key)
+    {
+        const auto it = m_positions.find(key);
+        if (it == m_positions.end())
+            return false;
+        const quint32 position = it.value();
+        m_positions.erase(it);
+        const quint32 last = static_cast<quint32>(m_values.size() - 1);
+        if (position != last) {
+            m_values[position] = std::move(m_values[last]);
+            m_keys[position] = std::move(m_keys[last]);
+            m_positions[m_keys[position]] = position;
+        }
+        m_values.pop_back();
+        m_keys.pop_back();
+        return true;
+    }
+
+    bool contains(const Key &key) const { return m_positions.contains(key); }
+    T *get(const Key &key)
+    {
+        const auto it = m_positions.constFind(key);
+        return it == m_positions.constEnd() ? nullptr : &m_values[it.value()];
+    }
+    const T *get(const Key &key) const
+    {
+        const auto it = m_positions.constFind(key);
+        return it == m_positions.constEnd() ? nullptr : &m_values[it.value()];
+    }
+
+    int size() const { return static_cast<int>(m_values.size()); }
+    bool isEmpty() const { return m_values.empty(); }
+    void reserve(int count)
+    {
+        m_values.reserve(count);
+        m_keys.reserve(count);
+        m_positions.reserve(count);
+    }
+
+    // Live values in no particular order.
+    typename std::vector<T>::iterator begin() { return m_values.begin(); }
+    typename std::vector<T>::iterator end() { return m_values.end(); }
+    typename std::vector<T>::const_iterator begin() const { return m_values.begin(); }
+    typename std::vector<T>::const_iterator end() const { return m_values.end(); }
+
+private:
+    std::vector<T> m_values;
+    std::vector<Key> m_keys;   // key of the value at the same position
+    QHash<Key, quint32> m_positions;
+};
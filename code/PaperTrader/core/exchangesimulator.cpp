@@ -0,0 +1,310 @@
+#include "exchangesimulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr double kEpsilon = 1e-9;
+}
+
+ExchangeSimulator::ExchangeSimulator(double tickSize)
+    : m_tickSize(tickSize > 0.0 ? tickSize : 0.01)
+{
+}
+
+int ExchangeSimulator::listSymbol(const QString &symbol)
+{
+    const QString key = symbol.trimmed().toUpper();
+    for (int i = 0; i < static_cast<int>(m_books.size()); ++i) {
+        if (m_books[i].symbol == key)
+            return i;
+    }
+    m_books.push_back(Book{});
+    m_books.back().symbol = key;
+    return static_cast<int>(m_books.size()) - 1;
+}
+
+QString ExchangeSimulator::symbolName(int symbol) const
+{
+    if (symbol < 0 || symbol >= static_cast<int>(m_books.size()))
+        return {};
+    return m_books[symbol].symbol;
+}
+
+ExchangeSimulator::Node *ExchangeSimulator::acquire()
+{
+    if (m_free) {
+        Node *node = m_free;
+        m_free = node->next;
+        node->next = nullptr;
+        return node;
+    }
+    if ((m_nodeCount & (kChunkSize - 1)) == 0)
+        m_chunks.push_back(std::make_unique<Node[]>(kChunkSize));
+    Node *node = nodeAt(m_nodeCount);
+    node->index = m_nodeCount++;
+    return node;
+}
+
+void ExchangeSimulator::release(Node *node)
+{
+    // A new generation retires the old id; 0 is never handed out.
+    if (++node->generation == 0)
+        node->generation = 1;
+    node->level = nullptr;
+    node->prev = nullptr;
+    node->next = m_free;
+    m_free = node;
+}
+
+ExchangeSimulator::Node *ExchangeSimulator::nodeAt(quint32 index) const
+{
+    return &m_chunks[index >> kChunkBits][index & (kChunkSize - 1)];
+}
+
+quint64 ExchangeSimulator::idOf(const Node *node)
+{
+    return (quint64(node->generation) << 32) | node->index;
+}
+
+ExchangeSimulator::Node *ExchangeSimulator::find(quint64 orderId) const
+{
+    const quint32 index = static_cast<quint32>(orderId);
+    if (index >= m_nodeCount)
+        return nullptr;
+    Node *node = nodeAt(index);
+    if (node->generation != quint32(orderId >> 32) || node->level == nullptr)
+        return nullptr;
+    return node;
+}
+
+ExecutionReport ExchangeSimulator::report(const Node *node, OrderStatus status) const
+{
+    ExecutionReport report;
+    report.orderId = idOf(node);
+    report.status = status;
+    report.account = node->account;
+    report.symbol = node->symbol;
+    report.side = node->side;
+    report.fillPx = node->ticks * m_tickSize;
+    return report;
+}
+
+quint64 ExchangeSimulator::submit(const NewOrder &order, std::vector<ExecutionReport> &reports)
+{
+    const bool market = order.type == OrderType::Market;
+    const qint64 limit = market ? 0 : std::llround(order.price / m_tickSize);
+
+    RejectReason reason = RejectReason::None;
+    if (order.symbol < 0 || order.symbol >= static_cast<int>(m_books.size()))
+        reason = RejectReason::InvalidSymbol;
+    else if (!(order.quantity > 0.0))
+        reason = RejectReason::InvalidQuantity;
+    else if (!market && (order.type != OrderType::Limit || limit <= 0))
+        reason = RejectReason::InvalidPrice;
+    else if (order.timeInForce != TimeInForce::GTC && order.timeInForce != TimeInForce::IOC
+             && order.timeInForce != TimeInForce::FOK)
+        reason = RejectReason::InvalidTimeInForce;
+
+    const bool buy = order.side == OrderSide::Buy;
+    if (reason == RejectReason::None && order.timeInForce == TimeInForce::FOK) {
+        const Book &book = m_books[order.symbol];
+        const double depth = buy ? available(book.asks, limit, market, order.quantity)
+                                 : available(book.bids, limit, market, order.quantity);
+        if (depth + kEpsilon < order.quantity)
+            reason = RejectReason::Unfillable;
+    }
+    if (reason != RejectReason::None) {
+        ExecutionReport rejected;
+        rejected.status = OrderStatus::Rejected;
+        rejected.account = order.account;
+        rejected.symbol = order.symbol;
+        rejected.side = order.side;
+        rejected.fillPx = order.price;
+        rejected.reason = reason;
+        reports.push_back(rejected);
+        return 0;
+    }
+
+    Node *taker = acquire();
+    taker->account = order.account;
+    taker->symbol = order.symbol;
+    taker->side = order.side;
+    taker->ticks = limit;
+    taker->quantity = order.quantity;
+    const quint64 id = idOf(taker);
+
+    Book &book = m_books[order.symbol];
+    if (buy)
+        match(book.asks, taker, limit, market, reports);
+    else
+        match(book.bids, taker, limit, market, reports);
+
+    if (taker->quantity <= kEpsilon) {
+        release(taker);
+    } else if (market || order.timeInForce != TimeInForce::GTC) {
+        reports.push_back(report(taker, OrderStatus::Cancelled));
+        release(taker);
+    } else if (buy) {
+        rest(book.bids, taker);
+    } else {
+        rest(book.asks, taker);
+    }
+    return id;
+}
+
+bool ExchangeSimulator::cancel(quint64 orderId, std::vector<ExecutionReport> &reports)
+{
+    Node *node = find(orderId);
+    if (node == nullptr)
+        return false;
+
+    Book &book = m_books[node->symbol];
+    if (node->side == OrderSide::Buy)
+        unlink(book.bids, node);
+    else
+        unlink(book.asks, node);
+    reports.push_back(report(node, OrderStatus::Cancelled));
+    release(node);
+    return true;
+}
+
+// Both ladders sort best-first, so "the level is at or better than the
+// limit" is !comp(limit, level) for either side.
+template <typename Levels>
+double ExchangeSimulator::available(const Levels &levels, qint64 limit, bool market,
+                                    double wanted) const
+{
+    double total = 0.0;
+    for (auto it = levels.cbegin(); it != levels.cend() && total < wanted; ++it) {
+        if (!market && levels.key_comp()(limit, it->first))
+            break;
+        total += it->second.quantity;
+    }
+    return total;
+}
+
+template <typename Levels>
+void ExchangeSimulator::match(Levels &levels, Node *taker, qint64 limit, bool market,
+                              std::vector<ExecutionReport> &reports)
+{
+    const quint64 takerId = idOf(taker);
+    while (taker->quantity > kEpsilon && !levels.empty()) {
+        const auto it = levels.begin();
+        if (!market && levels.key_comp()(limit, it->first))
+            break;
+
+        Level &level = it->second;
+        const double price = it->first * m_tickSize;
+        while (taker->quantity > kEpsilon && level.head) {
+            Node *maker = level.head;
+            const double quantity = std::min(taker->quantity, maker->quantity);
+            taker->quantity -= quantity;
+            maker->quantity -= quantity;
+            level.quantity -= quantity;
+            if (taker->quantity <= kEpsilon)
+                taker->quantity = 0.0;
+            // Snapping a maker to zero takes its residue out of the level too,
+            // so the depth the FOK check reads stays the sum of its orders.
+            if (maker->quantity <= kEpsilon) {
+                level.quantity = std::max(0.0, level.quantity - maker->quantity);
+                maker->quantity = 0.0;
+            }
+
+            const quint64 makerId = idOf(maker);
+            ExecutionReport fill;
+            fill.orderId = takerId;
+            fill.status = taker->quantity > 0.0 ? OrderStatus::PartiallyFilled : OrderStatus::Filled;
+            fill.fillPx = price;
+            fill.fillQty = quantity;
+            fill.leavesQty = taker->quantity;
+            fill.account = taker->account;
+            fill.symbol = taker->symbol;
+            fill.side = taker->side;
+            fill.counterOrderId = makerId;
+            reports.push_back(fill);
+
+            fill.orderId = makerId;
+            fill.status = maker->quantity > 0.0 ? OrderStatus::PartiallyFilled : OrderStatus::Filled;
+            fill.leavesQty = maker->quantity;
+            fill.account = maker->account;
+            fill.side = maker->side;
+            fill.counterOrderId = takerId;
+            reports.push_back(fill);
+
+            if (maker->quantity == 0.0) {
+                level.head = maker->next;
+                if (level.head)
+                    level.head->prev = nullptr;
+                else
+                    level.tail = nullptr;
+                --m_resting;
+                release(maker);
+            }
+        }
+        if (level.head == nullptr)
+            levels.erase(it);
+    }
+}
+
+template <typename Levels>
+void ExchangeSimulator::rest(Levels &levels, Node *node)
+{
+    Level &level = levels[node->ticks];
+    node->level = &level;
+    node->prev = level.tail;
+    node->next = nullptr;
+    if (level.tail)
+        level.tail->next = node;
+    else
+        level.head = node;
+    level.tail = node;
+    level.quantity += node->quantity;
+    ++m_resting;
+}
+
+template <typename Levels>
+void ExchangeSimulator::unlink(Levels &levels, Node *node)
+{
+    Level &level = *node->level;
+    if (node->prev)
+        node->prev->next = node->next;
+    else
+        level.head = node->next;
+    if (node->next)
+        node->next->prev = node->prev;
+    else
+        level.tail = node->prev;
+    level.quantity = std::max(0.0, level.quantity - node->quantity);
+    --m_resting;
+    if (level.head == nullptr)
+        levels.erase(node->ticks);
+}
+
+double ExchangeSimulator::bestBid(int symbol) const
+{
+    if (symbol < 0 || symbol >= static_cast<int>(m_books.size()) || m_books[symbol].bids.empty())
+        return 0.0;
+    return m_books[symbol].bids.begin()->first * m_tickSize;
+}
+
+double ExchangeSimulator::bestAsk(int symbol) const
+{
+    if (symbol < 0 || symbol >= static_cast<int>(m_books.size()) || m_books[symbol].asks.empty())
+        return 0.0;
+    return m_books[symbol].asks.begin()->first * m_tickSize;
+}
+
+double ExchangeSimulator::depthAt(int symbol, OrderSide side, double price) const
+{
+    if (symbol < 0 || symbol >= static_cast<int>(m_books.size()))
+        return 0.0;
+    const qint64 ticks = std::llround(price / m_tickSize);
+    const Book &book = m_books[symbol];
+    if (side == OrderSide::Buy) {
+        const auto it = book.bids.find(ticks);
+        return it == book.bids.end() ? 0.0 : it->second.quantity;
+    }
+    const auto it = book.asks.find(ticks);
+    return it == book.asks.end() ? 0.0 : it->second.quantity;
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include <QString>
+#include <QtGlobal>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "models/executionreport.h"
+#include "models/ordertypes.h"
+
+/**
+ * ExchangeSimulator: an in-process continuous double auction.
+ *
+ * Orders from any number of simulated accounts rest in one central limit
+ * order book per symbol and trade with each other in price-time priority;
+ * nothing trades against an external price. Each price level is an
+ * intrusive FIFO of order nodes, so joining, filling and cancelling at a
+ * level never allocate or search. Nodes come from a pool that recycles
+ * them, and an order id names its pool slot plus a generation, so lookups
+ * are an array read and ids of finished orders stop resolving.
+ *
+ * Prices are kept as whole ticks. Market and limit orders are supported
+ * with GTC, IOC or FOK; a market order never rests. Stop types are
+ * rejected with InvalidPrice, as the book has no trigger price.
+ */
+class ExchangeSimulator {
+public:
+    struct NewOrder {
+        int account = 0;
+        int symbol = 0;   // from listSymbol()
+        OrderSide side = OrderSide::Buy;
+        OrderType type = OrderType::Limit;
+        TimeInForce timeInForce = TimeInForce::GTC;
+        double price = 0.0;
+        double quantity = 0.0;
+    };
+
+    explicit ExchangeSimulator(double tickSize = 0.01);
+    ExchangeSimulator(const ExchangeSimulator &) = delete;
+    ExchangeSimulator &operator=(const ExchangeSimulator &) = delete;
+
+    // Opens a book for `symbol`, or returns the one already open.
+    int listSymbol(const QString &symbol);
+    QString symbolName(int symbol) const;
+
+    // Matches the order and rests what a GTC limit has left. Returns the
+    // order id (0 when rejected) and appends the reports it caused; a match
+    // reports a fill for each of the two orders, at the resting price.
+    quint64 submit(const NewOrder &order, std::vector<ExecutionReport> &reports);
+    bool cancel(quint64 orderId, std::vector<ExecutionReport> &reports);
+
+    // 0 when that side of the book is empty.
+    double bestBid(int symbol) const;
+    double bestAsk(int symbol) const;
+    double depthAt(int symbol, OrderSide side, double price) const;
+    int restingCount() const { return m_resting; }
+
+private:
+    struct Level;
+    struct Node {
+        quint32 index = 0;        // pool slot
+        quint32 generation = 1;
+        int account = 0;
+        int symbol = 0;
+        OrderSide side = OrderSide::Buy;
+        qint64 ticks = 0;
+        double quantity = 0.0;
+        Level *level = nullptr;   // set while resting
+        Node *prev = nullptr;
+        Node *next = nullptr;     // also links the free list
+    };
+    struct Level {
+        Node *head = nullptr;
+        Node *tail = nullptr;
+        double quantity = 0.0;
+    };
+    using Bids = std::map<qint64, Level, std::greater<qint64>>;
+    using Asks = std::map<qint64, Level>;
+    struct Book {
+        QString symbol;
+        Bids bids;
+        Asks asks;
+    };
+
+    static constexpr int kChunkBits = 12;
+    static constexpr quint32 kChunkSize = 1u << kChunkBits;
+
+    Node *acquire();
+    void release(Node *node);
+    Node *nodeAt(quint32 index) const;
+    Node *find(quint64 orderId) const;
+    static quint64 idOf(const Node *node);
+
+    template <typename Levels>
+    double available(const Levels &levels, qint64 limit, bool market, double wanted) const;
+    template <typename Levels>
+    void match(Levels &levels, Node *taker, qint64 limit, bool market,
+               std::vector<ExecutionReport> &reports);
+    template <typename Levels>
+    void rest(Levels &levels, Node *node);
+    template <typename Levels>
+    void unlink(Levels &levels, Node *node);
+
+    ExecutionReport report(const Node *node, OrderStatus status) const;
+
+    double m_tickSize;
+    std::vector<Book> m_books;
+    std::vector<std::unique_ptr<Node[]>> m_chunks;
+    quint32 m_nodeCount = 0;   // slots handed out so far
+    Node *m_free = nullptr;
+    int m_resting = 0;
+};
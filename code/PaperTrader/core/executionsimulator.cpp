@@ -2,6 +2,8 @@
 
 #include <QLoggingCategory>
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 #include "ordermanager.h"
 #include "portfoliomanager.h"
@@ -23,13 +25,23 @@ void ExecutionSimulator::setOrderManager(OrderManager *manager)
     }
 
     m_orderManager = manager;
-    if (m_orderManager) {
-        connect(m_orderManager, &OrderManager::ordersChanged,
-                this, &ExecutionSimulator::onOrdersChanged);
-        onOrdersChanged(m_orderManager->orders());
-    } else {
-        m_openLimitOrders.clear();
-    }
+    m_ladders.clear();
+    m_handles.clear();
+    m_stopIndexes.clear();
+    m_pendingStops.clear();
+    if (!m_orderManager)
+        return;
+
+    connect(m_orderManager, &OrderManager::orderUpserted,
+            this, &ExecutionSimulator::onOrderUpserted);
+    connect(m_orderManager, &OrderManager::ordersUpserted,
+            this, &ExecutionSimulator::onOrdersUpserted);
+    connect(m_orderManager, &OrderManager::orderRemoved,
+            this, &ExecutionSimulator::onOrderRemoved);
+    connect(m_orderManager, &OrderManager::lastPriceChanged,
+            this, &ExecutionSimulator::onMarkPrice);
+    for (const Order &order : m_orderManager->orders())
+        onOrderUpserted(order);
 }
 
 void ExecutionSimulator::setPortfolioManager(PortfolioManager *manager)
@@ -42,77 +54,282 @@ void ExecutionSimulator::onCandle(const Candle &candle)
     if (candle.symbol.isEmpty() || m_orderManager == nullptr)
         return;
 
-    tryFill(candle);
+    // Walk the likely intrabar path: open, the nearer extreme, the other
+    // extreme, close. Only the open can gap through a stop.
+    const QString symbol = candle.symbol.toUpper();
+    if (m_stopIndexes.contains(symbol) && candle.open > 0.0) {
+        const double high = candle.high > 0.0 ? candle.high : candle.close;
+        const double low = candle.low > 0.0 ? candle.low : candle.close;
+        const bool lowFirst = candle.close >= candle.open;
+        triggerStops(symbol, candle.open, candle.open);
+        triggerStops(symbol, lowFirst ? low : high);
+        triggerStops(symbol, lowFirst ? high : low);
+        triggerStops(symbol, candle.close);
+        publishTrailingLevels(symbol, true);
+    }
+
+    if (m_matchMode == MatchMode::Candle)
+        tryFill(candle);
+}
+
+void ExecutionSimulator::onQuote(const Quote &quote)
+{
+    if (m_matchMode != MatchMode::Quote || m_orderManager == nullptr)
+        return;
+    const auto ladder = m_ladders.constFind(quote.symbol.toUpper());
+    if (ladder == m_ladders.constEnd())
+        return;
+
+    // Only the orders at or through the touch are visited; each fills at
+    // the opposite side of the quote, never worse than its limit.
+    std::vector<PendingFill> fills;
+    if (quote.ask > 0.0) {
+        for (auto it = ladder->buys.cbegin();
+             it != ladder->buys.cend() && it->first.price >= quote.ask; ++it)
+            fills.push_back({it->second.id, quote.ask, it->second.quantity});
+    }
+    if (quote.bid > 0.0) {
+        for (auto it = ladder->sells.cbegin();
+             it != ladder->sells.cend() && it->first.price <= quote.bid; ++it)
+            fills.push_back({it->second.id, quote.bid, it->second.quantity});
+    }
+    applyFills(fills);
 }
 
-void ExecutionSimulator::onOrdersChanged(const QList<Order> &orders)
+void ExecutionSimulator::onMarkPrice(const QString &symbol, double price)
 {
-    m_openLimitOrders.clear();
-    for (const Order &order : orders) {
-        const bool isLimit = order.type.compare(QStringLiteral("Limit"), Qt::CaseInsensitive) == 0;
-        const bool hasQty = order.quantity > 0.0;
-        const bool isActive = order.status.compare(QStringLiteral("Cancelled"), Qt::CaseInsensitive) != 0
-                && order.status.compare(QStringLiteral("Filled"), Qt::CaseInsensitive) != 0;
-        if (isLimit && hasQty && isActive) {
-            m_openLimitOrders.insert(order.id, order);
+    if (m_orderManager == nullptr)
+        return;
+    const QString key = symbol.toUpper();
+    triggerStops(key, price, price);
+    publishTrailingLevels(key, false);
+}
+
+bool ExecutionSimulator::isOpenLimit(const Order &order)
+{
+    return order.isRestingLimit();
+}
+
+void ExecutionSimulator::onOrderUpserted(const Order &order)
+{
+    if (order.isPendingStop())
+        indexStop(order);
+    else
+        eraseStop(order.id);
+
+    if (!isOpenLimit(order)) {
+        eraseResting(order.id);
+        return;
+    }
+
+    // A partial fill or a smaller size keeps the order's place in the queue;
+    // a new price or a larger size goes to the back.
+    const auto handle = m_handles.constFind(order.id);
+    if (handle != m_handles.constEnd() && handle->side == order.side
+            && handle->key.price == order.price) {
+        Ladder &ladder = m_ladders[handle->symbol];
+        Order &resting = order.side == OrderSide::Buy ? ladder.buys[handle->key]
+                                                      : ladder.sells[handle->key];
+        if (order.quantity <= resting.quantity) {
+            resting = order;
+            return;
         }
     }
+
+    eraseResting(order.id);
+    insertResting(order, m_nextSequence++);
 }
 
-void ExecutionSimulator::tryFill(const Candle &candle)
+void ExecutionSimulator::onOrdersUpserted(const QList<Order> &orders)
 {
-    if (m_openLimitOrders.isEmpty())
+    for (const Order &order : orders)
+        onOrderUpserted(order);
+}
+
+void ExecutionSimulator::onOrderRemoved(int orderId)
+{
+    eraseResting(orderId);
+    eraseStop(orderId);
+}
+
+void ExecutionSimulator::indexStop(const Order &order)
+{
+    // Re-indexing a trailing stop would restart its trail, so only a changed
+    // trigger is re-added.
+    const auto indexed = m_pendingStops.constFind(order.id);
+    if (indexed != m_pendingStops.constEnd() && indexed->symbol == order.symbol
+            && indexed->side == order.side && indexed->stopPrice == order.stopPrice
+            && indexed->trailAmount == order.trailAmount) {
+        m_pendingStops.insert(order.id, order);
         return;
+    }
 
-    const QString symbol = candle.symbol.toUpper();
-    const auto orders = m_openLimitOrders;
-    for (const Order &order : orders) {
-        if (order.symbol.compare(symbol, Qt::CaseInsensitive) != 0)
-            continue;
+    eraseStop(order.id);
+    StopTriggerIndex &index = m_stopIndexes[order.symbol];
+    if (order.type == OrderType::TrailingStop) {
+        const double mark = order.side == OrderSide::Sell ? order.stopPrice + order.trailAmount
+                                                          : order.stopPrice - order.trailAmount;
+        index.addTrailing(order.id, order.side, order.trailAmount, mark);
+    } else {
+        index.addStop(order.id, order.side, order.stopPrice);
+    }
+    m_pendingStops.insert(order.id, order);
+}
+
+void ExecutionSimulator::eraseStop(int orderId)
+{
+    const auto indexed = m_pendingStops.constFind(orderId);
+    if (indexed == m_pendingStops.constEnd())
+        return;
+
+    const auto index = m_stopIndexes.find(indexed->symbol);
+    if (index != m_stopIndexes.end()) {
+        index->remove(orderId);
+        if (index->isEmpty())
+            m_stopIndexes.erase(index);
+    }
+    m_pendingStops.erase(indexed);
+}
 
-        double fillPrice = 0.0;
-        if (!shouldFill(order, candle, fillPrice))
+void ExecutionSimulator::triggerStops(const QString &symbol, double price, double gapPrice)
+{
+    const auto index = m_stopIndexes.find(symbol);
+    if (index == m_stopIndexes.end())
+        return;
+
+    std::vector<StopTriggerIndex::Trigger> triggered;
+    index->onPrice(price, triggered);
+
+    // Firing re-enters onOrderUpserted, so copy each order out first.
+    for (const StopTriggerIndex::Trigger &trigger : triggered) {
+        const Order order = m_pendingStops.value(trigger.orderId);
+        if (!m_orderManager->triggerOrder(trigger.orderId))
+            continue;
+        if (order.type == OrderType::StopLimit)
             continue;
 
-        const double fillQty = order.quantity;
+        const double fillPrice = gapPrice > 0.0 ? gapPrice : trigger.level;
         double fee = 0.0;
-        if (m_portfolioManager) {
-            fee = m_portfolioManager->estimateFee(fillPrice, fillQty);
-        }
+        if (m_portfolioManager)
+            fee = m_portfolioManager->estimateFee(fillPrice, order.quantity);
+        m_orderManager->applyFill(trigger.orderId, fillPrice, order.quantity, fee);
+    }
+}
+
+void ExecutionSimulator::publishTrailingLevels(const QString &symbol, bool force)
+{
+    const auto index = m_stopIndexes.find(symbol);
+    if (index == m_stopIndexes.end() || !index->hasMovedLevels())
+        return;
 
-        m_orderManager->applyFill(order.id, fillPrice, fillQty, fee);
+    // Every new extreme would otherwise re-announce each trailing order, so
+    // a burst of them is coalesced into one batch per interval.
+    const qint64 now = m_orderManager->currentTime();
+    const auto published = m_levelsPublishedAt.constFind(symbol);
+    if (!force && published != m_levelsPublishedAt.constEnd()
+            && now - published.value() < kLevelPublishMs)
+        return;
+    m_levelsPublishedAt.insert(symbol, now);
+
+    std::vector<StopTriggerIndex::Trigger> moved;
+    index->takeMovedLevels(moved);
+
+    // Published levels let the order show and reserve against its stop. The
+    // cached copy is updated first so the echo does not re-index (and
+    // restart) the trail.
+    std::vector<std::pair<int, double>> levels;
+    levels.reserve(moved.size());
+    for (const StopTriggerIndex::Trigger &level : moved) {
+        const auto pending = m_pendingStops.find(level.orderId);
+        if (pending == m_pendingStops.end())
+            continue;
+        pending->stopPrice = level.level;
+        levels.emplace_back(level.orderId, level.level);
     }
+    if (!levels.empty())
+        m_orderManager->moveStops(levels);
 }
 
-bool ExecutionSimulator::shouldFill(const Order &order, const Candle &candle, double &fillPrice) const
+void ExecutionSimulator::insertResting(const Order &order, quint64 sequence)
 {
-    const bool isBuy = order.side.compare(QStringLiteral("BUY"), Qt::CaseInsensitive) == 0;
-    const bool isSell = order.side.compare(QStringLiteral("SELL"), Qt::CaseInsensitive) == 0;
-    if (!isBuy && !isSell)
-        return false;
+    const LadderKey key{order.price, sequence};
+    Ladder &ladder = m_ladders[order.symbol];
+    if (order.side == OrderSide::Buy)
+        ladder.buys.emplace(key, order);
+    else
+        ladder.sells.emplace(key, order);
+    m_handles.insert(order.id, Handle{order.symbol, order.side, key});
+}
 
-    const double limitPrice = order.price;
-    if (limitPrice <= 0.0)
+bool ExecutionSimulator::eraseResting(int orderId)
+{
+    const auto handle = m_handles.constFind(orderId);
+    if (handle == m_handles.constEnd())
         return false;
 
+    const auto ladder = m_ladders.find(handle->symbol);
+    if (ladder != m_ladders.end()) {
+        if (handle->side == OrderSide::Buy)
+            ladder->buys.erase(handle->key);
+        else
+            ladder->sells.erase(handle->key);
+        if (ladder->buys.empty() && ladder->sells.empty())
+            m_ladders.erase(ladder);
+    }
+    m_handles.erase(handle);
+    return true;
+}
+
+void ExecutionSimulator::tryFill(const Candle &candle)
+{
+    const auto ladder = m_ladders.constFind(candle.symbol.toUpper());
+    if (ladder == m_ladders.constEnd())
+        return;
+
     const double high = candle.high > 0.0 ? candle.high : candle.close;
     const double low = candle.low > 0.0 ? candle.low : candle.close;
 
-    if (isBuy) {
-        if (low <= limitPrice) {
-            fillPrice = std::min(limitPrice, candle.close > 0.0 ? candle.close : limitPrice);
-            return true;
-        }
-        return false;
+    // Collect first: each fill re-enters onOrderUpserted and edits the ladder.
+    // Each side spends its own share of the bar's volume, best price first.
+    const bool capped = m_participation > 0.0;
+    const double share = capped ? m_participation * std::max(0.0, candle.volume) : 0.0;
+    std::vector<PendingFill> fills;
+    double budget = share;
+    for (auto it = ladder->buys.cbegin();
+         it != ladder->buys.cend() && it->first.price >= low && (!capped || budget > 0.0); ++it) {
+        const double quantity = capped ? std::min(it->second.quantity, budget) : it->second.quantity;
+        budget -= quantity;
+        fills.push_back({it->second.id, fillPriceFor(it->second, candle), quantity});
     }
+    budget = share;
+    for (auto it = ladder->sells.cbegin();
+         it != ladder->sells.cend() && it->first.price <= high && (!capped || budget > 0.0); ++it) {
+        const double quantity = capped ? std::min(it->second.quantity, budget) : it->second.quantity;
+        budget -= quantity;
+        fills.push_back({it->second.id, fillPriceFor(it->second, candle), quantity});
+    }
+    applyFills(fills);
+}
 
-    if (isSell) {
-        if (high >= limitPrice) {
-            fillPrice = std::max(limitPrice, candle.close > 0.0 ? candle.close : limitPrice);
-            return true;
+void ExecutionSimulator::applyFills(const std::vector<PendingFill> &fills)
+{
+    for (const PendingFill &fill : fills) {
+        double fee = 0.0;
+        if (m_portfolioManager) {
+            fee = m_portfolioManager->estimateFee(fill.price, fill.quantity);
         }
-        return false;
+
+        m_orderManager->applyFill(fill.orderId, fill.price, fill.quantity, fee);
     }
+}
 
-    return false;
+double ExecutionSimulator::fillPriceFor(const Order &order, const Candle &candle)
+{
+    // Limits fill at their price or better, using the close as the print.
+    const double limitPrice = order.price;
+    if (candle.close <= 0.0)
+        return limitPrice;
+    return order.side == OrderSide::Buy
+            ? std::min(limitPrice, candle.close)
+            : std::max(limitPrice, candle.close);
 }
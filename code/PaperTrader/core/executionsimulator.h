@@ -1,29 +1,124 @@
 #pragma once
 #include <QObject>
-#include <QMap>
+#include <QHash>
+#include <QString>
+#include <algorithm>
+#include <map>
+#include <vector>
 #include "models/candle.h"
 #include "models/order.h"
+#include "models/quote.h"
+#include "stoptriggerindex.h"
 
 class OrderManager;
 class PortfolioManager;
 
+/**
+ * ExecutionSimulator: fills resting limit orders against incoming candles.
+ *
+ * Open limits sit in a per-symbol price ladder (buys best-first by descending
+ * price, sells by ascending price, ties in arrival order), so a candle walks
+ * only the orders its low/high actually crosses.
+ *
+ * Untriggered stops wait in a per-symbol StopTriggerIndex and are checked
+ * against every mark price and against each candle's open/high/low/close
+ * path. A triggered stop fills at its trigger level (or at the open when the
+ * candle gaps through it); a triggered stop-limit joins the ladder.
+ * Trailing stops publish their lifted levels as stopPrice at most once per
+ * candle and once per kLevelPublishMs of marks, not on every new extreme.
+ *
+ * In MatchMode::Quote the ladder is matched against the quote stream
+ * instead of candles: buys fill at the ask once it reaches their limit,
+ * sells at the bid, walking each ladder only as far as the touch.
+ *
+ * With a volume participation rate set, a candle fills each side of the
+ * ladder for at most that fraction of the bar's volume, handed out in
+ * priority order; an order cut short stays on the ladder partially filled.
+ */
 class ExecutionSimulator : public QObject {
     Q_OBJECT
 public:
+    enum class MatchMode { Candle, Quote };
+
     explicit ExecutionSimulator(QObject *parent = nullptr);
 
     void setOrderManager(OrderManager *manager);
     void setPortfolioManager(PortfolioManager *manager);
+    void setMatchMode(MatchMode mode) { m_matchMode = mode; }
+    MatchMode matchMode() const { return m_matchMode; }
+    // Fraction of each bar's volume a side may fill; 0 lifts the cap.
+    void setVolumeParticipation(double fraction) { m_participation = std::max(0.0, fraction); }
+    double volumeParticipation() const { return m_participation; }
+
+    int restingOrderCount() const { return static_cast<int>(m_handles.size()); }
+    int pendingStopCount() const { return static_cast<int>(m_pendingStops.size()); }
 
 public slots:
     void onCandle(const Candle &candle);
-    void onOrdersChanged(const QList<Order> &orders);
+    void onQuote(const Quote &quote);
+    void onMarkPrice(const QString &symbol, double price);
+    void onOrderUpserted(const Order &order);
+    void onOrdersUpserted(const QList<Order> &orders);
+    void onOrderRemoved(int orderId);
 
 private:
+    // Price-time priority key; `sequence` orders arrivals at the same price.
+    struct LadderKey {
+        double price = 0.0;
+        quint64 sequence = 0;
+    };
+    struct BestBidFirst {
+        bool operator()(const LadderKey &a, const LadderKey &b) const
+        {
+            return a.price != b.price ? a.price > b.price : a.sequence < b.sequence;
+        }
+    };
+    struct BestAskFirst {
+        bool operator()(const LadderKey &a, const LadderKey &b) const
+        {
+            return a.price != b.price ? a.price < b.price : a.sequence < b.sequence;
+        }
+    };
+    struct Ladder {
+        std::map<LadderKey, Order, BestBidFirst> buys;
+        std::map<LadderKey, Order, BestAskFirst> sells;
+    };
+    struct Handle {
+        QString symbol;
+        OrderSide side = OrderSide::Buy;
+        LadderKey key;
+    };
+
+    static bool isOpenLimit(const Order &order);
+    void insertResting(const Order &order, quint64 sequence);
+    bool eraseResting(int orderId);
     void tryFill(const Candle &candle);
-    bool shouldFill(const Order &order, const Candle &candle, double &fillPrice) const;
+    struct PendingFill {
+        int orderId;
+        double price;
+        double quantity;
+    };
+    void applyFills(const std::vector<PendingFill> &fills);
+    static double fillPriceFor(const Order &order, const Candle &candle);
+    void indexStop(const Order &order);
+    void eraseStop(int orderId);
+    // Fires the stops `price` crosses; with `gapPrice` set they fill there
+    // instead of at their trigger level.
+    void triggerStops(const QString &symbol, double price, double gapPrice = 0.0);
+    // Writes the trailing levels lifted since the last publish back to the
+    // orders; unless `force`d, only once kLevelPublishMs have passed.
+    void publishTrailingLevels(const QString &symbol, bool force);
+
+    static constexpr qint64 kLevelPublishMs = 250;
 
     OrderManager *m_orderManager = nullptr;
     PortfolioManager *m_portfolioManager = nullptr;
-    QMap<int, Order> m_openLimitOrders;
+    MatchMode m_matchMode = MatchMode::Candle;
+    double m_participation = 0.0;
+    QHash<QString, Ladder> m_ladders;
+    QHash<int, Handle> m_handles;
+    quint64 m_nextSequence = 0;
+    QHash<QString, StopTriggerIndex> m_stopIndexes;
+    QHash<int, Order> m_pendingStops;   // as last indexed
+    QHash<QString, qint64> m_levelsPublishedAt;
 };
@@ -0,0 +1,465 @@
+#include "indicatorengine.h"
+
+#include <cmath>
+#include <limits>
+
+namespace {
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+class SmaIndicator : public Indicator {
+public:
+    explicit SmaIndicator(const IndicatorSpec &spec)
+        : Indicator(spec), m_window(spec.period) {}
+
+protected:
+    void step(const Candle &c, double *out) override
+    {
+        m_window.push(c.close);
+        out[0] = m_window.full() ? m_window.mean() : kNaN;
+    }
+    void resetState() override { m_window.clear(); }
+
+private:
+    RollingWindow m_window;
+};
+
+class EmaIndicator : public Indicator {
+public:
+    explicit EmaIndicator(const IndicatorSpec &spec)
+        : Indicator(spec),
+          m_alpha(2.0 / (std::max(1, spec.period) + 1.0)) {}
+
+protected:
+    void step(const Candle &c, double *out) override
+    {
+        // Seed with the simple average of the first period closes.
+        if (m_count < m_spec.period) {
+            m_seedSum += c.close;
+            ++m_count;
+            if (m_count < m_spec.period) {
+                out[0] = kNaN;
+                return;
+            }
+            m_ema = m_seedSum / m_spec.period;
+        } else {
+            m_ema += m_alpha * (c.close - m_ema);
+        }
+        out[0] = m_ema;
+    }
+    void resetState() override
+    {
+        m_count = 0;
+        m_seedSum = 0.0;
+        m_ema = 0.0;
+    }
+
+private:
+    double m_alpha = 0.0;
+    int m_count = 0;
+    double m_seedSum = 0.0;
+    double m_ema = 0.0;
+};
+
+class BollingerIndicator : public Indicator {
+public:
+    explicit BollingerIndicator(const IndicatorSpec &spec)
+        : Indicator(spec, 3), m_window(spec.period) {}
+
+protected:
+    // Outputs: 0 = middle band, 1 = upper band, 2 = lower band.
+    void step(const Candle &c, double *out) override
+    {
+        m_window.push(c.close);
+        if (!m_window.full()) {
+            out[0] = out[1] = out[2] = kNaN;
+            return;
+        }
+        const double n = m_window.period();
+        const double mean = m_window.sum() / n;
+        const double variance = std::max(0.0, m_window.sumSquares() / n - mean * mean);
+        const double width = m_spec.multiplier * std::sqrt(variance);
+        out[0] = mean;
+        out[1] = mean + width;
+        out[2] = mean - width;
+    }
+    void resetState() override { m_window.clear(); }
+
+private:
+    RollingWindow m_window;
+};
+
+// Wilder smoothing shared by RSI and ATR: plain average over the first
+// period samples, then avg = (avg * (n - 1) + x) / n.
+struct WilderAverage {
+    int period = 14;
+    int count = 0;
+    double value = 0.0;
+
+    bool push(double x)
+    {
+        if (count < period) {
+            value += x;
+            ++count;
+            if (count == period)
+                value /= period;
+            return count == period;
+        }
+        value = (value * (period - 1) + x) / period;
+        return true;
+    }
+    void clear()
+    {
+        count = 0;
+        value = 0.0;
+    }
+};
+
+class RsiIndicator : public Indicator {
+public:
+    explicit RsiIndicator(const IndicatorSpec &spec)
+        : Indicator(spec)
+    {
+        m_gain.period = std::max(1, spec.period);
+        m_loss.period = m_gain.period;
+    }
+
+protected:
+    void step(const Candle &c, double *out) override
+    {
+        if (!m_hasPrev) {
+            m_hasPrev = true;
+            m_prevClose = c.close;
+            out[0] = kNaN;
+            return;
+        }
+        const double change = c.close - m_prevClose;
+        m_prevClose = c.close;
+        m_gain.push(change > 0.0 ? change : 0.0);
+        const bool ready = m_loss.push(change < 0.0 ? -change : 0.0);
+        if (!ready) {
+            out[0] = kNaN;
+            return;
+        }
+        if (m_loss.value <= 0.0) {
+            out[0] = m_gain.value > 0.0 ? 100.0 : 50.0;
+            return;
+        }
+        out[0] = 100.0 - 100.0 / (1.0 + m_gain.value / m_loss.value);
+    }
+    void resetState() override
+    {
+        m_hasPrev = false;
+        m_prevClose = 0.0;
+        m_gain.clear();
+        m_loss.clear();
+    }
+
+private:
+    bool m_hasPrev = false;
+    double m_prevClose = 0.0;
+    WilderAverage m_gain;
+    WilderAverage m_loss;
+};
+
+class AtrIndicator : public Indicator {
+public:
+    explicit AtrIndicator(const IndicatorSpec &spec)
+        : Indicator(spec)
+    {
+        m_average.period = std::max(1, spec.period);
+    }
+
+protected:
+    void step(const Candle &c, double *out) override
+    {
+        double trueRange = c.high - c.low;
+        if (m_hasPrev) {
+            trueRange = std::max({trueRange,
+                                  std::abs(c.high - m_prevClose),
+                                  std::abs(c.low - m_prevClose)});
+        }
+        m_hasPrev = true;
+        m_prevClose = c.close;
+        out[0] = m_average.push(trueRange) ? m_average.value : kNaN;
+    }
+    void resetState() override
+    {
+        m_hasPrev = false;
+        m_prevClose = 0.0;
+        m_average.clear();
+    }
+
+private:
+    bool m_hasPrev = false;
+    double m_prevClose = 0.0;
+    WilderAverage m_average;
+};
+
+class VwapIndicator : public Indicator {
+public:
+    explicit VwapIndicator(const IndicatorSpec &spec)
+        : Indicator(spec) {}
+
+protected:
+    // Session VWAP: the running sums restart on each new UTC day.
+    void step(const Candle &c, double *out) override
+    {
+        const qint64 day = c.timestamp.isValid()
+                ? c.timestamp.toMSecsSinceEpoch() / 86400000
+                : m_day;
+        if (day != m_day) {
+            m_day = day;
+            m_priceVolume = 0.0;
+            m_volume = 0.0;
+        }
+        const double typical = (c.high + c.low + c.close) / 3.0;
+        m_priceVolume += typical * c.volume;
+        m_volume += c.volume;
+        out[0] = m_volume > 0.0 ? m_priceVolume / m_volume : typical;
+    }
+    void resetState() override
+    {
+        m_day = -1;
+        m_priceVolume = 0.0;
+        m_volume = 0.0;
+    }
+
+private:
+    qint64 m_day = -1;
+    double m_priceVolume = 0.0;
+    double m_volume = 0.0;
+};
+
+class RollingExtremeIndicator : public Indicator {
+public:
+    explicit RollingExtremeIndicator(const IndicatorSpec &spec)
+        : Indicator(spec),
+          m_trackMax(spec.kind == IndicatorSpec::Kind::RollingMax),
+          m_window(spec.period, m_trackMax) {}
+
+protected:
+    void step(const Candle &c, double *out) override
+    {
+        m_window.push(m_trackMax ? c.high : c.low);
+        out[0] = m_window.full() ? m_window.value() : kNaN;
+    }
+    void resetState() override { m_window.clear(); }
+
+private:
+    bool m_trackMax = true;
+    MonotonicWindow m_window;
+};
+} // namespace
+
+Indicator::Indicator(const IndicatorSpec &spec, int outputCount)
+    : m_spec(spec),
+      m_outputs(static_cast<size_t>(std::max(1, outputCount))),
+      m_scratch(m_outputs.size(), kNaN)
+{
+    m_spec.period = std::max(1, m_spec.period);
+}
+
+QString Indicator::name() const
+{
+    switch (m_spec.kind) {
+    case IndicatorSpec::Kind::SMA:        return QStringLiteral("SMA(%1)").arg(m_spec.period);
+    case IndicatorSpec::Kind::EMA:        return QStringLiteral("EMA(%1)").arg(m_spec.period);
+    case IndicatorSpec::Kind::Bollinger:  return QStringLiteral("BB(%1, %2)").arg(m_spec.period).arg(m_spec.multiplier);
+    case IndicatorSpec::Kind::RSI:        return QStringLiteral("RSI(%1)").arg(m_spec.period);
+    case IndicatorSpec::Kind::ATR:        return QStringLiteral("ATR(%1)").arg(m_spec.period);
+    case IndicatorSpec::Kind::VWAP:       return QStringLiteral("VWAP");
+    case IndicatorSpec::Kind::RollingMin: return QStringLiteral("Min(%1)").arg(m_spec.period);
+    case IndicatorSpec::Kind::RollingMax: return QStringLiteral("Max(%1)").arg(m_spec.period);
+    }
+    return QStringLiteral("Unknown");
+}
+
+void Indicator::append(const Candle &c)
+{
+    step(c, m_scratch.data());
+    for (size_t i = 0; i < m_outputs.size(); ++i)
+        m_outputs[i].append(m_scratch[i]);
+}
+
+void Indicator::reset()
+{
+    resetState();
+    for (IndicatorSeries &series : m_outputs)
+        series.clear();
+}
+
+void Indicator::pad(int bars)
+{
+    for (IndicatorSeries &series : m_outputs) {
+        while (series.size() < bars)
+            series.append(kNaN);
+    }
+}
+
+void Indicator::reserve(int bars)
+{
+    for (IndicatorSeries &series : m_outputs)
+        series.reserve(bars);
+}
+
+RollingWindow::RollingWindow(int period)
+    : m_values(static_cast<size_t>(std::max(1, period)), 0.0),
+      m_period(std::max(1, period))
+{
+}
+
+void RollingWindow::push(double value)
+{
+    if (full()) {
+        const double evicted = m_values[m_pos];
+        m_sum -= evicted;
+        m_sumSq -= evicted * evicted;
+    } else {
+        ++m_count;
+    }
+
+    m_values[m_pos] = value;
+    m_sum += value;
+    m_sumSq += value * value;
+    m_pos = (m_pos + 1) % m_period;
+
+    if (m_pos == 0 && full()) {
+        double sum = 0.0;
+        double sumSq = 0.0;
+        for (double v : m_values) {
+            sum += v;
+            sumSq += v * v;
+        }
+        m_sum = sum;
+        m_sumSq = sumSq;
+    }
+}
+
+void RollingWindow::clear()
+{
+    std::fill(m_values.begin(), m_values.end(), 0.0);
+    m_count = 0;
+    m_pos = 0;
+    m_sum = 0.0;
+    m_sumSq = 0.0;
+}
+
+MonotonicWindow::MonotonicWindow(int period, bool trackMax)
+    : m_period(std::max(1, period)),
+      m_trackMax(trackMax)
+{
+}
+
+void MonotonicWindow::push(double value)
+{
+    // Anything the new value dominates can never be the extreme again.
+    while (!m_deque.empty()) {
+        const double back = m_deque.back().second;
+        const bool dominated = m_trackMax ? back <= value : back >= value;
+        if (!dominated)
+            break;
+        m_deque.pop_back();
+    }
+    m_deque.emplace_back(m_index, value);
+    while (m_deque.front().first <= m_index - m_period)
+        m_deque.pop_front();
+    ++m_index;
+}
+
+void MonotonicWindow::clear()
+{
+    m_deque.clear();
+    m_index = 0;
+}
+
+int IndicatorEngine::addIndicator(const IndicatorSpec &spec)
+{
+    std::unique_ptr<Indicator> indicator;
+    switch (spec.kind) {
+    case IndicatorSpec::Kind::SMA:        indicator = std::make_unique<SmaIndicator>(spec); break;
+    case IndicatorSpec::Kind::EMA:        indicator = std::make_unique<EmaIndicator>(spec); break;
+    case IndicatorSpec::Kind::Bollinger:  indicator = std::make_unique<BollingerIndicator>(spec); break;
+    case IndicatorSpec::Kind::RSI:        indicator = std::make_unique<RsiIndicator>(spec); break;
+    case IndicatorSpec::Kind::ATR:        indicator = std::make_unique<AtrIndicator>(spec); break;
+    case IndicatorSpec::Kind::VWAP:       indicator = std::make_unique<VwapIndicator>(spec); break;
+    case IndicatorSpec::Kind::RollingMin:
+    case IndicatorSpec::Kind::RollingMax: indicator = std::make_unique<RollingExtremeIndicator>(spec); break;
+    }
+
+    // Indicators added mid-stream are padded with NaN so every column stays
+    // aligned with the candle index; recompute() backfills them.
+    indicator->pad(m_barCount);
+    m_indicators.push_back(std::move(indicator));
+    return static_cast<int>(m_indicators.size()) - 1;
+}
+
+void IndicatorEngine::removeAll()
+{
+    m_indicators.clear();
+    m_barCount = 0;
+}
+
+void IndicatorEngine::append(const Candle &c)
+{
+    for (auto &indicator : m_indicators)
+        indicator->append(c);
+    ++m_barCount;
+}
+
+void IndicatorEngine::recompute(const QVector<Candle> &candles)
+{
+    clear();
+    for (auto &indicator : m_indicators)
+        indicator->reserve(candles.size());
+    for (const Candle &c : candles)
+        append(c);
+}
+
+void IndicatorEngine::recompute(const CandleHistory &bars)
+{
+    clear();
+    for (auto &indicator : m_indicators)
+        indicator->reserve(bars.size());
+    for (int i = 0; i < bars.size(); ++i)
+        append(bars.candle(i));
+}
+
+void IndicatorEngine::clear()
+{
+    for (auto &indicator : m_indicators)
+        indicator->reset();
+    m_barCount = 0;
+}
+
+const Indicator *IndicatorEngine::indicator(int id) const
+{
+    if (id < 0 || id >= indicatorCount())
+        return nullptr;
+    return m_indicators[static_cast<size_t>(id)].get();
+}
+
+int IndicatorEngine::findIndicator(IndicatorSpec::Kind kind) const
+{
+    for (int i = 0; i < indicatorCount(); ++i) {
+        if (m_indicators[static_cast<size_t>(i)]->spec().kind == kind)
+            return i;
+    }
+    return -1;
+}
+
+const IndicatorSeries &IndicatorEngine::series(int id, int output) const
+{
+    static const IndicatorSeries empty;
+    const Indicator *ind = indicator(id);
+    if (!ind || output < 0 || output >= ind->outputCount())
+        return empty;
+    return ind->output(output);
+}
+
+double IndicatorEngine::value(int id, int index, int output) const
+{
+    const IndicatorSeries &s = series(id, output);
+    if (index < 0 || index >= s.size())
+        return kNaN;
+    return s[index];
+}
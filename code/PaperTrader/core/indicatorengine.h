@@ -0,0 +1,139 @@
+#pragma once
+#include <QVector>
+#include <QString>
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <vector>
+#include "models/candle.h"
+#include "models/candlehistory.h"
+
+// Columnar output buffer aligned with the candle index. Bars inside an
+// indicator's warm-up window hold NaN.
+using IndicatorSeries = QVector<double>;
+
+struct IndicatorSpec {
+    enum class Kind { SMA, EMA, Bollinger, RSI, ATR, VWAP, RollingMin, RollingMax };
+
+    Kind kind = Kind::SMA;
+    int period = 20;
+    double multiplier = 2.0;   // Bollinger band width in standard deviations
+};
+
+/**
+ * Indicator: one streaming technical indicator.
+ *
+ * Every implementation keeps just enough running state to produce the value
+ * for a new bar in O(1), and appends it to its output columns.
+ */
+class Indicator {
+public:
+    explicit Indicator(const IndicatorSpec &spec, int outputCount = 1);
+    virtual ~Indicator() = default;
+
+    const IndicatorSpec &spec() const { return m_spec; }
+    QString name() const;
+
+    int outputCount() const { return static_cast<int>(m_outputs.size()); }
+    const IndicatorSeries &output(int index = 0) const { return m_outputs[index]; }
+
+    void append(const Candle &c);
+    void reset();
+    void reserve(int bars);
+    void pad(int bars);
+
+protected:
+    // Computes the outputs for the next bar; one value per output column.
+    virtual void step(const Candle &c, double *out) = 0;
+    virtual void resetState() = 0;
+
+    IndicatorSpec m_spec;
+
+private:
+    std::vector<IndicatorSeries> m_outputs;
+    std::vector<double> m_scratch;
+};
+
+/**
+ * RollingWindow: fixed-size ring buffer with running sum and sum of squares.
+ *
+ * The sums are rebuilt from the buffer each time the ring wraps so that
+ * floating-point drift never accumulates over long sessions; that costs
+ * O(period) once every period bars, i.e. O(1) amortised.
+ */
+class RollingWindow {
+public:
+    explicit RollingWindow(int period = 1);
+
+    void push(double value);
+    void clear();
+
+    bool full() const { return m_count >= m_period; }
+    int period() const { return m_period; }
+    double sum() const { return m_sum; }
+    double sumSquares() const { return m_sumSq; }
+    double mean() const { return m_count > 0 ? m_sum / std::min(m_count, m_period) : 0.0; }
+
+private:
+    std::vector<double> m_values;
+    int m_period = 1;
+    int m_count = 0;
+    int m_pos = 0;
+    double m_sum = 0.0;
+    double m_sumSq = 0.0;
+};
+
+/**
+ * MonotonicWindow: rolling minimum or maximum using a monotonic deque, so each
+ * bar is pushed and popped at most once.
+ */
+class MonotonicWindow {
+public:
+    MonotonicWindow(int period, bool trackMax);
+
+    void push(double value);
+    void clear();
+
+    bool full() const { return m_index >= m_period; }
+    double value() const { return m_deque.empty() ? 0.0 : m_deque.front().second; }
+
+private:
+    std::deque<std::pair<long long, double>> m_deque;
+    long long m_index = 0;
+    int m_period = 1;
+    bool m_trackMax = true;
+};
+
+/**
+ * IndicatorEngine: owns a set of indicators computed over one candle stream.
+ *
+ * Feed it live via append() (e.g. from ChartManager::candleReceived) or in
+ * bulk with recompute(); both paths share the same O(1) per-bar update so the
+ * columns are identical either way.
+ */
+class IndicatorEngine {
+public:
+    IndicatorEngine() = default;
+    IndicatorEngine(const IndicatorEngine &) = delete;
+    IndicatorEngine &operator=(const IndicatorEngine &) = delete;
+
+    int addIndicator(const IndicatorSpec &spec);
+    void removeAll();
+
+    void append(const Candle &c);
+    void recompute(const QVector<Candle> &candles);
+    void recompute(const CandleHistory &bars);
+    void clear();
+
+    int barCount() const { return m_barCount; }
+    int indicatorCount() const { return static_cast<int>(m_indicators.size()); }
+    const Indicator *indicator(int id) const;
+    int findIndicator(IndicatorSpec::Kind kind) const;
+
+    const IndicatorSeries &series(int id, int output = 0) const;
+    double value(int id, int index, int output = 0) const;
+
+private:
+    std::vector<std::unique_ptr<Indicator>> m_indicators;
+    int m_barCount = 0;
+};
@@ -0,0 +1,329 @@
+#include "indicatorkernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PAPERTRADER_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang need the AVX2 functions tagged so they can live in a TU that
+// is otherwise built for the baseline ISA; MSVC accepts the intrinsics as-is.
+#if defined(PAPERTRADER_KERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PAPERTRADER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PAPERTRADER_TARGET_AVX2
+#endif
+
+namespace IndicatorKernels {
+
+namespace {
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// Window sums are re-anchored at the start of every block: the block is
+// shifted by its first value so prefix sums stay small and exact enough,
+// and errors never carry over from one block to the next.
+std::size_t blockSize(int period)
+{
+    return std::max<std::size_t>(4096, static_cast<std::size_t>(period) * 8);
+}
+
+void fillWarmup(double *out, std::size_t count, std::size_t warmup)
+{
+    std::fill(out, out + std::min(count, warmup), kNaN);
+}
+
+Isa detectIsa()
+{
+#if defined(PAPERTRADER_KERNELS_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return Isa::Scalar;
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+        return Isa::Scalar;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) ? Isa::Avx2 : Isa::Scalar;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? Isa::Avx2 : Isa::Scalar;
+#endif
+#else
+    return Isa::Scalar;
+#endif
+}
+
+// ---- Scalar implementations ----
+
+void windowScalar(const double *in, double *mean, double *variance,
+                  std::size_t count, int period)
+{
+    const std::size_t p = static_cast<std::size_t>(period);
+    const std::size_t block = blockSize(period);
+
+    for (std::size_t b = p - 1; b < count; b += block) {
+        const std::size_t e = std::min(count, b + block);
+        const double anchor = in[b];
+        double sum = 0.0;
+        double sumSq = 0.0;
+        for (std::size_t j = b + 1 - p; j <= b; ++j) {
+            const double d = in[j] - anchor;
+            sum += d;
+            sumSq += d * d;
+        }
+        for (std::size_t i = b; i < e; ++i) {
+            if (i > b) {
+                const double added = in[i] - anchor;
+                const double removed = in[i - p] - anchor;
+                sum += added - removed;
+                sumSq += added * added - removed * removed;
+            }
+            const double m = sum / period;
+            if (mean)
+                mean[i] = anchor + m;
+            if (variance)
+                variance[i] = std::max(0.0, sumSq / period - m * m);
+        }
+    }
+}
+
+void trueRangeScalar(const double *high, const double *low, const double *close,
+                     double *out, std::size_t from, std::size_t count)
+{
+    for (std::size_t i = from; i < count; ++i) {
+        const double prev = close[i - 1];
+        out[i] = std::max({high[i] - low[i],
+                           std::abs(high[i] - prev),
+                           std::abs(low[i] - prev)});
+    }
+}
+
+void returnsScalar(const double *close, double *out, std::size_t from, std::size_t count)
+{
+    for (std::size_t i = from; i < count; ++i)
+        out[i] = close[i] / close[i - 1] - 1.0;
+}
+
+#if defined(PAPERTRADER_KERNELS_X86)
+// ---- AVX2 implementations ----
+
+// Inclusive prefix sum of four lanes, then offset by the running carry.
+PAPERTRADER_TARGET_AVX2
+inline __m256d scan4(__m256d x, __m256d carry)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    __m256d t = _mm256_permute4x64_pd(x, _MM_SHUFFLE(2, 1, 0, 0));
+    x = _mm256_add_pd(x, _mm256_blend_pd(t, zero, 0x1));
+    t = _mm256_permute4x64_pd(x, _MM_SHUFFLE(1, 0, 0, 0));
+    x = _mm256_add_pd(x, _mm256_blend_pd(t, zero, 0x3));
+    return _mm256_add_pd(x, carry);
+}
+
+PAPERTRADER_TARGET_AVX2
+void windowAvx2(const double *in, double *mean, double *variance,
+                std::size_t count, int period)
+{
+    const std::size_t p = static_cast<std::size_t>(period);
+    const std::size_t block = blockSize(period);
+    const __m256d invPeriod = _mm256_set1_pd(1.0 / period);
+    const __m256d zero = _mm256_setzero_pd();
+
+    // prefix[k] holds the sum of the first k shifted inputs of the block.
+    std::vector<double> prefix(block + p + 4);
+    std::vector<double> prefixSq(variance ? block + p + 4 : 0);
+
+    for (std::size_t b = p - 1; b < count; b += block) {
+        const std::size_t e = std::min(count, b + block);
+        const std::size_t s = b + 1 - p;
+        const std::size_t n = e - s;
+        const double anchor = in[b];
+        const __m256d anchorV = _mm256_set1_pd(anchor);
+
+        prefix[0] = 0.0;
+        if (variance)
+            prefixSq[0] = 0.0;
+
+        __m256d carry = zero;
+        __m256d carrySq = zero;
+        std::size_t k = 0;
+        for (; k + 4 <= n; k += 4) {
+            const __m256d d = _mm256_sub_pd(_mm256_loadu_pd(in + s + k), anchorV);
+            const __m256d sum = scan4(d, carry);
+            _mm256_storeu_pd(prefix.data() + k + 1, sum);
+            carry = _mm256_permute4x64_pd(sum, _MM_SHUFFLE(3, 3, 3, 3));
+            if (variance) {
+                const __m256d sumSq = scan4(_mm256_mul_pd(d, d), carrySq);
+                _mm256_storeu_pd(prefixSq.data() + k + 1, sumSq);
+                carrySq = _mm256_permute4x64_pd(sumSq, _MM_SHUFFLE(3, 3, 3, 3));
+            }
+        }
+        for (; k < n; ++k) {
+            const double d = in[s + k] - anchor;
+            prefix[k + 1] = prefix[k] + d;
+            if (variance)
+                prefixSq[k + 1] = prefixSq[k] + d * d;
+        }
+
+        // Output i covers inputs (i - p, i], i.e. prefix[i - s + 1] - prefix[i - s + 1 - p].
+        std::size_t i = b;
+        for (; i + 4 <= e; i += 4) {
+            const std::size_t hi = i - s + 1;
+            const __m256d m = _mm256_mul_pd(
+                    _mm256_sub_pd(_mm256_loadu_pd(prefix.data() + hi),
+                                  _mm256_loadu_pd(prefix.data() + hi - p)),
+                    invPeriod);
+            if (mean)
+                _mm256_storeu_pd(mean + i, _mm256_add_pd(m, anchorV));
+            if (variance) {
+                const __m256d sq = _mm256_mul_pd(
+                        _mm256_sub_pd(_mm256_loadu_pd(prefixSq.data() + hi),
+                                      _mm256_loadu_pd(prefixSq.data() + hi - p)),
+                        invPeriod);
+                const __m256d var = _mm256_sub_pd(sq, _mm256_mul_pd(m, m));
+                _mm256_storeu_pd(variance + i, _mm256_max_pd(var, zero));
+            }
+        }
+        for (; i < e; ++i) {
+            const std::size_t hi = i - s + 1;
+            const double m = (prefix[hi] - prefix[hi - p]) / period;
+            if (mean)
+                mean[i] = anchor + m;
+            if (variance) {
+                const double sq = (prefixSq[hi] - prefixSq[hi - p]) / period;
+                variance[i] = std::max(0.0, sq - m * m);
+            }
+        }
+    }
+}
+
+PAPERTRADER_TARGET_AVX2
+void trueRangeAvx2(const double *high, const double *low, const double *close,
+                   double *out, std::size_t from, std::size_t count)
+{
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    std::size_t i = from;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d h = _mm256_loadu_pd(high + i);
+        const __m256d l = _mm256_loadu_pd(low + i);
+        const __m256d prev = _mm256_loadu_pd(close + i - 1);
+        const __m256d range = _mm256_sub_pd(h, l);
+        const __m256d up = _mm256_andnot_pd(signMask, _mm256_sub_pd(h, prev));
+        const __m256d down = _mm256_andnot_pd(signMask, _mm256_sub_pd(l, prev));
+        _mm256_storeu_pd(out + i, _mm256_max_pd(range, _mm256_max_pd(up, down)));
+    }
+    trueRangeScalar(high, low, close, out, i, count);
+}
+
+PAPERTRADER_TARGET_AVX2
+void returnsAvx2(const double *close, double *out, std::size_t from, std::size_t count)
+{
+    const __m256d one = _mm256_set1_pd(1.0);
+    std::size_t i = from;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d ratio = _mm256_div_pd(_mm256_loadu_pd(close + i),
+                                            _mm256_loadu_pd(close + i - 1));
+        _mm256_storeu_pd(out + i, _mm256_sub_pd(ratio, one));
+    }
+    returnsScalar(close, out, i, count);
+}
+#endif
+} // namespace
+
+Isa detectedIsa()
+{
+    static const Isa isa = detectIsa();
+    return isa;
+}
+
+#if defined(PAPERTRADER_KERNELS_X86)
+static bool useAvx2(Isa isa)
+{
+    return isa == Isa::Avx2 && detectedIsa() == Isa::Avx2;
+}
+#endif
+
+const char *isaName(Isa isa)
+{
+    switch (isa) {
+    case Isa::Scalar: return "scalar";
+    case Isa::Avx2:   return "avx2";
+    }
+    return "unknown";
+}
+
+void movingAverage(const double *in, double *out, std::size_t count, int period, Isa isa)
+{
+    if (count == 0 || period <= 0)
+        return;
+    fillWarmup(out, count, static_cast<std::size_t>(period) - 1);
+#if defined(PAPERTRADER_KERNELS_X86)
+    if (useAvx2(isa)) {
+        windowAvx2(in, out, nullptr, count, period);
+        return;
+    }
+#else
+    static_cast<void>(isa);
+#endif
+    windowScalar(in, out, nullptr, count, period);
+}
+
+void rollingVariance(const double *in, double *out, std::size_t count, int period, Isa isa)
+{
+    if (count == 0 || period <= 0)
+        return;
+    fillWarmup(out, count, static_cast<std::size_t>(period) - 1);
+#if defined(PAPERTRADER_KERNELS_X86)
+    if (useAvx2(isa)) {
+        windowAvx2(in, nullptr, out, count, period);
+        return;
+    }
+#else
+    static_cast<void>(isa);
+#endif
+    windowScalar(in, nullptr, out, count, period);
+}
+
+void trueRange(const double *high, const double *low, const double *close,
+               double *out, std::size_t count, Isa isa)
+{
+    if (count == 0)
+        return;
+    out[0] = high[0] - low[0];
+#if defined(PAPERTRADER_KERNELS_X86)
+    if (useAvx2(isa)) {
+        trueRangeAvx2(high, low, close, out, 1, count);
+        return;
+    }
+#else
+    static_cast<void>(isa);
+#endif
+    trueRangeScalar(high, low, close, out, 1, count);
+}
+
+void simpleReturns(const double *close, double *out, std::size_t count, Isa isa)
+{
+    if (count == 0)
+        return;
+    out[0] = kNaN;
+#if defined(PAPERTRADER_KERNELS_X86)
+    if (useAvx2(isa)) {
+        returnsAvx2(close, out, 1, count);
+        return;
+    }
+#else
+    static_cast<void>(isa);
+#endif
+    returnsScalar(close, out, 1, count);
+}
+
+} // namespace IndicatorKernels
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+
+/**
+ * IndicatorKernels: bulk indicator computations over contiguous columns.
+ *
+ * Used for backtests and zoomed-out views where millions of bars are
+ * recomputed at once; IndicatorEngine covers the incremental per-bar case.
+ * Each kernel has an AVX2 path and a scalar fallback. The default Isa is the
+ * best one the running CPU supports, detected once at startup. Outputs that
+ * have no value yet (warm-up, first bar) are written as NaN.
+ */
+namespace IndicatorKernels {
+
+enum class Isa { Scalar, Avx2 };
+
+Isa detectedIsa();
+const char *isaName(Isa isa);
+
+// out[i] = mean(in[i - period + 1 .. i])
+void movingAverage(const double *in, double *out, std::size_t count, int period,
+                   Isa isa = detectedIsa());
+
+// out[i] = population variance of in[i - period + 1 .. i]
+void rollingVariance(const double *in, double *out, std::size_t count, int period,
+                     Isa isa = detectedIsa());
+
+// out[i] = max(high - low, |high - prevClose|, |low - prevClose|)
+void trueRange(const double *high, const double *low, const double *close,
+               double *out, std::size_t count, Isa isa = detectedIsa());
+
+// out[i] = close[i] / close[i - 1] - 1
+void simpleReturns(const double *close, double *out, std::size_t count,
+                   Isa isa = detectedIsa());
+
+} // namespace IndicatorKernels
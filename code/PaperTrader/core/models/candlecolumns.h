@@ -0,0 +1,69 @@
+#pragma once
+#include <QVector>
+#include "candle.h"
+
+// Structure-of-arrays view of a candle history. Bulk kernels work on the
+// contiguous columns directly instead of striding through Candle objects.
+struct CandleColumns {
+    QVector<qint64> time;     // msecs since epoch (UTC)
+    QVector<double> open;
+    QVector<double> high;
+    QVector<double> low;
+    QVector<double> close;
+    QVector<double> volume;
+
+    int size() const { return static_cast<int>(close.size()); }
+    bool isEmpty() const { return close.isEmpty(); }
+
+    void reserve(int count)
+    {
+        time.reserve(count);
+        open.reserve(count);
+        high.reserve(count);
+        low.reserve(count);
+        close.reserve(count);
+        volume.reserve(count);
+    }
+
+    void clear()
+    {
+        time.clear();
+        open.clear();
+        high.clear();
+        low.clear();
+        close.clear();
+        volume.clear();
+    }
+
+    void append(const Candle &c)
+    {
+        time.append(c.timestamp.isValid() ? c.timestamp.toMSecsSinceEpoch() : 0);
+        open.append(c.open);
+        high.append(c.high);
+        low.append(c.low);
+        close.append(c.close);
+        volume.append(c.volume);
+    }
+
+    Candle candle(int index, const QString &symbol = QString()) const
+    {
+        Candle c;
+        c.symbol = symbol;
+        c.timestamp = QDateTime::fromMSecsSinceEpoch(time[index], Qt::UTC);
+        c.open = open[index];
+        c.high = high[index];
+        c.low = low[index];
+        c.close = close[index];
+        c.volume = volume[index];
+        return c;
+    }
+
+    static CandleColumns fromCandles(const QVector<Candle> &candles)
+    {
+        CandleColumns columns;
+        columns.reserve(candles.size());
+        for (const Candle &c : candles)
+            columns.append(c);
+        return columns;
+    }
+};
@@ -0,0 +1,143 @@
+#pragma once
+#include <QtGlobal>
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include "candle.h"
+#include "candlecolumns.h"
+
+// Column stored in fixed-size chunks. Growing at either end allocates only
+// the new chunk, so prepending a page never moves the bars already held and
+// releasing old bars frees whole chunks.
+template <typename T>
+class ChunkedColumn {
+public:
+    static constexpr int kChunkShift = 12;
+    static constexpr int kChunkSize = 1 << kChunkShift;
+
+    int size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+
+    const T &operator[](int index) const { return at(m_front + index); }
+    T &operator[](int index) { return at(m_front + index); }
+    const T &first() const { return (*this)[0]; }
+    const T &last() const { return (*this)[m_size - 1]; }
+
+    void append(const T &value)
+    {
+        if (m_front + m_size == capacity())
+            m_chunks.push_back(std::make_unique<T[]>(kChunkSize));
+        at(m_front + m_size) = value;
+        ++m_size;
+    }
+
+    // Inserts values[0..count) in front of the current first element.
+    void prepend(const T *values, int count)
+    {
+        while (m_front < count) {
+            m_chunks.push_front(std::make_unique<T[]>(kChunkSize));
+            m_front += kChunkSize;
+        }
+        m_front -= count;
+        m_size += count;
+        for (int i = 0; i < count; ++i)
+            at(m_front + i) = values[i];
+    }
+
+    void removeFirst(int count)
+    {
+        count = std::min(count, m_size);
+        m_front += count;
+        m_size -= count;
+        while (m_front >= kChunkSize) {
+            m_chunks.pop_front();
+            m_front -= kChunkSize;
+        }
+    }
+
+    void clear()
+    {
+        m_chunks.clear();
+        m_front = 0;
+        m_size = 0;
+    }
+
+private:
+    int capacity() const { return static_cast<int>(m_chunks.size()) * kChunkSize; }
+    T &at(int slot) { return m_chunks[static_cast<size_t>(slot >> kChunkShift)][slot & (kChunkSize - 1)]; }
+    const T &at(int slot) const { return m_chunks[static_cast<size_t>(slot >> kChunkShift)][slot & (kChunkSize - 1)]; }
+
+    std::deque<std::unique_ptr<T[]>> m_chunks;
+    int m_front = 0;   // unused slots before the first element
+    int m_size = 0;
+};
+
+// Candle history of one symbol as chunked columns: live bars append at the
+// back, pages of older bars loaded from disk prepend at the front.
+struct CandleHistory {
+    ChunkedColumn<qint64> time;     // msecs since epoch (UTC)
+    ChunkedColumn<double> open;
+    ChunkedColumn<double> high;
+    ChunkedColumn<double> low;
+    ChunkedColumn<double> close;
+    ChunkedColumn<double> volume;
+
+    int size() const { return close.size(); }
+    bool isEmpty() const { return close.isEmpty(); }
+
+    void append(const Candle &c)
+    {
+        time.append(c.timestamp.isValid() ? c.timestamp.toMSecsSinceEpoch() : 0);
+        open.append(c.open);
+        high.append(c.high);
+        low.append(c.low);
+        close.append(c.close);
+        volume.append(c.volume);
+    }
+
+    // Prepends the newest `count` bars of `page`, which must be older than
+    // the current first bar.
+    void prepend(const CandleColumns &page, int count)
+    {
+        const int from = page.size() - count;
+        time.prepend(page.time.constData() + from, count);
+        open.prepend(page.open.constData() + from, count);
+        high.prepend(page.high.constData() + from, count);
+        low.prepend(page.low.constData() + from, count);
+        close.prepend(page.close.constData() + from, count);
+        volume.prepend(page.volume.constData() + from, count);
+    }
+
+    void removeFirst(int count)
+    {
+        time.removeFirst(count);
+        open.removeFirst(count);
+        high.removeFirst(count);
+        low.removeFirst(count);
+        close.removeFirst(count);
+        volume.removeFirst(count);
+    }
+
+    void clear()
+    {
+        time.clear();
+        open.clear();
+        high.clear();
+        low.clear();
+        close.clear();
+        volume.clear();
+    }
+
+    Candle candle(int index, const QString &symbol = QString()) const
+    {
+        Candle c;
+        c.symbol = symbol;
+        c.timestamp = QDateTime::fromMSecsSinceEpoch(time[index], Qt::UTC);
+        c.open = open[index];
+        c.high = high[index];
+        c.low = low[index];
+        c.close = close[index];
+        c.volume = volume[index];
+        return c;
+    }
+};
@@ -1,11 +1,22 @@
 #ifndef EXECUTIONREPORT_H
 #define EXECUTIONREPORT_H
-#include <QString>
+#include <QtGlobal>
 
+#include "ordertypes.h"
+
+// One event on one order. `status` says what happened: Filled or
+// PartiallyFilled for a fill (at fillPx for fillQty), Cancelled when the rest
+// was cancelled, Rejected when the order never reached the book.
 struct ExecutionReport {
-    int orderId{};
-    QString status;   // "Filled", "Cancelled"
+    quint64 orderId{};
+    OrderStatus status = OrderStatus::Filled;
     double fillPx{};
     double fillQty{};
+    double leavesQty{};          // still working afterwards
+    int account{};
+    int symbol{};                // book index (ExchangeSimulator::listSymbol)
+    OrderSide side = OrderSide::Buy;
+    quint64 counterOrderId{};    // the other side of a fill
+    RejectReason reason = RejectReason::None;
 };
 #endif // EXECUTIONREPORT_H
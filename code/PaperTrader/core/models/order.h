@@ -1,19 +1,53 @@
 #pragma once
 #include <QString>
-#include <QDateTime>
+#include <QtGlobal>
+
+#include "ordertypes.h"
 
 struct Order {
     int id = 0;
+    OrderSide side = OrderSide::Buy;
+    OrderType type = OrderType::Market;
+    OrderStatus status = OrderStatus::Open;
+    RejectReason rejectReason = RejectReason::None;   // set on partial acceptance
     QString symbol;
-    double price = 0.0;
+    double price = 0.0;        // limit price (Limit, StopLimit)
+    double stopPrice = 0.0;    // trigger level; for trailing stops, the level at placement
+    double trailAmount = 0.0;  // trailing stops: distance kept behind the best price
+    bool triggered = false;    // stop types: trigger crossed
+    TimeInForce timeInForce = TimeInForce::GTC;
+    qint64 expiresAt = 0;      // GTD/DAY deadline, msecs since epoch (UTC)
+    int parentId = 0;          // bracket entry this exit leg belongs to
+    int ocoGroupId = 0;        // one-cancels-other group, 0 if none
     double quantity = 0.0;
     double requestedQuantity = 0.0;
-    QString side;     // "BUY" / "SELL"
-    QString type;     // "Market", "Limit", etc.
-    QString status;   // "Open", "Filled", "Cancelled"
-    QDateTime timestamp;
+    qint64 timestamp = 0;   // msecs since epoch (UTC)
     double filledPrice = 0.0;
     double filledQuantity = 0.0;
     double fee = 0.0;
-    QString errorCode;
+
+    // Rests on the book at its limit price.
+    bool isRestingLimit() const
+    {
+        return (type == OrderType::Limit || (type == OrderType::StopLimit && triggered))
+                && quantity > 0.0 && price > 0.0 && OrderState::isWorking(status);
+    }
+    // Waits for its stop trigger.
+    bool isPendingStop() const
+    {
+        return isStopType(type) && !triggered && quantity > 0.0 && OrderState::isWorking(status);
+    }
+};
+
+// Everything needed to place one order.
+struct OrderRequest {
+    OrderType type = OrderType::Market;
+    QString symbol;
+    OrderSide side = OrderSide::Buy;
+    double quantity = 0.0;
+    double price = 0.0;        // limit price; market orders: reference price
+    double stopPrice = 0.0;    // Stop, StopLimit
+    double trailAmount = 0.0;  // TrailingStop
+    TimeInForce timeInForce = TimeInForce::GTC;
+    qint64 expiresAt = 0;      // GTD only; DAY orders compute their own
 };
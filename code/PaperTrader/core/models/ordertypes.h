@@ -0,0 +1,66 @@
+#pragma once
+#include <QtGlobal>
+
+// Order vocabulary of the trading core. The core only compares these values;
+// display text is produced in the UI (see OrdersModel).
+enum class OrderSide : quint8 { Buy, Sell };
+// Stop types wait off the book until their trigger is crossed; a stop then
+// fills like a market order and a stop-limit rests at its limit price.
+enum class OrderType : quint8 { Market, Limit, Stop, StopLimit, TrailingStop };
+// GTC rests until filled or cancelled; IOC fills what it can at once and
+// cancels the rest; FOK fills in full at once or not at all; GTD and DAY
+// expire at a deadline (DAY: the next UTC midnight).
+enum class TimeInForce : quint8 { GTC, IOC, FOK, GTD, DAY };
+enum class OrderStatus : quint8 { Open, PartiallyFilled, Filled, Cancelled, Rejected };
+
+enum class RejectReason : quint8 {
+    None,
+    InvalidSymbol,
+    InvalidQuantity,
+    InvalidPrice,
+    InsufficientFunds,
+    InsufficientMargin,
+    PartialFill,          // accepted, but for less than the requested quantity
+    InvalidTimeInForce,   // unsupported for the order type, or expiry in the past
+    Unfillable,           // IOC/FOK could not execute immediately
+    Expired,              // GTD/DAY deadline passed
+    NotAmendable,         // unknown, no longer working, or a type that cannot be amended
+};
+
+constexpr bool isStopType(OrderType type)
+{
+    return type == OrderType::Stop || type == OrderType::StopLimit || type == OrderType::TrailingStop;
+}
+
+namespace OrderState {
+
+constexpr int kStatusCount = 5;
+
+// kTransitions[from][to]: the status changes an order may make. Filled,
+// Cancelled and Rejected are terminal.
+constexpr bool kTransitions[kStatusCount][kStatusCount] = {
+    //            Open   Partial Filled Cancel Reject
+    /* Open    */ {false, true,  true,  true,  true},
+    /* Partial */ {false, true,  true,  true,  false},
+    /* Filled  */ {false, false, false, false, false},
+    /* Cancel  */ {false, false, false, false, false},
+    /* Reject  */ {false, false, false, false, false},
+};
+
+constexpr bool canTransition(OrderStatus from, OrderStatus to)
+{
+    return kTransitions[static_cast<int>(from)][static_cast<int>(to)];
+}
+
+// Still resting: may fill or be cancelled.
+constexpr bool isWorking(OrderStatus status)
+{
+    return status == OrderStatus::Open || status == OrderStatus::PartiallyFilled;
+}
+
+constexpr bool isTerminal(OrderStatus status)
+{
+    return !isWorking(status);
+}
+
+} // namespace OrderState
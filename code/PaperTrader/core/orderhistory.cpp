@@ -0,0 +1,200 @@
+#include "orderhistory.h"
+
+#include <QFile>
+#include <algorithm>
+
+OrderHistory::OrderHistory(int spillThreshold)
+    : m_spillThreshold(std::max(1, spillThreshold))
+{
+}
+
+void OrderHistory::setSpillPath(const QString &path)
+{
+    // Records already on disk stay in the file they were written to.
+    if (m_spilled > 0 || path == m_spillPath)
+        return;
+    m_spillPath = path;
+    m_indexPath = path.isEmpty() ? QString() : path + QStringLiteral(".idx");
+    if (!path.isEmpty()) {
+        QFile::remove(path);
+        QFile::remove(m_indexPath);
+    }
+    if (m_recent.size() >= m_spillThreshold)
+        spill();
+}
+
+void OrderHistory::append(const Order &order)
+{
+    m_recentIds.insert(order.id, m_recent.size());
+    m_recent.append(toRecord(order));
+    if (m_recent.size() >= m_spillThreshold)
+        spill();
+}
+
+void OrderHistory::spill()
+{
+    if (m_spillPath.isEmpty() || m_recent.isEmpty())
+        return;
+
+    // Orders are archived as they finish, which is not id order, so each
+    // block's ids are sorted before they go to the index file.
+    const int count = m_recent.size();
+    QVector<IndexEntry> index(count);
+    Block block{m_spilled, count, m_recent.first().id, m_recent.first().id};
+    for (int i = 0; i < count; ++i) {
+        index[i] = IndexEntry{m_recent.at(i).id, i};
+        block.minId = std::min(block.minId, index[i].id);
+        block.maxId = std::max(block.maxId, index[i].id);
+    }
+    std::sort(index.begin(), index.end(), [](const IndexEntry &a, const IndexEntry &b) {
+        return a.id != b.id ? a.id < b.id : a.offset < b.offset;
+    });
+
+    QFile f(m_spillPath);
+    QFile idx(m_indexPath);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Append)
+        || !idx.open(QIODevice::WriteOnly | QIODevice::Append))
+        return;   // keep them in memory and try again next time
+    const qint64 bytes = qint64(count) * qint64(sizeof(Record));
+    const qint64 indexBytes = qint64(count) * qint64(sizeof(IndexEntry));
+    if (f.write(reinterpret_cast<const char *>(m_recent.constData()), bytes) != bytes
+        || idx.write(reinterpret_cast<const char *>(index.constData()), indexBytes) != indexBytes) {
+        f.resize(m_spilled * qint64(sizeof(Record)));
+        idx.resize(m_spilled * qint64(sizeof(IndexEntry)));
+        return;
+    }
+    m_blocks.append(block);
+    m_spilled += count;
+    m_recent.clear();
+    m_recentIds.clear();
+}
+
+QVector<OrderHistory::Record> OrderHistory::readSpilled(qint64 first, qint64 count) const
+{
+    QVector<Record> records;
+    QFile f(m_spillPath);
+    if (count <= 0 || !f.open(QIODevice::ReadOnly))
+        return records;
+    records.resize(static_cast<int>(count));
+    f.seek(first * qint64(sizeof(Record)));
+    const qint64 bytes = f.read(reinterpret_cast<char *>(records.data()),
+                                count * qint64(sizeof(Record)));
+    records.resize(static_cast<int>(std::max<qint64>(0, bytes) / qint64(sizeof(Record))));
+    return records;
+}
+
+QList<Order> OrderHistory::page(int first, int count) const
+{
+    QList<Order> orders;
+    first = std::max(0, first);
+    const int last = std::min(size(), first + std::max(0, count));
+    if (first >= last)
+        return orders;
+    orders.reserve(last - first);
+
+    if (first < m_spilled) {
+        const qint64 fromDisk = std::min<qint64>(last, m_spilled) - first;
+        for (const Record &record : readSpilled(first, fromDisk))
+            orders.append(toOrder(record));
+    }
+    const int spilled = static_cast<int>(m_spilled);
+    for (int i = std::max(first, spilled); i < last; ++i)
+        orders.append(toOrder(m_recent.at(i - spilled)));
+    return orders;
+}
+
+std::optional<Order> OrderHistory::find(int orderId) const
+{
+    const auto it = m_recentIds.constFind(orderId);
+    if (it != m_recentIds.constEnd())
+        return toOrder(m_recent.at(it.value()));
+    return findSpilled(orderId);
+}
+
+std::optional<Order> OrderHistory::findSpilled(int orderId) const
+{
+    QFile idx(m_indexPath);
+    if (m_blocks.isEmpty() || !idx.open(QIODevice::ReadOnly))
+        return std::nullopt;
+
+    QVector<IndexEntry> index;
+    for (auto block = m_blocks.crbegin(); block != m_blocks.crend(); ++block) {
+        if (orderId < block->minId || orderId > block->maxId)
+            continue;
+        index.resize(block->count);
+        const qint64 bytes = qint64(block->count) * qint64(sizeof(IndexEntry));
+        if (!idx.seek(block->first * qint64(sizeof(IndexEntry)))
+            || idx.read(reinterpret_cast<char *>(index.data()), bytes) != bytes)
+            return std::nullopt;
+
+        // Last entry with this id is the newest record in the block.
+        const auto entry = std::upper_bound(index.cbegin(), index.cend(), orderId,
+                                            [](int id, const IndexEntry &e) { return id < e.id; });
+        if (entry == index.cbegin() || (entry - 1)->id != orderId)
+            continue;
+        const QVector<Record> records = readSpilled(block->first + (entry - 1)->offset, 1);
+        if (records.isEmpty() || records.first().id != orderId)
+            return std::nullopt;
+        return toOrder(records.first());
+    }
+    return std::nullopt;
+}
+
+OrderHistory::Record OrderHistory::toRecord(const Order &order)
+{
+    const auto next = static_cast<quint32>(m_symbols.size());
+    const quint32 symbol = m_symbolIds.value(order.symbol, next);
+    if (symbol == next) {
+        m_symbolIds.insert(order.symbol, symbol);
+        m_symbols.append(order.symbol);
+    }
+
+    Record record{};
+    record.timestamp = order.timestamp;
+    record.expiresAt = order.expiresAt;
+    record.price = order.price;
+    record.stopPrice = order.stopPrice;
+    record.trailAmount = order.trailAmount;
+    record.quantity = order.quantity;
+    record.requestedQuantity = order.requestedQuantity;
+    record.filledPrice = order.filledPrice;
+    record.filledQuantity = order.filledQuantity;
+    record.fee = order.fee;
+    record.id = order.id;
+    record.parentId = order.parentId;
+    record.ocoGroupId = order.ocoGroupId;
+    record.symbol = symbol;
+    record.side = static_cast<quint8>(order.side);
+    record.type = static_cast<quint8>(order.type);
+    record.status = static_cast<quint8>(order.status);
+    record.rejectReason = static_cast<quint8>(order.rejectReason);
+    record.timeInForce = static_cast<quint8>(order.timeInForce);
+    record.triggered = order.triggered ? 1 : 0;
+    return record;
+}
+
+Order OrderHistory::toOrder(const Record &record) const
+{
+    Order order;
+    order.id = record.id;
+    order.side = static_cast<OrderSide>(record.side);
+    order.type = static_cast<OrderType>(record.type);
+    order.status = static_cast<OrderStatus>(record.status);
+    order.rejectReason = static_cast<RejectReason>(record.rejectReason);
+    order.symbol = m_symbols.value(static_cast<int>(record.symbol));
+    order.price = record.price;
+    order.stopPrice = record.stopPrice;
+    order.trailAmount = record.trailAmount;
+    order.triggered = record.triggered != 0;
+    order.timeInForce = static_cast<TimeInForce>(record.timeInForce);
+    order.expiresAt = record.expiresAt;
+    order.parentId = record.parentId;
+    order.ocoGroupId = record.ocoGroupId;
+    order.quantity = record.quantity;
+    order.requestedQuantity = record.requestedQuantity;
+    order.timestamp = record.timestamp;
+    order.filledPrice = record.filledPrice;
+    order.filledQuantity = record.filledQuantity;
+    order.fee = record.fee;
+    return order;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <optional>
+
+#include "models/order.h"
+
+/**
+ * OrderHistory: finished orders, oldest first, as fixed-size records.
+ *
+ * Append-only. Symbols are stored as indexes into a table of the distinct
+ * symbols seen. Once `spillThreshold` records pile up in memory and a spill
+ * file is set, they are appended to that file and dropped from memory.
+ * Each spilled block also writes its ids, sorted, to `<file>.idx`; memory
+ * keeps only each block's position and id range (24 bytes per block), so
+ * the footprint stays near flat however long the session runs. Pages are
+ * read back by position for the history view; lookups by id read one index
+ * block and one record.
+ */
+class OrderHistory {
+public:
+    explicit OrderHistory(int spillThreshold = 4096);
+
+    // Session scratch file; any previous contents are discarded.
+    void setSpillPath(const QString &path);
+
+    void append(const Order &order);
+    int size() const { return static_cast<int>(m_spilled) + static_cast<int>(m_recent.size()); }
+    int inMemoryCount() const { return static_cast<int>(m_recent.size()); }
+
+    // Up to `count` orders starting at position `first`, oldest first.
+    QList<Order> page(int first, int count) const;
+    // Newest record with that id.
+    std::optional<Order> find(int orderId) const;
+
+private:
+    struct Record {
+        qint64 timestamp;
+        qint64 expiresAt;
+        double price;
+        double stopPrice;
+        double trailAmount;
+        double quantity;
+        double requestedQuantity;
+        double filledPrice;
+        double filledQuantity;
+        double fee;
+        qint32 id;
+        qint32 parentId;
+        qint32 ocoGroupId;
+        quint32 symbol;
+        quint8 side;
+        quint8 type;
+        quint8 status;
+        quint8 rejectReason;
+        quint8 timeInForce;
+        quint8 triggered;
+        quint8 reserved[2];
+    };
+    static_assert(sizeof(Record) == 104, "order history records must stay 104 bytes");
+
+    // Index file entry; entry i of the index file belongs to record i's
+    // block, and within a block the entries are sorted by id.
+    struct IndexEntry {
+        qint32 id;
+        qint32 offset;   // record position within its block
+    };
+    struct Block {
+        qint64 first;    // position of the block's first record
+        qint32 count;
+        qint32 minId;
+        qint32 maxId;
+    };
+
+    Record toRecord(const Order &order);
+    Order toOrder(const Record &record) const;
+    std::optional<Order> findSpilled(int orderId) const;
+    QVector<Record> readSpilled(qint64 first, qint64 count) const;
+    void spill();
+
+    int m_spillThreshold;
+    QString m_spillPath;
+    QString m_indexPath;
+    qint64 m_spilled = 0;          // records in the spill file
+    QVector<Record> m_recent;      // records after the spilled ones
+    QStringList m_symbols;
+    QHash<QString, quint32> m_symbolIds;
+    QVector<Block> m_blocks;       // one per spill, oldest first
+    QHash<qint32, int> m_recentIds;   // id -> index in m_recent
+};
@@ -0,0 +1,67 @@
+#include "orderindex.h"
+
+#include <algorithm>
+
+void OrderIndex::insert(const Order &order)
+{
+    m_bySymbol[order.symbol].insert(order.id);
+    m_bySide[sideIndex(order.side)].insert(order.id);
+    m_byStatus[static_cast<int>(order.status)].insert(order.id);
+}
+
+void OrderIndex::erase(const Order &order)
+{
+    const auto symbol = m_bySymbol.find(order.symbol);
+    if (symbol != m_bySymbol.end()) {
+        symbol->remove(order.id);
+        if (symbol->isEmpty())
+            m_bySymbol.erase(symbol);
+    }
+    m_bySide[sideIndex(order.side)].remove(order.id);
+    m_byStatus[static_cast<int>(order.status)].remove(order.id);
+}
+
+void OrderIndex::updateStatus(int orderId, OrderStatus from, OrderStatus to)
+{
+    if (from == to)
+        return;
+    m_byStatus[static_cast<int>(from)].remove(orderId);
+    m_byStatus[static_cast<int>(to)].insert(orderId);
+}
+
+QVector<int> OrderIndex::find(const OrderFilter &filter) const
+{
+    static const QSet<int> kNone;
+
+    // Walk the smallest constrained set and probe the others.
+    QVector<const QSet<int> *> sets;
+    if (!filter.symbol.isEmpty()) {
+        const auto symbol = m_bySymbol.constFind(filter.symbol);
+        sets.append(symbol != m_bySymbol.constEnd() ? &*symbol : &kNone);
+    }
+    if (filter.side)
+        sets.append(&m_bySide[sideIndex(*filter.side)]);
+    if (filter.status)
+        sets.append(&statusSet(*filter.status));
+
+    QVector<int> ids;
+    if (sets.isEmpty()) {
+        for (const QSet<int> &status : m_byStatus) {
+            for (int id : status)
+                ids.append(id);
+        }
+    } else {
+        const auto smallest = std::min_element(sets.cbegin(), sets.cend(),
+                                               [](const QSet<int> *a, const QSet<int> *b) {
+                                                   return a->size() < b->size();
+                                               });
+        for (int id : **smallest) {
+            const bool matches = std::all_of(sets.cbegin(), sets.cend(),
+                                             [id](const QSet<int> *set) { return set->contains(id); });
+            if (matches)
+                ids.append(id);
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+#include <optional>
+
+#include "models/order.h"
+
+// Unset fields match any order.
+struct OrderFilter {
+    QString symbol;
+    std::optional<OrderSide> side;
+    std::optional<OrderStatus> status;
+};
+
+/**
+ * OrderIndex: order ids by symbol, side and status.
+ *
+ * Maintained next to the order map so a query visits only the ids of its
+ * most selective field instead of every order. Symbol and side are fixed
+ * once an order is stored; status changes go through updateStatus.
+ */
+class OrderIndex {
+public:
+    void insert(const Order &order);
+    void erase(const Order &order);
+    void updateStatus(int orderId, OrderStatus from, OrderStatus to);
+
+    // Matching ids, oldest first. `filter.symbol` must already be normalised.
+    QVector<int> find(const OrderFilter &filter) const;
+
+private:
+    static int sideIndex(OrderSide side) { return side == OrderSide::Buy ? 1 : 0; }
+    const QSet<int> &statusSet(OrderStatus status) const
+    {
+        return m_byStatus[static_cast<int>(status)];
+    }
+
+    QHash<QString, QSet<int>> m_bySymbol;
+    QSet<int> m_bySide[2];
+    QSet<int> m_byStatus[OrderState::kStatusCount];
+};
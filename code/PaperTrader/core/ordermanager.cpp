@@ -2,19 +2,26 @@
 
 #include <QDateTime>
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 #include "portfoliomanager.h"
 
 OrderManager::OrderManager(QObject *parent)
-    : QObject(parent) {}
+    : QObject(parent)
+    , m_clock([] { return QDateTime::currentMSecsSinceEpoch(); })
+    , m_expiries(1000, m_clock())
+{
+}
 
-QString OrderManager::orderTypeToString(OrderType type) const
+void OrderManager::setClock(std::function<qint64()> clock)
 {
-    switch (type) {
-    case OrderType::Market: return QStringLiteral("Market");
-    case OrderType::Limit:  return QStringLiteral("Limit");
+    m_clock = clock ? std::move(clock) : [] { return QDateTime::currentMSecsSinceEpoch(); };
+    m_expiries = TimerWheel(1000, m_clock());
+    for (const Order &order : std::as_const(m_orders)) {
+        if (order.expiresAt > 0)
+            m_expiries.schedule(order.id, order.expiresAt);
     }
-    return QStringLiteral("Unknown");
 }
 
 QString OrderManager::normaliseSymbol(const QString &symbol) const
@@ -22,133 +29,535 @@ QString OrderManager::normaliseSymbol(const QString &symbol) const
     return symbol.trimmed().toUpper();
 }
 
+// Orders of one symbol share a single string buffer.
+QString OrderManager::internSymbol(const QString &symbol)
+{
+    const QString shared = m_symbols.value(symbol);
+    if (!shared.isEmpty())
+        return shared;
+    m_symbols.insert(symbol, symbol);
+    return symbol;
+}
+
 Order OrderManager::createOrder(OrderType type,
                                 const QString &symbol,
-                                const QString &side,
+                                OrderSide side,
                                 double quantity,
                                 double price)
 {
     Order order;
     order.id = m_nextId++;
-    order.symbol = normaliseSymbol(symbol);
+    order.symbol = internSymbol(normaliseSymbol(symbol));
     order.quantity = quantity;
     order.requestedQuantity = quantity;
-    order.side = side.trimmed().toUpper();
-    order.type = orderTypeToString(type);
+    order.side = side;
+    order.type = type;
     order.price = price;
-    order.status = QStringLiteral("Open");
-    order.timestamp = QDateTime::currentDateTimeUtc();
+    order.status = OrderStatus::Open;
+    order.timestamp = currentTime();
     return order;
 }
 
 OrderManager::OrderPlacementResult OrderManager::placeOrder(OrderType type,
                                                             const QString &symbol,
-                                                            const QString &side,
+                                                            OrderSide side,
                                                             double quantity,
                                                             double price)
+{
+    OrderRequest request;
+    request.type = type;
+    request.symbol = symbol;
+    request.side = side;
+    request.quantity = quantity;
+    request.price = price;
+    return placeOrder(request);
+}
+
+OrderManager::OrderPlacementResult OrderManager::rejected(const QString &symbol,
+                                                          RejectReason reason,
+                                                          double quantity)
 {
     OrderPlacementResult result;
+    result.reason = reason;
     result.rejectedQuantity = quantity;
+    result.order.symbol = symbol;
+    return result;
+}
 
-    const QString key = normaliseSymbol(symbol);
-    if (key.isEmpty()) {
-        result.errorCode = QStringLiteral("ERR_INVALID_SYMBOL");
-        emit orderRejected(symbol, result.errorCode, quantity);
+OrderManager::OrderPlacementResult OrderManager::placeOrder(const OrderRequest &request)
+{
+    return place(request, 0, 0);
+}
+
+int OrderManager::placeOco(const OrderRequest &first, const OrderRequest &second)
+{
+    const int groupId = m_nextGroupId++;
+    const OrderPlacementResult a = place(first, 0, groupId);
+    if (!a.accepted)
+        return 0;
+    // A leg that executes on arrival has already decided the pair.
+    if (a.order.filledQuantity > 0.0)
+        return groupId;
+    const OrderPlacementResult b = place(second, 0, groupId);
+    if (!b.accepted || b.order.filledQuantity > 0.0)
+        cancelOrder(a.order.id);
+    return b.accepted ? groupId : 0;
+}
+
+OrderManager::OrderPlacementResult OrderManager::placeBracket(const OrderRequest &entry,
+                                                              double takeProfit,
+                                                              double stopLoss)
+{
+    const OrderPlacementResult result = place(entry, 0, 0);
+    if (!result.accepted || (takeProfit <= 0.0 && stopLoss <= 0.0))
         return result;
+
+    m_brackets.insert(result.order.id, BracketLegs{takeProfit, stopLoss});
+    // Entries that executed on arrival get their exits straight away.
+    if (result.order.filledQuantity > 0.0)
+        releaseBracket(order(result.order.id));
+    return result;
+}
+
+void OrderManager::releaseBracket(const Order &entry)
+{
+    const auto it = m_brackets.constFind(entry.id);
+    if (it == m_brackets.constEnd())
+        return;
+    const BracketLegs legs = *it;
+    m_brackets.erase(it);
+    if (entry.filledQuantity <= 0.0)
+        return;
+
+    OrderRequest exit;
+    exit.symbol = entry.symbol;
+    exit.side = entry.side == OrderSide::Buy ? OrderSide::Sell : OrderSide::Buy;
+    exit.quantity = entry.filledQuantity;
+
+    const bool linked = legs.takeProfit > 0.0 && legs.stopLoss > 0.0;
+    const int groupId = linked ? m_nextGroupId++ : 0;
+    if (legs.takeProfit > 0.0) {
+        exit.type = OrderType::Limit;
+        exit.price = legs.takeProfit;
+        place(exit, entry.id, groupId);
+    }
+    if (legs.stopLoss > 0.0) {
+        exit.type = OrderType::Stop;
+        exit.price = 0.0;
+        exit.stopPrice = legs.stopLoss;
+        place(exit, entry.id, groupId);
     }
+}
+
+void OrderManager::leaveOcoGroup(const Order &order)
+{
+    const auto group = m_ocoGroups.find(order.ocoGroupId);
+    if (group == m_ocoGroups.end())
+        return;
+    group->removeAll(order.id);
+    if (group->size() < 2)
+        m_ocoGroups.erase(group);
+}
 
-    if (quantity <= 0.0) {
-        result.errorCode = QStringLiteral("ERR_INVALID_QTY");
-        emit orderRejected(key, result.errorCode, quantity);
+OrderManager::OrderPlacementResult OrderManager::place(const OrderRequest &request,
+                                                       int parentId,
+                                                       int ocoGroupId)
+{
+    OrderPlacementResult result = prepare(request, parentId, ocoGroupId, nullptr);
+    if (!result.accepted) {
+        emit orderRejected(result.order.symbol, result.reason, result.rejectedQuantity);
         return result;
     }
 
+    const Order &order = result.order;
+    store(order);
+    emit orderPlaced(order);
+    emit orderUpserted(order);
+    if (order.filledQuantity > 0.0)
+        emit orderFilled(order);
+    if (result.partial && result.reason != RejectReason::None)
+        emit orderRejected(order.symbol, result.reason, result.rejectedQuantity);
+    archive(order.id);
+    return result;
+}
+
+QList<OrderManager::OrderPlacementResult> OrderManager::placeOrders(std::span<const OrderRequest> requests)
+{
+    QList<OrderPlacementResult> results;
+    results.reserve(static_cast<int>(requests.size()));
+    QList<Order> placed;
+    placed.reserve(static_cast<int>(requests.size()));
+
+    // One buying-power state for the whole basket instead of a fresh
+    // portfolio scan per order.
+    PortfolioManager::ValidationBudget budget;
+    if (m_portfolio)
+        budget = m_portfolio->validationBudget();
+
+    for (const OrderRequest &request : requests) {
+        OrderPlacementResult result = prepare(request, 0, 0, m_portfolio ? &budget : nullptr);
+        if (!result.accepted) {
+            emit orderRejected(result.order.symbol, result.reason, result.rejectedQuantity);
+            results.append(result);
+            continue;
+        }
+
+        const Order &order = result.order;
+        store(order);
+        emit orderPlaced(order);
+        // Fills settle as they happen so later orders see the new positions.
+        if (order.filledQuantity > 0.0)
+            emit orderFilled(order);
+        if (result.partial && result.reason != RejectReason::None)
+            emit orderRejected(order.symbol, result.reason, result.rejectedQuantity);
+        placed.append(order);
+        results.append(result);
+    }
+
+    if (!placed.isEmpty())
+        emit ordersUpserted(placed);
+    for (const Order &order : std::as_const(placed))
+        archive(order.id);
+    return results;
+}
+
+void OrderManager::store(const Order &order)
+{
+    if (order.expiresAt > 0 && OrderState::isWorking(order.status))
+        m_expiries.schedule(order.id, order.expiresAt);
+    if (order.ocoGroupId != 0)
+        m_ocoGroups[order.ocoGroupId].append(order.id);
+    m_orders.insert(order.id, order);
+    m_index.insert(order);
+}
+
+Order *OrderManager::live(int orderId)
+{
+    return m_orders.get(orderId);
+}
+
+const Order *OrderManager::live(int orderId) const
+{
+    return m_orders.get(orderId);
+}
+
+QList<Order> OrderManager::orders() const
+{
+    QList<Order> orders;
+    orders.reserve(m_orders.size());
+    for (const Order &order : m_orders)
+        orders.append(order);
+    std::sort(orders.begin(), orders.end(),
+              [](const Order &a, const Order &b) { return a.id < b.id; });
+    return orders;
+}
+
+Order OrderManager::order(int orderId) const
+{
+    if (const Order *order = live(orderId))
+        return *order;
+    return m_history.find(orderId).value_or(Order{});
+}
+
+// Finished orders leave the live book once consumers have seen their final
+// state.
+void OrderManager::archive(int orderId)
+{
+    const Order *order = live(orderId);
+    if (!order || OrderState::isWorking(order->status))
+        return;
+    leaveOcoGroup(*order);
+    m_index.erase(*order);
+    m_history.append(*order);
+    m_orders.erase(orderId);
+    emit orderRemoved(orderId);
+}
+
+void OrderManager::setStatus(Order &order, OrderStatus status)
+{
+    m_index.updateStatus(order.id, order.status, status);
+    order.status = status;
+}
+
+QList<Order> OrderManager::orders(const OrderFilter &filter) const
+{
+    OrderFilter normalised = filter;
+    normalised.symbol = normaliseSymbol(filter.symbol);
+    QList<Order> matches;
+    for (int id : m_index.find(normalised))
+        matches.append(*live(id));
+    return matches;
+}
+
+OrderManager::OrderPlacementResult OrderManager::prepare(const OrderRequest &request,
+                                                         int parentId,
+                                                         int ocoGroupId,
+                                                         PortfolioManager::ValidationBudget *budget)
+{
+    const OrderType type = request.type;
+    const OrderSide side = request.side;
+    const double quantity = request.quantity;
+    const double price = request.price;
+
+    const QString key = normaliseSymbol(request.symbol);
+    if (key.isEmpty())
+        return rejected(request.symbol, RejectReason::InvalidSymbol, quantity);
+
+    if (quantity <= 0.0)
+        return rejected(key, RejectReason::InvalidQuantity, quantity);
+
+    // Stops need a trigger; a trailing stop's first trigger trails the last price.
+    double stopPrice = request.stopPrice;
+    if (type == OrderType::TrailingStop) {
+        const double last = m_lastPrices.value(key, 0.0);
+        if (request.trailAmount <= 0.0 || last <= 0.0)
+            return rejected(key, RejectReason::InvalidPrice, quantity);
+        stopPrice = side == OrderSide::Buy ? last + request.trailAmount
+                                           : last - request.trailAmount;
+    }
+    if (isStopType(type) && stopPrice <= 0.0)
+        return rejected(key, RejectReason::InvalidPrice, quantity);
+
     const bool isMarket = type == OrderType::Market;
+    const bool hasLimit = type == OrderType::Limit || type == OrderType::StopLimit;
+
+    // IOC and FOK execute in full against the last price or not at all, so
+    // they only make sense for orders that can execute on arrival.
+    const TimeInForce tif = request.timeInForce;
+    const bool immediate = tif == TimeInForce::IOC || tif == TimeInForce::FOK;
+    const qint64 now = currentTime();
+    qint64 expiresAt = 0;
+    if (immediate && isStopType(type))
+        return rejected(key, RejectReason::InvalidTimeInForce, quantity);
+    if (tif == TimeInForce::GTD) {
+        if (request.expiresAt <= now)
+            return rejected(key, RejectReason::InvalidTimeInForce, quantity);
+        expiresAt = request.expiresAt;
+    } else if (tif == TimeInForce::DAY) {
+        expiresAt = (now / kMsPerDay + 1) * kMsPerDay;
+    }
+
+    double executionPrice = 0.0;
+    if (immediate && !isMarket) {
+        const double last = m_lastPrices.value(key, 0.0);
+        const bool marketable = last > 0.0
+                && (side == OrderSide::Buy ? price >= last : price <= last);
+        if (!marketable)
+            return rejected(key, RejectReason::Unfillable, quantity);
+        executionPrice = last;
+    } else if (isMarket && price <= 0.0)
+        executionPrice = m_lastPrices.value(key, 0.0);   // e.g. basket rows without a price
+    const bool fillsNow = isMarket || immediate;
+
+    // Price the order is validated at: where it executes now, its limit, or
+    // the stop level it fills near.
+    const double referencePrice = executionPrice > 0.0 ? executionPrice
+                                  : isMarket || hasLimit ? price
+                                                         : stopPrice;
     PortfolioManager::OrderValidationResult validation;
 
     if (m_portfolio) {
-        validation = m_portfolio->validateOrder(isMarket, key, side, quantity, price);
-        if (!validation.accepted) {
-            result.errorCode = validation.errorCode;
-            emit orderRejected(key, validation.errorCode, quantity);
-            return result;
-        }
+        validation = budget
+                ? m_portfolio->validateOrder(isMarket, key, side, quantity, referencePrice, *budget)
+                : m_portfolio->validateOrder(isMarket, key, side, quantity, referencePrice);
+        if (!validation.accepted)
+            return rejected(key, validation.reason, quantity);
     } else {
         validation.accepted = true;
         validation.acceptedQuantity = quantity;
         validation.effectivePrice = (isMarket && price <= 0.0)
                 ? m_lastPrices.value(key, price)
-                : price;
+                : referencePrice;
     }
+    if (tif == TimeInForce::FOK && validation.partial)
+        return rejected(key, RejectReason::Unfillable, quantity);
 
     double effectivePrice = validation.effectivePrice;
     if (isMarket && effectivePrice <= 0.0) {
         effectivePrice = m_lastPrices.value(key, price);
     }
     if (!isMarket && effectivePrice <= 0.0)
-        effectivePrice = price;
+        effectivePrice = referencePrice;
 
-    Order order = createOrder(type, key, side, quantity, effectivePrice);
+    Order order = createOrder(type, key, side, quantity,
+                              isMarket ? effectivePrice : hasLimit ? price : 0.0);
     order.quantity = validation.acceptedQuantity;
-    order.errorCode = validation.errorCode;
+    order.rejectReason = validation.reason;
+    order.timeInForce = tif;
+    order.expiresAt = expiresAt;
+    order.parentId = parentId;
+    order.ocoGroupId = ocoGroupId;
+    if (isStopType(type)) {
+        order.stopPrice = stopPrice;
+        order.trailAmount = type == OrderType::TrailingStop ? request.trailAmount : 0.0;
+    }
 
-    if (isMarket) {
-        order.status = validation.partial
-                ? QStringLiteral("PartiallyFilled")
-                : QStringLiteral("Filled");
+    if (fillsNow) {
+        // An IOC remainder is cancelled rather than left working.
+        order.status = !validation.partial ? OrderStatus::Filled
+                       : tif == TimeInForce::IOC ? OrderStatus::Cancelled
+                                                 : OrderStatus::PartiallyFilled;
         order.filledPrice = effectivePrice;
         order.filledQuantity = validation.acceptedQuantity;
         order.fee = validation.fee;
     }
 
-    m_orders.insert(order.id, order);
-    emit orderPlaced(order);
-    emit ordersChanged(m_orders.values());
-
+    OrderPlacementResult result;
     result.accepted = true;
     result.partial = validation.partial;
     result.order = order;
-    result.errorCode = validation.errorCode;
+    result.reason = validation.reason;
     result.rejectedQuantity = std::max(0.0, quantity - validation.acceptedQuantity);
+    return result;
+}
 
-    if (order.status.compare(QStringLiteral("Filled"), Qt::CaseInsensitive) == 0
-            || order.status.compare(QStringLiteral("PartiallyFilled"), Qt::CaseInsensitive) == 0) {
-        emit orderFilled(order);
+bool OrderManager::cancelOrder(int orderId)
+{
+    return cancelWithReason(orderId, RejectReason::None);
+}
+
+bool OrderManager::cancelWithReason(int orderId, RejectReason reason)
+{
+    const Order *stored = live(orderId);
+    if (!stored)
+        return false;
+
+    Order order = *stored;
+    if (!OrderState::canTransition(order.status, OrderStatus::Cancelled))
+        return false;
+
+    setStatus(order, OrderStatus::Cancelled);
+    if (reason != RejectReason::None)
+        order.rejectReason = reason;
+    m_expiries.cancel(orderId);
+    leaveOcoGroup(order);
+    *live(orderId) = order;
+    emit orderCancelled(order);
+    emit orderUpserted(order);
+    // A partly filled bracket entry still protects what it bought.
+    releaseBracket(order);
+    archive(orderId);
+    return true;
+}
+
+OrderManager::OrderPlacementResult OrderManager::amendOrder(int orderId,
+                                                            double newPrice,
+                                                            double newQuantity)
+{
+    const Order *current = live(orderId);
+    const QString symbol = current ? current->symbol : QString();
+    OrderPlacementResult result;
+    if (!current || !OrderState::isWorking(current->status)
+            || current->type == OrderType::Market || current->type == OrderType::TrailingStop)
+        result = rejected(symbol, RejectReason::NotAmendable, newQuantity);
+    else if (newQuantity <= current->filledQuantity)
+        result = rejected(symbol, RejectReason::InvalidQuantity, newQuantity);
+    else if (newPrice <= 0.0)
+        result = rejected(symbol, RejectReason::InvalidPrice, newQuantity);
+    if (result.reason != RejectReason::None) {
+        emit orderRejected(symbol, result.reason, result.rejectedQuantity);
+        return result;
     }
 
-    if (validation.partial && !validation.errorCode.isEmpty()) {
-        emit orderRejected(key, validation.errorCode, result.rejectedQuantity);
+    Order amended = *current;
+    if (amended.type == OrderType::Stop)
+        amended.stopPrice = newPrice;
+    else
+        amended.price = newPrice;
+    amended.requestedQuantity = newQuantity;
+    amended.quantity = newQuantity - amended.filledQuantity;
+
+    if (m_portfolio) {
+        const auto validation = m_portfolio->validateAmend(*current, amended);
+        if (!validation.accepted) {
+            result = rejected(symbol, validation.reason, newQuantity);
+            emit orderRejected(symbol, result.reason, result.rejectedQuantity);
+            return result;
+        }
     }
 
+    *live(orderId) = amended;
+    emit orderAmended(amended);
+    emit orderUpserted(amended);
+    result.accepted = true;
+    result.order = amended;
     return result;
 }
 
-bool OrderManager::cancelOrder(int orderId)
+int OrderManager::cancelAll(const OrderFilter &filter)
 {
-    if (!m_orders.contains(orderId))
-        return false;
+    if (filter.status && !OrderState::isWorking(*filter.status))
+        return 0;
+
+    OrderFilter normalised = filter;
+    normalised.symbol = normaliseSymbol(filter.symbol);
+    QVector<int> ids;
+    for (OrderStatus status : {OrderStatus::Open, OrderStatus::PartiallyFilled}) {
+        if (filter.status && *filter.status != status)
+            continue;
+        normalised.status = status;
+        const QVector<int> matches = m_index.find(normalised);
+        for (int id : matches)
+            ids.append(id);
+    }
+    std::sort(ids.begin(), ids.end());
+
+    QList<Order> cancelled;
+    cancelled.reserve(ids.size());
+    for (int id : ids) {
+        Order &order = *live(id);
+        setStatus(order, OrderStatus::Cancelled);
+        m_expiries.cancel(id);
+        leaveOcoGroup(order);
+        cancelled.append(order);
+    }
+    if (cancelled.isEmpty())
+        return 0;
+
+    for (const Order &order : cancelled)
+        emit orderCancelled(order);
+    emit ordersUpserted(cancelled);
+    for (const Order &order : cancelled)
+        releaseBracket(order);
+    for (const Order &order : cancelled)
+        archive(order.id);
+    return static_cast<int>(cancelled.size());
+}
 
-    Order order = m_orders.value(orderId);
-    if (order.status == QStringLiteral("Filled"))
+bool OrderManager::triggerOrder(int orderId)
+{
+    Order *order = live(orderId);
+    if (!order || !order->isPendingStop())
         return false;
 
-    order.status = QStringLiteral("Cancelled");
-    m_orders.insert(orderId, order);
-    emit orderCancelled(order);
-    emit ordersChanged(m_orders.values());
+    order->triggered = true;
+    emit orderUpserted(*order);
     return true;
 }
 
+void OrderManager::moveStops(std::span<const std::pair<int, double>> levels)
+{
+    QList<Order> moved;
+    for (const auto &[orderId, level] : levels) {
+        Order *order = live(orderId);
+        if (!order || !order->isPendingStop() || order->stopPrice == level)
+            continue;
+        order->stopPrice = level;
+        moved.append(*order);
+    }
+    if (!moved.isEmpty())
+        emit ordersUpserted(moved);
+}
+
 void OrderManager::applyFill(int orderId, double price, double quantity, double fee)
 {
-    if (!m_orders.contains(orderId) || quantity <= 0.0)
+    const Order *current = live(orderId);
+    if (!current || quantity <= 0.0)
         return;
 
-    Order stored = m_orders.value(orderId);
-    if (stored.status == QStringLiteral("Cancelled")
-            || stored.status == QStringLiteral("Filled")) {
+    Order stored = *current;
+    if (!OrderState::isWorking(stored.status))
         return;
-    }
 
     const double remaining = std::max(0.0, stored.quantity);
     const double fillQty = std::min(quantity, remaining);
@@ -164,32 +573,87 @@ void OrderManager::applyFill(int orderId, double price, double quantity, double
                       / newTotalFilled;
     }
 
-    stored.quantity = remaining - fillQty;
-    if (stored.quantity <= 1e-9) {
-        stored.quantity = 0.0;
-        stored.status = QStringLiteral("Filled");
-    } else {
-        stored.status = QStringLiteral("PartiallyFilled");
-    }
+    const OrderStatus next = remaining - fillQty <= 1e-9
+            ? OrderStatus::Filled
+            : OrderStatus::PartiallyFilled;
+    if (!OrderState::canTransition(stored.status, next))
+        return;
+
+    setStatus(stored, next);
+    if (next == OrderStatus::Filled)
+        m_expiries.cancel(orderId);
+    stored.quantity = next == OrderStatus::Filled ? 0.0 : remaining - fillQty;
 
     stored.filledQuantity = newTotalFilled;
     stored.filledPrice = averageFill;
     stored.fee += fee;
 
-    m_orders.insert(orderId, stored);
-    emit ordersChanged(m_orders.values());
+    *live(orderId) = stored;
+
+    // The first fill of an OCO leg cancels its siblings in the same batch.
+    QList<Order> cancelled;
+    const auto group = m_ocoGroups.constFind(stored.ocoGroupId);
+    if (group != m_ocoGroups.constEnd()) {
+        for (int siblingId : *group) {
+            if (siblingId == orderId)
+                continue;
+            Order *sibling = live(siblingId);
+            if (!sibling
+                    || !OrderState::canTransition(sibling->status, OrderStatus::Cancelled))
+                continue;
+            setStatus(*sibling, OrderStatus::Cancelled);
+            m_expiries.cancel(siblingId);
+            cancelled.append(*sibling);
+        }
+        m_ocoGroups.erase(group);
+    }
+
+    if (cancelled.isEmpty()) {
+        emit orderUpserted(stored);
+    } else {
+        QList<Order> batch;
+        batch.reserve(cancelled.size() + 1);
+        batch.append(stored);
+        for (const Order &order : cancelled) {
+            emit orderCancelled(order);
+            batch.append(order);
+        }
+        emit ordersUpserted(batch);
+    }
 
     Order fillEvent = stored;
+    fillEvent.timestamp = currentTime();
     fillEvent.filledQuantity = fillQty;
     fillEvent.filledPrice = price;
     fillEvent.fee = fee;
 
     emit orderFilled(fillEvent);
+
+    if (next == OrderStatus::Filled)
+        releaseBracket(stored);
+    archive(orderId);
+    for (const Order &order : cancelled)
+        archive(order.id);
+}
+
+void OrderManager::advanceClock(qint64 nowMs)
+{
+    std::vector<int> expired;
+    m_expiries.advance(nowMs, expired);
+    for (int orderId : expired)
+        cancelWithReason(orderId, RejectReason::Expired);
+}
+
+qint64 OrderManager::currentTime() const
+{
+    return std::max(m_clock(), m_expiries.now());
 }
 
 void OrderManager::setLastPrice(const QString &symbol, double price)
 {
-    m_lastPrices.insert(normaliseSymbol(symbol), price);
+    const QString key = normaliseSymbol(symbol);
+    m_lastPrices.insert(key, price);
+    emit lastPriceChanged(key, price);
 }
 
 void OrderManager::setPortfolioManager(PortfolioManager *manager)
@@ -1,22 +1,28 @@
 #pragma once
 #include <QObject>
-#include <QMap>
 #include <QList>
 #include <QHash>
+#include <QVector>
+#include <functional>
+#include <span>
+#include <utility>
 #include "models/order.h"
-
-class PortfolioManager;
+#include "orderhistory.h"
+#include "orderindex.h"
+#include "portfoliomanager.h"
+#include "densemap.h"
+#include "timerwheel.h"
 
 class OrderManager : public QObject {
     Q_OBJECT
 public:
-    enum class OrderType { Market, Limit };
+    using OrderType = ::OrderType;
 
     struct OrderPlacementResult {
         bool accepted = false;
         bool partial = false;
         Order order;
-        QString errorCode;
+        RejectReason reason = RejectReason::None;
         double rejectedQuantity = 0.0;
     };
 
@@ -24,37 +30,126 @@ public:
 
     Order createOrder(OrderType type,
                       const QString &symbol,
-                      const QString &side,
+                      OrderSide side,
                       double quantity,
                       double price = 0.0);
 
     OrderPlacementResult placeOrder(OrderType type,
                                     const QString &symbol,
-                                    const QString &side,
+                                    OrderSide side,
                                     double quantity,
                                     double price = 0.0);
+    OrderPlacementResult placeOrder(const OrderRequest &request);
+    // Places a basket: one validation pass against a running buying-power
+    // state and a single ordersUpserted for everything accepted. Results
+    // follow the request order.
+    QList<OrderPlacementResult> placeOrders(std::span<const OrderRequest> requests);
+
+    // Places two orders where the first fill of either cancels the other.
+    // If the first executes on arrival the second is not placed; if the
+    // second does, the first is cancelled. Returns the group id, or 0 if a
+    // leg was rejected (the other is then cancelled).
+    int placeOco(const OrderRequest &first, const OrderRequest &second);
+    // Places `entry`; once it fills, a take-profit limit and a stop-loss stop
+    // for the filled quantity are placed as an OCO pair. A price of 0 skips
+    // that leg.
+    OrderPlacementResult placeBracket(const OrderRequest &entry, double takeProfit, double stopLoss);
 
     bool cancelOrder(int orderId);
+    // Cancels every working order matching `filter` in one pass and
+    // announces them in a single ordersUpserted. Returns how many.
+    int cancelAll(const OrderFilter &filter = {});
+    // Changes a working order's price and total quantity in place: same id,
+    // one orderUpserted, and only the change in reserved margin is checked.
+    // The price is the limit for limit and stop-limit orders and the trigger
+    // for stops; trailing stops cannot be amended. `newQuantity` includes
+    // anything already filled.
+    OrderPlacementResult amendOrder(int orderId, double newPrice, double newQuantity);
     void applyFill(int orderId, double price, double quantity, double fee = 0.0);
+    // Marks a stop order as triggered: a stop-limit starts resting at its
+    // limit price, the other stop types are filled by the caller.
+    bool triggerOrder(int orderId);
+    // Publishes trailing stops' current levels (order id, stop price) as
+    // their stopPrice, in one ordersUpserted batch.
+    void moveStops(std::span<const std::pair<int, double>> levels);
 
-    QList<Order> orders() const { return m_orders.values(); }
+    // Working orders only: once an order is filled, cancelled or rejected it
+    // is announced with its final state, moved to the history and reported
+    // through orderRemoved. Full snapshot for initial sync only; follow
+    // changes via orderUpserted and orderRemoved.
+    QList<Order> orders() const;
+    // Live order, else the archived one, else a default Order.
+    Order order(int orderId) const;
+    const OrderHistory &history() const { return m_history; }
+    void setHistorySpillPath(const QString &path) { m_history.setSpillPath(path); }
+    // Indexed lookup, oldest first.
+    QList<Order> orders(const OrderFilter &filter) const;
 
     void setLastPrice(const QString &symbol, double price);
+    // GTD/DAY orders waiting for their deadline.
+    int pendingExpiryCount() const { return m_expiries.size(); }
+    // Member ids of a live OCO group, oldest first.
+    QVector<int> ocoGroup(int groupId) const { return m_ocoGroups.value(groupId); }
     void setPortfolioManager(PortfolioManager *manager);
+    // Time source for deadlines and timestamps, in ms since the epoch; wall
+    // time by default. Restarts the expiry wheel, so set it before placing
+    // GTD/DAY orders.
+    void setClock(std::function<qint64()> clock);
+    // Now on that clock; never behind the expiry wheel.
+    qint64 currentTime() const;
+
+public slots:
+    // Cancels the GTD/DAY orders whose deadline is at or before `nowMs`.
+    void advanceClock(qint64 nowMs);
 
 signals:
-    void ordersChanged(const QList<Order> &orders);
+    // One order was added or changed; carries its full current state.
+    void orderUpserted(const Order &order);
+    // Several orders changed as one operation; each appears once.
+    void ordersUpserted(const QList<Order> &orders);
+    void orderRemoved(int orderId);
     void orderPlaced(const Order &order);
     void orderCancelled(const Order &order);
+    void orderAmended(const Order &order);
     void orderFilled(const Order &order);
-    void orderRejected(const QString &symbol, const QString &errorCode, double rejectedQuantity);
+    void orderRejected(const QString &symbol, RejectReason reason, double rejectedQuantity);
+    void lastPriceChanged(const QString &symbol, double price);
 
 private:
-    QString orderTypeToString(OrderType type) const;
     QString normaliseSymbol(const QString &symbol) const;
+    QString internSymbol(const QString &symbol);
+    struct BracketLegs {
+        double takeProfit = 0.0;
+        double stopLoss = 0.0;
+    };
+
+    OrderPlacementResult place(const OrderRequest &request, int parentId, int ocoGroupId);
+    // Validates and builds an order without storing or announcing it.
+    OrderPlacementResult prepare(const OrderRequest &request, int parentId, int ocoGroupId,
+                                 PortfolioManager::ValidationBudget *budget);
+    void store(const Order &order);
+    void setStatus(Order &order, OrderStatus status);
+    void archive(int orderId);
+    Order *live(int orderId);
+    const Order *live(int orderId) const;
+    static OrderPlacementResult rejected(const QString &symbol, RejectReason reason, double quantity);
+    void releaseBracket(const Order &entry);
+    void leaveOcoGroup(const Order &order);
+    bool cancelWithReason(int orderId, RejectReason reason);
+
+    static constexpr qint64 kMsPerDay = 24 * 60 * 60 * 1000;
 
     int m_nextId = 1;
-    QMap<int, Order> m_orders;
+    // Working orders in one dense vector, found by id through a hash.
+    DenseMap<int, Order> m_orders;
+    QHash<QString, QString> m_symbols;   // interned order symbols
+    OrderIndex m_index;
+    OrderHistory m_history;
     QHash<QString, double> m_lastPrices;
     PortfolioManager *m_portfolio = nullptr;
+    std::function<qint64()> m_clock;
+    TimerWheel m_expiries;
+    int m_nextGroupId = 1;
+    QHash<int, QVector<int>> m_ocoGroups;   // group id -> working member ids
+    QHash<int, BracketLegs> m_brackets;     // unfilled entry id -> exit legs
 };
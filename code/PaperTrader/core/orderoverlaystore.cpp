@@ -0,0 +1,206 @@
+#include "orderoverlaystore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace {
+QString symbolKey(const QString &symbol)
+{
+    return symbol.trimmed().toUpper();
+}
+}
+
+OrderOverlayStore::OrderOverlayStore(QObject *parent)
+    : QObject(parent)
+{
+}
+
+const OrderOverlayStore::SymbolOverlays *OrderOverlayStore::find(const QString &symbol) const
+{
+    const auto it = m_symbols.find(symbolKey(symbol));
+    return it != m_symbols.end() ? it->second.get() : nullptr;
+}
+
+OrderOverlayStore::SymbolOverlays &OrderOverlayStore::ensure(const QString &symbol)
+{
+    std::unique_ptr<SymbolOverlays> &slot = m_symbols[symbolKey(symbol)];
+    if (!slot)
+        slot = std::make_unique<SymbolOverlays>();
+    return *slot;
+}
+
+bool OrderOverlayStore::eraseLimit(int orderId)
+{
+    const auto handle = m_limitById.constFind(orderId);
+    if (handle == m_limitById.constEnd())
+        return false;
+    ensure(handle->symbol).limits.erase(handle->it);
+    m_limitById.erase(handle);
+    return true;
+}
+
+void OrderOverlayStore::upsertOrder(const Order &order)
+{
+    if (applyUpsert(order))
+        emit overlaysChanged(symbolKey(order.symbol));
+}
+
+void OrderOverlayStore::upsertOrders(const QList<Order> &orders)
+{
+    QSet<QString> touched;
+    for (const Order &order : orders) {
+        if (applyUpsert(order))
+            touched.insert(symbolKey(order.symbol));
+    }
+    for (const QString &symbol : touched)
+        emit overlaysChanged(symbol);
+}
+
+bool OrderOverlayStore::applyUpsert(const Order &order)
+{
+    const bool removed = eraseLimit(order.id);
+    if (!order.isRestingLimit())
+        return removed;
+
+    LimitOverlay line;
+    line.orderId = order.id;
+    line.price = order.price;
+    line.quantity = order.quantity;
+    line.buy = order.side == OrderSide::Buy;
+
+    const QString key = symbolKey(order.symbol);
+    auto it = ensure(key).limits.emplace(line.price, line);
+    m_limitById.insert(order.id, LimitHandle{key, it});
+    return true;
+}
+
+void OrderOverlayStore::removeOrder(int orderId)
+{
+    const auto handle = m_limitById.constFind(orderId);
+    if (handle == m_limitById.constEnd())
+        return;
+    const QString key = handle->symbol;
+    eraseLimit(orderId);
+    emit overlaysChanged(key);
+}
+
+void OrderOverlayStore::setOrders(const QList<Order> &orders)
+{
+    for (auto &entry : m_symbols)
+        entry.second->limits.clear();
+    m_limitById.clear();
+
+    for (const Order &order : orders) {
+        if (!order.isRestingLimit())
+            continue;
+        LimitOverlay line;
+        line.orderId = order.id;
+        line.price = order.price;
+        line.quantity = order.quantity;
+        line.buy = order.side == OrderSide::Buy;
+        const QString key = symbolKey(order.symbol);
+        auto it = ensure(key).limits.emplace(line.price, line);
+        m_limitById.insert(order.id, LimitHandle{key, it});
+    }
+    emit overlaysChanged(QString());
+}
+
+void OrderOverlayStore::addFill(const Order &fill)
+{
+    if (fill.filledQuantity <= 0.0)
+        return;
+
+    FillOverlay marker;
+    marker.orderId = fill.id;
+    marker.timeMs = fill.timestamp;
+    marker.price = fill.filledPrice;
+    marker.quantity = fill.filledQuantity;
+    marker.buy = fill.side == OrderSide::Buy;
+
+    const QString key = symbolKey(fill.symbol);
+    FillIndex &fills = ensure(key).fills;
+    if (fills.empty() || fills.back().timeMs <= marker.timeMs) {
+        fills.push_back(marker);
+    } else {
+        const auto pos = std::upper_bound(fills.begin(), fills.end(), marker.timeMs,
+                                          [](qint64 ms, const FillOverlay &f) { return ms < f.timeMs; });
+        fills.insert(pos, marker);
+    }
+    emit overlaysChanged(key);
+}
+
+void OrderOverlayStore::clear()
+{
+    m_symbols.clear();
+    m_limitById.clear();
+    emit overlaysChanged(QString());
+}
+
+std::pair<OrderOverlayStore::LimitIndex::const_iterator, OrderOverlayStore::LimitIndex::const_iterator>
+OrderOverlayStore::limitsInRange(const QString &symbol, double lowPrice, double highPrice) const
+{
+    static const LimitIndex empty;
+    const SymbolOverlays *overlays = find(symbol);
+    if (!overlays || lowPrice > highPrice)
+        return {empty.end(), empty.end()};
+    return {overlays->limits.lower_bound(lowPrice), overlays->limits.upper_bound(highPrice)};
+}
+
+std::pair<OrderOverlayStore::FillIndex::const_iterator, OrderOverlayStore::FillIndex::const_iterator>
+OrderOverlayStore::fillsInRange(const QString &symbol, qint64 fromMs, qint64 toMs) const
+{
+    static const FillIndex empty;
+    const SymbolOverlays *overlays = find(symbol);
+    if (!overlays || fromMs >= toMs)
+        return {empty.end(), empty.end()};
+    const auto byTime = [](const FillOverlay &f, qint64 ms) { return f.timeMs < ms; };
+    const FillIndex &fills = overlays->fills;
+    return {std::lower_bound(fills.begin(), fills.end(), fromMs, byTime),
+            std::lower_bound(fills.begin(), fills.end(), toMs, byTime)};
+}
+
+const LimitOverlay *OrderOverlayStore::limitNear(const QString &symbol, double price, double tolerance) const
+{
+    const SymbolOverlays *overlays = find(symbol);
+    if (!overlays || overlays->limits.empty())
+        return nullptr;
+
+    // The closest line is either the first at/above the price or the one below it.
+    const LimitIndex &limits = overlays->limits;
+    const auto above = limits.lower_bound(price);
+    const LimitOverlay *best = nullptr;
+    if (above != limits.end())
+        best = &above->second;
+    if (above != limits.begin()) {
+        const LimitOverlay &below = std::prev(above)->second;
+        if (!best || price - below.price < best->price - price)
+            best = &below;
+    }
+    return (best && std::fabs(best->price - price) <= tolerance) ? best : nullptr;
+}
+
+const FillOverlay *OrderOverlayStore::fillNear(const QString &symbol, qint64 fromMs, qint64 toMs,
+                                               double price, double tolerance) const
+{
+    const auto range = fillsInRange(symbol, fromMs, toMs);
+    const FillOverlay *best = nullptr;
+    for (auto it = range.first; it != range.second; ++it) {
+        const double distance = std::fabs(it->price - price);
+        if (distance <= tolerance && (!best || distance < std::fabs(best->price - price)))
+            best = &*it;
+    }
+    return best;
+}
+
+int OrderOverlayStore::limitCount(const QString &symbol) const
+{
+    const SymbolOverlays *overlays = find(symbol);
+    return overlays ? static_cast<int>(overlays->limits.size()) : 0;
+}
+
+int OrderOverlayStore::fillCount(const QString &symbol) const
+{
+    const SymbolOverlays *overlays = find(symbol);
+    return overlays ? static_cast<int>(overlays->fills.size()) : 0;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QObject>
+#include <QString>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "models/order.h"
+
+// A resting limit order drawn as a horizontal price line.
+struct LimitOverlay {
+    int orderId = 0;
+    double price = 0.0;
+    double quantity = 0.0;
+    bool buy = true;
+};
+
+// One execution drawn as a marker at (time, price).
+struct FillOverlay {
+    int orderId = 0;
+    qint64 timeMs = 0;   // msecs since epoch (UTC)
+    double price = 0.0;
+    double quantity = 0.0;
+    bool buy = true;
+};
+
+/**
+ * OrderOverlayStore: per-symbol order annotations for the chart.
+ *
+ * Open limit orders are kept sorted by price and fills by time, so a frame
+ * visits only the overlays inside the visible price/time window and hover
+ * hit-tests are a binary search rather than a scan.
+ */
+class OrderOverlayStore : public QObject {
+    Q_OBJECT
+public:
+    using LimitIndex = std::multimap<double, LimitOverlay>;
+    using FillIndex = std::vector<FillOverlay>;
+
+    explicit OrderOverlayStore(QObject *parent = nullptr);
+
+    // Open limit orders get (or move) a price line; anything else drops it.
+    void upsertOrder(const Order &order);
+    // Batch form: one overlaysChanged per touched symbol.
+    void upsertOrders(const QList<Order> &orders);
+    void removeOrder(int orderId);
+    // Replaces every limit line from a full order list.
+    void setOrders(const QList<Order> &orders);
+    // Fills usually arrive in time order and append; late ones are inserted.
+    void addFill(const Order &fill);
+    void clear();
+
+    // Limit lines with lowPrice <= price <= highPrice, in price order.
+    std::pair<LimitIndex::const_iterator, LimitIndex::const_iterator>
+    limitsInRange(const QString &symbol, double lowPrice, double highPrice) const;
+    // Fills with fromMs <= time < toMs, in time order.
+    std::pair<FillIndex::const_iterator, FillIndex::const_iterator>
+    fillsInRange(const QString &symbol, qint64 fromMs, qint64 toMs) const;
+
+    // Nearest overlay within the tolerance, or nullptr. A chart hit-tests a
+    // fill against the time span of the bar under the cursor.
+    const LimitOverlay *limitNear(const QString &symbol, double price, double tolerance) const;
+    const FillOverlay *fillNear(const QString &symbol, qint64 fromMs, qint64 toMs,
+                                double price, double tolerance) const;
+
+    int limitCount(const QString &symbol) const;
+    int fillCount(const QString &symbol) const;
+
+signals:
+    void overlaysChanged(const QString &symbol);
+
+private:
+    struct SymbolOverlays {
+        LimitIndex limits;
+        FillIndex fills;
+    };
+
+    const SymbolOverlays *find(const QString &symbol) const;
+    SymbolOverlays &ensure(const QString &symbol);
+    bool eraseLimit(int orderId);
+    // Returns whether the symbol's limit lines changed.
+    bool applyUpsert(const Order &order);
+
+    std::map<QString, std::unique_ptr<SymbolOverlays>> m_symbols;
+    // Order id -> symbol and position in its price index, for O(log n) moves.
+    struct LimitHandle {
+        QString symbol;
+        LimitIndex::iterator it;
+    };
+    QHash<int, LimitHandle> m_limitById;
+};
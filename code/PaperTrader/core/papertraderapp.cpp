@@ -27,11 +27,24 @@ PaperTraderApp::PaperTraderApp(QObject *parent)
                      m_portfolioManager, &PortfolioManager::onCandle);
     QObject::connect(m_dataProvider, &MarketDataProvider::newCandle,
                      m_executionSimulator, &ExecutionSimulator::onCandle);
+    QObject::connect(m_chartManager, &ChartManager::quoteUpdated,
+                     m_executionSimulator, &ExecutionSimulator::onQuote);
 
     QObject::connect(m_orderManager, &OrderManager::orderFilled,
                      m_portfolioManager, &PortfolioManager::applyFill);
-    QObject::connect(m_orderManager, &OrderManager::ordersChanged,
-                     m_portfolioManager, &PortfolioManager::onOrdersUpdated);
+    QObject::connect(m_orderManager, &OrderManager::orderUpserted,
+                     m_portfolioManager, &PortfolioManager::onOrderUpserted);
+    QObject::connect(m_orderManager, &OrderManager::ordersUpserted,
+                     m_portfolioManager, &PortfolioManager::onOrdersUpserted);
+    QObject::connect(m_orderManager, &OrderManager::orderRemoved,
+                     m_portfolioManager, &PortfolioManager::onOrderRemoved);
+    m_orderManager->setHistorySpillPath(m_storageManager->orderHistoryPath());
+
+    m_orderClock.setInterval(1000);
+    QObject::connect(&m_orderClock, &QTimer::timeout, m_orderManager, [this]() {
+        m_orderManager->advanceClock(m_orderManager->currentTime());
+    });
+    m_orderClock.start();
 }
 
 void PaperTraderApp::start() {
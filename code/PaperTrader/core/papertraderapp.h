@@ -1,6 +1,7 @@
 #pragma once
 #include <QObject>
 #include <QLoggingCategory>
+#include <QTimer>
 #include "marketdataprovider.h"
 #include "chartmanager.h"
 #include "ordermanager.h"
@@ -26,6 +27,7 @@ public:
     OrderManager       *orderManager() const { return m_orderManager; }
     PortfolioManager   *portfolioManager() const { return m_portfolioManager; }
     StorageManager     *storageManager() const { return m_storageManager; }
+    ExecutionSimulator *executionSimulator() const { return m_executionSimulator; }
 
 private:
     MarketDataProvider *m_dataProvider = nullptr;
@@ -34,4 +36,5 @@ private:
     PortfolioManager   *m_portfolioManager = nullptr;
     StorageManager     *m_storageManager = nullptr;
     ExecutionSimulator *m_executionSimulator = nullptr;
+    QTimer m_orderClock;   // drives GTD/DAY expirations
 };
@@ -3,6 +3,7 @@
 #include <QtGlobal>
 #include <cmath>
 #include <algorithm>
+#include <utility>
 
 PortfolioManager::PortfolioManager(QObject *parent)
     : QObject(parent) {}
@@ -44,40 +45,77 @@ PortfolioSnapshot PortfolioManager::snapshot() const
     return snap;
 }
 
+PortfolioManager::OrderValidationResult PortfolioManager::validateAmend(const Order &current,
+                                                                      const Order &amended) const
+{
+    OrderValidationResult result;
+    const auto symbol = m_openOrderSymbols.constFind(current.id);
+    const double reserved = symbol != m_openOrderSymbols.constEnd()
+            ? m_openOrders.value(*symbol).value(current.id).margin
+            : 0.0;
+    const double extra = marginForOrder(amended) - reserved;
+    if (extra > availableFundsInternal()) {
+        result.reason = amended.side == OrderSide::Buy ? RejectReason::InsufficientFunds
+                                                       : RejectReason::InsufficientMargin;
+        return result;
+    }
+
+    result.accepted = true;
+    result.acceptedQuantity = amended.quantity;
+    result.effectivePrice = amended.price > 0.0 ? amended.price : amended.stopPrice;
+    return result;
+}
+
 double PortfolioManager::estimateFee(double price, double quantity) const
 {
     return std::abs(price * quantity) * m_feeRate;
 }
 
+PortfolioManager::ValidationBudget PortfolioManager::validationBudget() const
+{
+    ValidationBudget budget;
+    budget.cash = m_cash;
+    budget.available = availableFundsInternal();
+    return budget;
+}
+
 PortfolioManager::OrderValidationResult PortfolioManager::validateOrder(
     bool isMarket,
     const QString &symbol,
-    const QString &side,
+    OrderSide side,
     double quantity,
     double price) const
+{
+    ValidationBudget budget = validationBudget();
+    return validateOrder(isMarket, symbol, side, quantity, price, budget);
+}
+
+PortfolioManager::OrderValidationResult PortfolioManager::validateOrder(
+    bool isMarket,
+    const QString &symbol,
+    OrderSide side,
+    double quantity,
+    double price,
+    ValidationBudget &budget) const
 {
     OrderValidationResult result;
     const QString normalisedSymbol = symbol.trimmed().toUpper();
     if (normalisedSymbol.isEmpty()) {
-        result.errorCode = QStringLiteral("ERR_INVALID_SYMBOL");
+        result.reason = RejectReason::InvalidSymbol;
         return result;
     }
 
     if (quantity <= 0.0) {
-        result.errorCode = QStringLiteral("ERR_INVALID_QTY");
+        result.reason = RejectReason::InvalidQuantity;
         return result;
     }
 
-    const bool isBuy = side.compare(QStringLiteral("BUY"), Qt::CaseInsensitive) == 0;
-    const bool isSell = side.compare(QStringLiteral("SELL"), Qt::CaseInsensitive) == 0;
-    if (!isBuy && !isSell) {
-        result.errorCode = QStringLiteral("ERR_INVALID_SIDE");
-        return result;
-    }
+    const bool isBuy = side == OrderSide::Buy;
+    const bool isSell = side == OrderSide::Sell;
 
     double effectivePrice = price;
     if (!isMarket && effectivePrice <= 0.0) {
-        result.errorCode = QStringLiteral("ERR_INVALID_PRICE");
+        result.reason = RejectReason::InvalidPrice;
         return result;
     }
 
@@ -86,7 +124,7 @@ PortfolioManager::OrderValidationResult PortfolioManager::validateOrder(
     }
 
     if (effectivePrice <= 0.0) {
-        result.errorCode = QStringLiteral("ERR_INVALID_PRICE");
+        result.reason = RejectReason::InvalidPrice;
         return result;
     }
 
@@ -111,14 +149,14 @@ PortfolioManager::OrderValidationResult PortfolioManager::validateOrder(
     const double openingFee = estimateFee(effectivePrice, openingQty);
     const double totalFee = closingFee + openingFee;
 
-    if (m_cash < totalFee) {
-        result.errorCode = QStringLiteral("ERR_INSUFFICIENT_FUNDS");
+    if (budget.cash < totalFee) {
+        result.reason = RejectReason::InsufficientFunds;
         return result;
     }
 
     // Available funds = cash - margin - reserved order margin. When closing we
     // simulate releasing resources before validating any new exposure.
-    double available = availableFundsInternal();
+    double available = budget.available;
 
     if (closingQty > 0.0) {
         if (isBuy) {
@@ -137,7 +175,7 @@ PortfolioManager::OrderValidationResult PortfolioManager::validateOrder(
     }
 
     double acceptedOpening = 0.0;
-    QString openingError;
+    RejectReason openingError = RejectReason::None;
 
     if (openingQty > 0.0) {
         if (isBuy) {
@@ -149,9 +187,9 @@ PortfolioManager::OrderValidationResult PortfolioManager::validateOrder(
                 const double maxQty = available / perUnitCost;
                 if (maxQty > 0.0) {
                     acceptedOpening = std::min(openingQty, maxQty);
-                    openingError = QStringLiteral("ERR_PARTIAL_FILL");
+                    openingError = RejectReason::PartialFill;
                 } else {
-                    openingError = QStringLiteral("ERR_INSUFFICIENT_FUNDS");
+                    openingError = RejectReason::InsufficientFunds;
                 }
             }
         } else {
@@ -165,9 +203,9 @@ PortfolioManager::OrderValidationResult PortfolioManager::validateOrder(
                                           : 0.0;
                 if (maxQty > 0.0) {
                     acceptedOpening = std::min(openingQty, maxQty);
-                    openingError = QStringLiteral("ERR_PARTIAL_FILL");
+                    openingError = RejectReason::PartialFill;
                 } else {
-                    openingError = QStringLiteral("ERR_INSUFFICIENT_MARGIN");
+                    openingError = RejectReason::InsufficientMargin;
                 }
             }
         }
@@ -177,17 +215,22 @@ PortfolioManager::OrderValidationResult PortfolioManager::validateOrder(
     result.partial = std::abs(result.acceptedQuantity - quantity) > 1e-9;
 
     if (result.acceptedQuantity <= 0.0) {
-        result.errorCode = openingError.isEmpty()
-        ? QStringLiteral("ERR_INSUFFICIENT_FUNDS")
+        result.reason = openingError == RejectReason::None
+        ? RejectReason::InsufficientFunds
         : openingError;
         return result;
     }
 
     result.accepted = true;
-    if (!openingError.isEmpty()) {
-        result.errorCode = openingError;
-    }
+    result.reason = openingError;
     result.fee = estimateFee(effectivePrice, result.acceptedQuantity);
+
+    // Later orders of a basket see this one's exposure and fee as spent.
+    // Funds a closing trade would release are not credited back.
+    const double committed = isBuy ? acceptedOpening * effectivePrice
+                                   : acceptedOpening * effectivePrice * m_shortMarginRate;
+    budget.available = std::max(0.0, budget.available - committed - result.fee);
+    budget.cash -= result.fee;
     return result;
 }
 
@@ -227,7 +270,7 @@ void PortfolioManager::applyFill(const Order &order)
     Position pos = m_positions.value(symbol);
     pos.symbol = symbol;
 
-    const bool isBuy = order.side.compare("BUY", Qt::CaseInsensitive) == 0;
+    const bool isBuy = order.side == OrderSide::Buy;
     double price = order.filledPrice > 0.0
                        ? order.filledPrice
                        : m_lastPrices.value(symbol, order.price);
@@ -329,19 +372,93 @@ void PortfolioManager::applyFill(const Order &order)
     }
 
     recordOrUpdatePosition(symbol, pos);
+    refreshOrderMargins(symbol);
 
     emitSnapshot();
 }
 
+bool PortfolioManager::isOpenOrder(const Order &order)
+{
+    return OrderState::isWorking(order.status) && order.quantity > 0.0;
+}
+
+void PortfolioManager::insertOpenOrder(const Order &order)
+{
+    const QString symbol = order.symbol.toUpper();
+    OpenOrder open;
+    open.order = order;
+    open.margin = marginForOrder(order);
+    m_openOrders[symbol].insert(order.id, open);
+    m_openOrderSymbols.insert(order.id, symbol);
+    m_orderMargin += open.margin;
+}
+
+bool PortfolioManager::dropOpenOrder(int orderId)
+{
+    const auto symbol = m_openOrderSymbols.constFind(orderId);
+    if (symbol == m_openOrderSymbols.constEnd())
+        return false;
+
+    auto bySymbol = m_openOrders.find(*symbol);
+    m_orderMargin -= bySymbol->value(orderId).margin;
+    bySymbol->remove(orderId);
+    if (bySymbol->isEmpty())
+        m_openOrders.erase(bySymbol);
+    m_openOrderSymbols.erase(symbol);
+    // Snap back to zero so add/subtract rounding cannot leave a residue.
+    if (m_openOrderSymbols.isEmpty())
+        m_orderMargin = 0.0;
+    return true;
+}
+
+bool PortfolioManager::upsertOpenOrder(const Order &order)
+{
+    const bool isOpen = isOpenOrder(order);
+    const auto symbol = m_openOrderSymbols.constFind(order.id);
+    if (isOpen && symbol != m_openOrderSymbols.constEnd() && *symbol == order.symbol.toUpper()) {
+        // Still open (partly filled or amended): adjust by the margin delta.
+        OpenOrder &open = m_openOrders[*symbol][order.id];
+        const double margin = marginForOrder(order);
+        m_orderMargin += margin - open.margin;
+        open.order = order;
+        open.margin = margin;
+        return true;
+    }
+
+    const bool wasOpen = dropOpenOrder(order.id);
+    if (isOpen)
+        insertOpenOrder(order);
+    return wasOpen || isOpen;
+}
+
+void PortfolioManager::onOrderUpserted(const Order &order)
+{
+    if (upsertOpenOrder(order))
+        emitSnapshot();
+}
+
+void PortfolioManager::onOrdersUpserted(const QList<Order> &orders)
+{
+    bool changed = false;
+    for (const Order &order : orders)
+        changed = upsertOpenOrder(order) || changed;
+    if (changed)
+        emitSnapshot();
+}
+
+void PortfolioManager::onOrderRemoved(int orderId)
+{
+    if (dropOpenOrder(orderId))
+        emitSnapshot();
+}
+
 void PortfolioManager::onOrdersUpdated(const QList<Order> &orders)
 {
     m_openOrders.clear();
+    m_openOrderSymbols.clear();
     for (const Order &order : orders) {
-        const bool isOpen = order.status.compare(QStringLiteral("Open"), Qt::CaseInsensitive) == 0;
-        const bool isPartial = order.status.compare(QStringLiteral("PartiallyFilled"), Qt::CaseInsensitive) == 0;
-        if ((isOpen || isPartial) && order.quantity > 0.0) {
-            m_openOrders.append(order);
-        }
+        if (isOpenOrder(order))
+            insertOpenOrder(order);
     }
     // Pending orders reserve margin so that available funds reflect true buying power.
     recomputeOrderMargin();
@@ -363,6 +480,7 @@ void PortfolioManager::updateUnrealizedFor(const QString &symbol)
         pos.unrealizedPnL = 0.0;
     }
     m_positions.insert(symbol, pos);
+    emit positionChanged(pos);
 }
 
 double PortfolioManager::marginForPosition(const Position &position) const
@@ -381,14 +499,15 @@ double PortfolioManager::marginForPosition(const Position &position) const
 double PortfolioManager::marginForOrder(const Order &order) const
 {
     const QString symbol = order.symbol.toUpper();
-    const double price = order.price > 0.0
-                             ? order.price
-                             : m_lastPrices.value(symbol, 0.0);
+    // Untriggered stops reserve at their trigger level.
+    double price = order.price > 0.0 ? order.price : order.stopPrice;
+    if (price <= 0.0)
+        price = m_lastPrices.value(symbol, 0.0);
     return marginForOrder(symbol, order.side, order.quantity, price);
 }
 
 double PortfolioManager::marginForOrder(const QString &symbol,
-                                        const QString &side,
+                                        OrderSide side,
                                         double quantity,
                                         double price) const
 {
@@ -399,8 +518,7 @@ double PortfolioManager::marginForOrder(const QString &symbol,
     if (openingQty <= 0.0)
         return 0.0;
 
-    const bool isBuy = side.compare(QStringLiteral("BUY"), Qt::CaseInsensitive) == 0;
-    if (isBuy) {
+    if (side == OrderSide::Buy) {
         const double perUnitCost = price * (1.0 + m_feeRate);
         return openingQty * perUnitCost;
     }
@@ -410,14 +528,14 @@ double PortfolioManager::marginForOrder(const QString &symbol,
 }
 
 double PortfolioManager::openingQuantityForOrder(const QString &symbol,
-                                                 const QString &side,
+                                                 OrderSide side,
                                                  double quantity) const
 {
     const Position pos = m_positions.value(symbol.toUpper());
     if (quantity <= 0.0)
         return 0.0;
 
-    if (side.compare(QStringLiteral("BUY"), Qt::CaseInsensitive) == 0) {
+    if (side == OrderSide::Buy) {
         if (pos.qty < 0.0) {
             const double closing = std::min(quantity, std::abs(pos.qty));
             return quantity - closing;
@@ -442,11 +560,25 @@ double PortfolioManager::availableFundsInternal() const
     return available > 0.0 ? available : 0.0;
 }
 
+void PortfolioManager::refreshOrderMargins(const QString &symbol)
+{
+    // An order's reservation depends on the position it would open against.
+    const auto bySymbol = m_openOrders.find(symbol);
+    if (bySymbol == m_openOrders.end())
+        return;
+    for (OpenOrder &open : *bySymbol) {
+        const double margin = marginForOrder(open.order);
+        m_orderMargin += margin - open.margin;
+        open.margin = margin;
+    }
+}
+
 void PortfolioManager::recomputeOrderMargin()
 {
     double margin = 0.0;
-    for (const Order &order : m_openOrders) {
-        margin += marginForOrder(order);
+    for (const auto &bySymbol : std::as_const(m_openOrders)) {
+        for (const OpenOrder &open : bySymbol)
+            margin += open.margin;
     }
     m_orderMargin = margin;
 }
@@ -454,15 +586,17 @@ void PortfolioManager::recomputeOrderMargin()
 void PortfolioManager::recordOrUpdatePosition(const QString &symbol, const Position &position)
 {
     if (qFuzzyIsNull(position.qty)) {
-        m_positions.remove(symbol);
+        if (m_positions.remove(symbol))
+            emit positionClosed(symbol);
     } else {
         Position copy = position;
         copy.symbol = symbol;
         m_positions.insert(symbol, copy);
+        emit positionChanged(copy);
     }
 }
 
 void PortfolioManager::emitSnapshot()
 {
-    emit portfolioChanged(snapshot(), positions());
+    emit portfolioChanged(snapshot());
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include <QObject>
+#include <QHash>
 #include <QMap>
 #include <QList>
 #include "models/position.h"
@@ -19,7 +20,7 @@ public:
         double acceptedQuantity = 0.0;
         double effectivePrice = 0.0;
         double fee = 0.0;
-        QString errorCode;
+        RejectReason reason = RejectReason::None;
     };
 
     double cash() const { return m_cash; }
@@ -28,34 +29,64 @@ public:
     double realizedPnL() const { return m_realizedPnL; }
     PortfolioSnapshot snapshot() const;
 
+    // Buying power while validating a basket of orders: each accepted order
+    // draws on it, so later ones see what earlier ones committed.
+    struct ValidationBudget {
+        double cash = 0.0;
+        double available = 0.0;
+    };
+
+    ValidationBudget validationBudget() const;
     OrderValidationResult validateOrder(bool isMarket,
                                         const QString &symbol,
-                                        const QString &side,
+                                        OrderSide side,
                                         double quantity,
                                         double price) const;
+    OrderValidationResult validateOrder(bool isMarket,
+                                        const QString &symbol,
+                                        OrderSide side,
+                                        double quantity,
+                                        double price,
+                                        ValidationBudget &budget) const;
+    // Checks only the extra reservation `amended` needs over `current`;
+    // shrinking an order always passes.
+    OrderValidationResult validateAmend(const Order &current, const Order &amended) const;
     double estimateFee(double price, double quantity) const;
 
 public slots:
     void onCandle(const Candle &c);
     void applyFill(const Order &order);
+    // Open orders reserve margin; deltas keep the reservation incrementally.
+    void onOrderUpserted(const Order &order);
+    void onOrdersUpserted(const QList<Order> &orders);
+    void onOrderRemoved(int orderId);
+    // Bulk reset from a full order list (initial sync).
     void onOrdersUpdated(const QList<Order> &orders);
     void updateFromQuote(const Quote &quote);
 
 signals:
-    void portfolioChanged(const PortfolioSnapshot &snapshot, const QList<Position> &positions);
+    void portfolioChanged(const PortfolioSnapshot &snapshot);
+    // Per-symbol position deltas; a flat position is reported as closed.
+    void positionChanged(const Position &position);
+    void positionClosed(const QString &symbol);
 
 private:
     void updateUnrealizedFor(const QString &symbol);
     double marginForPosition(const Position &position) const;
     double marginForOrder(const Order &order) const;
     double marginForOrder(const QString &symbol,
-                          const QString &side,
+                          OrderSide side,
                           double quantity,
                           double price) const;
     double openingQuantityForOrder(const QString &symbol,
-                                   const QString &side,
+                                   OrderSide side,
                                    double quantity) const;
     double availableFundsInternal() const;
+    static bool isOpenOrder(const Order &order);
+    void insertOpenOrder(const Order &order);
+    bool dropOpenOrder(int orderId);
+    bool upsertOpenOrder(const Order &order);
+    void refreshOrderMargins(const QString &symbol);
     void recomputeOrderMargin();
     void recordOrUpdatePosition(const QString &symbol, const Position &position);
     void emitSnapshot();
@@ -63,7 +94,13 @@ private:
     double m_cash = 100000.0;
     QMap<QString, Position> m_positions;
     QMap<QString, double> m_lastPrices;
-    QList<Order> m_openOrders;
+    struct OpenOrder {
+        Order order;
+        double margin = 0.0;   // reserved at the last position change
+    };
+    // Open orders grouped by symbol, so a fill only revisits its own symbol.
+    QHash<QString, QHash<int, OpenOrder>> m_openOrders;
+    QHash<int, QString> m_openOrderSymbols;
     double m_realizedPnL = 0.0;
     double m_orderMargin = 0.0;
     double m_shortMarginRate = 0.5;
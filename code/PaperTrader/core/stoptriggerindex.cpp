@@ -0,0 +1,173 @@
+#include "stoptriggerindex.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+void StopTriggerIndex::addStop(int orderId, OrderSide side, double level)
+{
+    remove(orderId);
+    const int s = sideIndex(side);
+    const auto it = m_sides[s].stops.emplace(sign(s) * level, orderId);
+    m_stops.insert(orderId, StopHandle{s, it});
+}
+
+void StopTriggerIndex::addTrailing(int orderId, OrderSide side, double distance, double mark)
+{
+    remove(orderId);
+    const int s = sideIndex(side);
+    const double x = sign(s) * mark;
+    raisePeak(s, x, false);
+
+    // Younger orders have seen fewer prices, so their peak is never higher
+    // than an older group's: join the youngest group or start a new one.
+    Side &sideState = m_sides[s];
+    auto &groups = sideState.groups;
+    const bool fresh = groups.empty() || groups.back().peak != x;
+    if (fresh) {
+        groups.emplace_back();
+        groups.back().peak = x;
+        groups.back().self = std::prev(groups.end());
+    }
+    TrailGroup &group = groups.back();
+    const auto it = group.byTrail.emplace(std::max(distance, 0.0), orderId);
+    if (fresh)
+        group.level = sideState.groupLevels.emplace(group.peak - it->first, &group);
+    else if (it == group.byTrail.begin())
+        relevel(sideState, group);
+    m_trailing.insert(orderId, TrailHandle{s, &group, it});
+}
+
+void StopTriggerIndex::relevel(Side &side, TrailGroup &group)
+{
+    side.groupLevels.erase(group.level);
+    group.level = side.groupLevels.emplace(group.peak - group.byTrail.begin()->first, &group);
+}
+
+void StopTriggerIndex::dropGroup(Side &side, TrailGroup &group)
+{
+    side.groupLevels.erase(group.level);
+    side.groups.erase(group.self);
+}
+
+void StopTriggerIndex::raisePeak(int side, double signedPrice, bool markMoved)
+{
+    Side &sideState = m_sides[side];
+    auto &groups = sideState.groups;
+    if (groups.empty() || groups.back().peak >= signedPrice)
+        return;
+
+    // Every group whose peak the price reaches now trails the same peak;
+    // fold them into one, moving the smaller group's nodes each time.
+    auto merged = std::prev(groups.end());
+    while (merged != groups.begin() && std::prev(merged)->peak <= signedPrice) {
+        auto other = std::prev(merged);
+        if (other->byTrail.size() > merged->byTrail.size())
+            std::swap(merged, other);
+        for (const auto &entry : other->byTrail)
+            m_trailing[entry.second].group = &*merged;
+        merged->byTrail.merge(other->byTrail);
+        merged->moved = merged->moved || other->moved;
+        dropGroup(sideState, *other);
+    }
+    merged->peak = signedPrice;
+    relevel(sideState, *merged);
+    if (markMoved) {
+        merged->moved = true;
+        sideState.moved = true;
+    }
+}
+
+void StopTriggerIndex::takeMovedLevels(std::vector<Trigger> &moved)
+{
+    for (int s = 0; s < 2; ++s) {
+        Side &side = m_sides[s];
+        if (!side.moved)
+            continue;
+        side.moved = false;
+        for (TrailGroup &group : side.groups) {
+            if (!group.moved)
+                continue;
+            group.moved = false;
+            for (const auto &entry : group.byTrail)
+                moved.push_back({entry.second, sign(s) * (group.peak - entry.first)});
+        }
+    }
+}
+
+bool StopTriggerIndex::remove(int orderId)
+{
+    const auto stop = m_stops.constFind(orderId);
+    if (stop != m_stops.constEnd()) {
+        m_sides[stop->side].stops.erase(stop->it);
+        m_stops.erase(stop);
+        return true;
+    }
+
+    const auto trail = m_trailing.constFind(orderId);
+    if (trail == m_trailing.constEnd())
+        return false;
+
+    Side &side = m_sides[trail->side];
+    TrailGroup *group = trail->group;
+    const bool first = trail->it == group->byTrail.begin();
+    group->byTrail.erase(trail->it);
+    if (group->byTrail.empty())
+        dropGroup(side, *group);
+    else if (first)
+        relevel(side, *group);
+    m_trailing.erase(trail);
+    return true;
+}
+
+bool StopTriggerIndex::contains(int orderId) const
+{
+    return m_stops.contains(orderId) || m_trailing.contains(orderId);
+}
+
+void StopTriggerIndex::onPrice(double price, std::vector<Trigger> &triggered)
+{
+    if (price <= 0.0)
+        return;
+
+    for (int s = 0; s < 2; ++s) {
+        Side &side = m_sides[s];
+        const double x = sign(s) * price;
+        raisePeak(s, x, true);
+
+        while (!side.stops.empty() && side.stops.begin()->first >= x) {
+            const auto it = side.stops.begin();
+            triggered.push_back({it->second, sign(s) * it->first});
+            m_stops.remove(it->second);
+            side.stops.erase(it);
+        }
+
+        // Highest trigger level first; stop at the first group the price
+        // does not reach.
+        while (!side.groupLevels.empty() && side.groupLevels.begin()->first >= x) {
+            TrailGroup &group = *side.groupLevels.begin()->second;
+            while (!group.byTrail.empty() && group.peak - group.byTrail.begin()->first >= x) {
+                const auto it = group.byTrail.begin();
+                triggered.push_back({it->second, sign(s) * (group.peak - it->first)});
+                m_trailing.remove(it->second);
+                group.byTrail.erase(it);
+            }
+            if (group.byTrail.empty())
+                dropGroup(side, group);
+            else
+                relevel(side, group);
+        }
+    }
+}
+
+double StopTriggerIndex::triggerLevel(int orderId) const
+{
+    const auto stop = m_stops.constFind(orderId);
+    if (stop != m_stops.constEnd())
+        return sign(stop->side) * stop->it->first;
+
+    const auto trail = m_trailing.constFind(orderId);
+    if (trail != m_trailing.constEnd())
+        return sign(trail->side) * (trail->group->peak - trail->it->first);
+    return 0.0;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <QHash>
+#include <functional>
+#include <list>
+#include <map>
+#include <vector>
+
+#include "models/ordertypes.h"
+
+/**
+ * StopTriggerIndex: the untriggered stop orders of one symbol.
+ *
+ * Plain stops are sorted by trigger level, so a price update pops only the
+ * stops it crosses. Trailing stops are grouped by the extreme price they
+ * trail: an order tracks the best price seen since it was placed, so a new
+ * extreme lifts every younger group at once by merging them into a single
+ * group. Members keep their order by trail distance, so no level is
+ * rewritten or re-sorted per tick. Groups are also sorted by their next
+ * trigger level (peak less the smallest trail), so a price visits only the
+ * groups it actually triggers.
+ */
+class StopTriggerIndex {
+public:
+    struct Trigger {
+        int orderId = 0;
+        double level = 0.0;   // trigger price that was crossed
+    };
+
+    // Sell stops fire when the price falls to `level`, buy stops when it
+    // rises to it.
+    void addStop(int orderId, OrderSide side, double level);
+    // Trails `distance` behind the best price seen from `mark` onwards.
+    void addTrailing(int orderId, OrderSide side, double distance, double mark);
+    bool remove(int orderId);
+    bool contains(int orderId) const;
+
+    // Feeds one price. Triggered orders leave the index and are appended to
+    // `triggered` in the order they fired. A new extreme only marks the
+    // lifted trail group; its members' levels are read by takeMovedLevels.
+    void onPrice(double price, std::vector<Trigger> &triggered);
+    // Appends the current level of every trailing stop lifted since the
+    // last call, once each however many extremes it followed.
+    void takeMovedLevels(std::vector<Trigger> &moved);
+    bool hasMovedLevels() const { return m_sides[0].moved || m_sides[1].moved; }
+
+    // Current trigger level, or 0 when the order is not indexed.
+    double triggerLevel(int orderId) const;
+    int size() const { return static_cast<int>(m_stops.size() + m_trailing.size()); }
+    bool isEmpty() const { return size() == 0; }
+
+private:
+    // One implementation serves both sides: every level fires when a signed
+    // price falls to it, and buy orders are stored with negated prices.
+    using StopLevels = std::multimap<double, int, std::greater<double>>;
+    struct TrailGroup;
+    using GroupLevels = std::multimap<double, TrailGroup *, std::greater<double>>;
+    struct TrailGroup {
+        double peak = 0.0;                   // best signed price since placement
+        std::multimap<double, int> byTrail;  // distance -> order id
+        GroupLevels::iterator level;         // entry for peak - smallest trail
+        std::list<TrailGroup>::iterator self;
+        bool moved = false;                  // peak rose since takeMovedLevels
+    };
+    struct Side {
+        StopLevels stops;
+        // Oldest first; peaks strictly decrease towards the back. Never empty.
+        std::list<TrailGroup> groups;
+        GroupLevels groupLevels;
+        bool moved = false;                  // some group is marked moved
+    };
+    struct StopHandle {
+        int side = 0;
+        StopLevels::iterator it;
+    };
+    struct TrailHandle {
+        int side = 0;
+        TrailGroup *group = nullptr;
+        std::multimap<double, int>::iterator it;
+    };
+
+    static int sideIndex(OrderSide side) { return side == OrderSide::Buy ? 1 : 0; }
+    static double sign(int side) { return side == 1 ? -1.0 : 1.0; }
+    void raisePeak(int side, double signedPrice, bool markMoved);
+    void relevel(Side &side, TrailGroup &group);
+    void dropGroup(Side &side, TrailGroup &group);
+
+    Side m_sides[2];
+    QHash<int, StopHandle> m_stops;
+    QHash<int, TrailHandle> m_trailing;
+};
@@ -2,12 +2,81 @@
 
 #include <QDir>
 #include <QFile>
+#include <QFutureWatcher>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QStandardPaths>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
 
 static const char *kWatchlistFile = "watchlist.json";
 static const char *kSettingsFile  = "settings.json";
+static const char *kHistoryDir    = "history";
+
+namespace {
+struct CandleRecord {
+    qint64 time;
+    double open;
+    double high;
+    double low;
+    double close;
+    double volume;
+};
+static_assert(sizeof(CandleRecord) == 48, "history records must stay 48 bytes");
+
+qint64 recordTime(QFile &f, qint64 index)
+{
+    qint64 time = 0;
+    f.seek(index * qint64(sizeof(CandleRecord)));
+    f.read(reinterpret_cast<char *>(&time), sizeof(time));
+    return time;
+}
+
+// Runs on a worker thread: binary-searches the time-ordered file for the
+// first record at or after beforeMs and returns the page just before it.
+CandleColumns readHistoryPage(const QString &path, qint64 beforeMs, int maxCount)
+{
+    CandleColumns page;
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+        return page;
+
+    const qint64 count = f.size() / qint64(sizeof(CandleRecord));
+    qint64 lo = 0;
+    qint64 hi = count;
+    while (lo < hi) {
+        const qint64 mid = lo + (hi - lo) / 2;
+        if (recordTime(f, mid) < beforeMs)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    const qint64 first = std::max<qint64>(0, lo - maxCount);
+    const int n = static_cast<int>(lo - first);
+    if (n <= 0)
+        return page;
+
+    QVector<CandleRecord> records(n);
+    f.seek(first * qint64(sizeof(CandleRecord)));
+    const qint64 bytes = f.read(reinterpret_cast<char *>(records.data()),
+                                n * qint64(sizeof(CandleRecord)));
+    const int read = static_cast<int>(std::max<qint64>(0, bytes) / qint64(sizeof(CandleRecord)));
+
+    page.reserve(read);
+    for (int i = 0; i < read; ++i) {
+        const CandleRecord &r = records[i];
+        page.time.append(r.time);
+        page.open.append(r.open);
+        page.high.append(r.high);
+        page.low.append(r.low);
+        page.close.append(r.close);
+        page.volume.append(r.volume);
+    }
+    return page;
+}
+}
 
 StorageManager::StorageManager(QObject *parent)
     : QObject(parent)
@@ -93,3 +162,41 @@ bool StorageManager::saveSettings(const QJsonObject &settings)
     f.write(doc.toJson(QJsonDocument::Compact));
     return true;
 }
+
+QString StorageManager::historyPath(const QString &symbol) const
+{
+    QString name;
+    for (const QChar ch : symbol.toUpper()) {
+        if (ch.isLetterOrNumber())
+            name.append(ch);
+    }
+    QDir dir(ensureStorageDir());
+    dir.mkpath(kHistoryDir);
+    return dir.filePath(QStringLiteral("%1/%2.bin").arg(kHistoryDir, name));
+}
+
+bool StorageManager::appendCandle(const Candle &c)
+{
+    if (!c.timestamp.isValid())
+        return false;
+
+    QFile f(historyPath(c.symbol));
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Append))
+        return false;
+
+    const CandleRecord record{c.timestamp.toMSecsSinceEpoch(),
+                              c.open, c.high, c.low, c.close, c.volume};
+    return f.write(reinterpret_cast<const char *>(&record), sizeof(record)) == sizeof(record);
+}
+
+void StorageManager::requestHistory(const QString &symbol, qint64 beforeMs, int maxCount)
+{
+    const QString path = historyPath(symbol);
+    auto *watcher = new QFutureWatcher<CandleColumns>(this);
+    connect(watcher, &QFutureWatcher<CandleColumns>::finished, this,
+            [this, watcher, symbol, beforeMs]() {
+                emit historyLoaded(symbol, beforeMs, watcher->result());
+                watcher->deleteLater();
+            });
+    watcher->setFuture(QtConcurrent::run(readHistoryPage, path, beforeMs, maxCount));
+}
@@ -2,6 +2,8 @@
 #include <QObject>
 #include <QStringList>
 #include <QJsonObject>
+#include "models/candle.h"
+#include "models/candlecolumns.h"
 
 class StorageManager : public QObject {
     Q_OBJECT
@@ -14,11 +16,25 @@ public:
     QJsonObject loadSettings() const;
     bool saveSettings(const QJsonObject &settings);
 
+    // Candle history: one file of fixed-size binary records per symbol,
+    // appended in time order (native byte order; a local cache, not an
+    // interchange format).
+    bool appendCandle(const Candle &c);
+    // Reads up to maxCount bars older than beforeMs on a worker thread and
+    // reports them, oldest first, through historyLoaded.
+    void requestHistory(const QString &symbol, qint64 beforeMs, int maxCount);
+
+    // Scratch file the order history spills finished orders to.
+    QString orderHistoryPath() const { return filePath(QStringLiteral("order-history.bin")); }
     QString storageRoot() const { return m_storageRoot; }
 
+signals:
+    void historyLoaded(const QString &symbol, qint64 beforeMs, const CandleColumns &page);
+
 private:
     QString ensureStorageDir() const;
     QString filePath(const QString &name) const;
+    QString historyPath(const QString &symbol) const;
 
     QString m_storageRoot;
 };
@@ -0,0 +1,78 @@
+#include "tickdecimator.h"
+
+#include <algorithm>
+
+bool TickDecimator::setResolution(qint64 msPerColumn)
+{
+    msPerColumn = std::max<qint64>(1, msPerColumn);
+    if (msPerColumn == m_resolution)
+        return false;
+    m_resolution = msPerColumn;
+    clear();
+    return true;
+}
+
+void TickDecimator::clear()
+{
+    m_columns.clear();
+    m_consumed = 0;
+}
+
+qint64 TickDecimator::columnOf(qint64 ms) const
+{
+    // Floor division so columns line up across zero as well.
+    qint64 q = ms / m_resolution;
+    if ((ms % m_resolution) < 0)
+        --q;
+    return q;
+}
+
+void TickDecimator::rebuild(const TickColumns &ticks)
+{
+    clear();
+    update(ticks);
+}
+
+void TickDecimator::update(const TickColumns &ticks)
+{
+    const qint64 end = ticks.base + ticks.size();
+    if (m_consumed < ticks.base || m_consumed > end) {
+        m_columns.clear();
+        m_consumed = ticks.base;
+    }
+
+    for (int i = static_cast<int>(m_consumed - ticks.base); i < ticks.size(); ++i)
+        add(ticks.time[i], ticks.price[i]);
+    m_consumed = end;
+
+    // Ticks trimmed off the front take their columns with them; the oldest
+    // surviving column may still reflect a few trimmed ticks.
+    if (!ticks.isEmpty() && !m_columns.isEmpty()) {
+        const int keep = lowerBound(columnOf(ticks.time.first()));
+        if (keep > 0)
+            m_columns.remove(0, keep);
+    }
+}
+
+void TickDecimator::add(qint64 ms, double price)
+{
+    const qint64 index = columnOf(ms);
+    if (!m_columns.isEmpty() && m_columns.last().index >= index) {
+        // Late ticks fold into the newest column rather than reordering.
+        Column &col = m_columns.last();
+        col.min = std::min(col.min, price);
+        col.max = std::max(col.max, price);
+        col.last = price;
+        return;
+    }
+    m_columns.append(Column{index, price, price, price, price});
+}
+
+int TickDecimator::lowerBound(qint64 columnIndex) const
+{
+    const auto it = std::lower_bound(m_columns.cbegin(), m_columns.cend(), columnIndex,
+                                     [](const Column &col, qint64 value) {
+                                         return col.index < value;
+                                     });
+    return static_cast<int>(it - m_columns.cbegin());
+}
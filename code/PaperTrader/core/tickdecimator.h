@@ -0,0 +1,76 @@
+#pragma once
+#include <QVector>
+#include <QtGlobal>
+
+// Raw tick prices for one symbol. `base` counts ticks trimmed from the front
+// so consumers can tell appended ticks from a shifted buffer.
+struct TickColumns {
+    QVector<qint64> time;     // msecs since epoch (UTC)
+    QVector<double> price;
+    qint64 base = 0;
+
+    int size() const { return static_cast<int>(price.size()); }
+    bool isEmpty() const { return price.isEmpty(); }
+
+    void append(qint64 ms, double value)
+    {
+        time.append(ms);
+        price.append(value);
+    }
+
+    void clear()
+    {
+        time.clear();
+        price.clear();
+        base = 0;
+    }
+
+    // Drops the oldest `count` ticks.
+    void trimFront(int count)
+    {
+        time.remove(0, count);
+        price.remove(0, count);
+        base += count;
+    }
+};
+
+/**
+ * TickDecimator: reduces a tick stream to one {min, max, first, last} bucket
+ * per fixed-width time column (one screen pixel in the tick chart).
+ *
+ * Columns are aligned to multiples of the resolution, so they stay valid as
+ * the view scrolls. New ticks only touch the last column; only a resolution
+ * change (zoom or resize) needs a full rebuild.
+ */
+class TickDecimator {
+public:
+    struct Column {
+        qint64 index = 0;   // time / resolution
+        double min = 0.0;
+        double max = 0.0;
+        double first = 0.0;
+        double last = 0.0;
+    };
+
+    qint64 resolution() const { return m_resolution; }
+    // Returns true when the resolution changed and the columns were dropped.
+    bool setResolution(qint64 msPerColumn);
+
+    // Folds in ticks appended since the last call; rebuilds if the buffer was
+    // cleared or trimmed past what has been consumed.
+    void update(const TickColumns &ticks);
+    void rebuild(const TickColumns &ticks);
+    void clear();
+
+    qint64 columnOf(qint64 ms) const;
+    const QVector<Column> &columns() const { return m_columns; }
+    // First column whose index is >= columnIndex.
+    int lowerBound(qint64 columnIndex) const;
+
+private:
+    void add(qint64 ms, double price);
+
+    qint64 m_resolution = 1;
+    qint64 m_consumed = 0;    // absolute tick count folded in
+    QVector<Column> m_columns;
+};
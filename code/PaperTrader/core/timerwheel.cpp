@@ -0,0 +1,99 @@
+#include "timerwheel.h"
+
+#include <algorithm>
+#include <iterator>
+
+TimerWheel::TimerWheel(qint64 tickMs, qint64 startMs)
+    : m_tickMs(std::max<qint64>(1, tickMs))
+    , m_originMs(startMs)
+{
+}
+
+quint64 TimerWheel::tickFor(qint64 ms) const
+{
+    if (ms <= m_originMs)
+        return 0;
+    return static_cast<quint64>((ms - m_originMs + m_tickMs - 1) / m_tickMs);
+}
+
+void TimerWheel::schedule(int id, qint64 deadlineMs)
+{
+    cancel(id);
+    Entry entry;
+    entry.id = id;
+    entry.tick = std::max(tickFor(deadlineMs), m_current + 1);
+    place(entry);
+}
+
+bool TimerWheel::cancel(int id)
+{
+    const auto handle = m_handles.constFind(id);
+    if (handle == m_handles.constEnd())
+        return false;
+    handle->slot->erase(handle->it);
+    m_handles.erase(handle);
+    return true;
+}
+
+void TimerWheel::place(const Entry &entry)
+{
+    // The lowest level whose turn still contains the deadline; anything past
+    // the top level waits in the next top-level slot and is placed again
+    // from there.
+    int level = kLevels - 1;
+    int index = static_cast<int>(((m_current >> (kSlotBits * level)) + 1) & (kSlots - 1));
+    for (int l = 0; l < kLevels; ++l) {
+        if (((entry.tick ^ m_current) >> (kSlotBits * (l + 1))) == 0) {
+            level = l;
+            index = static_cast<int>((entry.tick >> (kSlotBits * l)) & (kSlots - 1));
+            break;
+        }
+    }
+
+    Slot &slot = m_slots[level][index];
+    slot.push_back(entry);
+    m_handles.insert(entry.id, Handle{&slot, std::prev(slot.end())});
+}
+
+void TimerWheel::cascade(int level)
+{
+    const int index = static_cast<int>((m_current >> (kSlotBits * level)) & (kSlots - 1));
+    Slot pending;
+    pending.splice(pending.end(), m_slots[level][index]);
+    while (!pending.empty()) {
+        const Entry entry = pending.front();
+        pending.pop_front();
+        m_handles.remove(entry.id);
+        place(entry);
+    }
+}
+
+void TimerWheel::advance(qint64 nowMs, std::vector<int> &expired)
+{
+    if (nowMs < m_originMs)
+        return;
+
+    const quint64 target = static_cast<quint64>((nowMs - m_originMs) / m_tickMs);
+    while (m_current < target) {
+        if (m_handles.isEmpty()) {
+            m_current = target;
+            break;
+        }
+        ++m_current;
+
+        // At a turn of level l, the matching slot of level l moves down;
+        // higher levels go first so their entries can land in lower slots.
+        for (int level = kLevels - 1; level > 0; --level) {
+            const quint64 mask = (quint64(1) << (kSlotBits * level)) - 1;
+            if ((m_current & mask) == 0)
+                cascade(level);
+        }
+
+        Slot &due = m_slots[0][m_current & (kSlots - 1)];
+        for (const Entry &entry : due) {
+            expired.push_back(entry.id);
+            m_handles.remove(entry.id);
+        }
+        due.clear();
+    }
+}
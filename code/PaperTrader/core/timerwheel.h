@@ -0,0 +1,57 @@
+#pragma once
+#include <QHash>
+#include <QtGlobal>
+#include <list>
+#include <vector>
+
+/**
+ * TimerWheel: order expirations bucketed by deadline.
+ *
+ * A hierarchical hashed wheel: four levels of 64 slots, each level's slot
+ * spanning a full turn of the level below. Scheduling and cancelling are
+ * O(1); advancing one tick fires a single level-0 slot and, once per turn,
+ * redistributes one slot of the level above. Deadlines round up to the next
+ * tick, so an entry never fires early.
+ */
+class TimerWheel {
+public:
+    explicit TimerWheel(qint64 tickMs = 1000, qint64 startMs = 0);
+
+    // Replaces any earlier deadline for `id`.
+    void schedule(int id, qint64 deadlineMs);
+    bool cancel(int id);
+    bool contains(int id) const { return m_handles.contains(id); }
+
+    // Moves the clock forward to `nowMs` and appends the ids that came due,
+    // earliest tick first.
+    void advance(qint64 nowMs, std::vector<int> &expired);
+
+    qint64 now() const { return m_originMs + static_cast<qint64>(m_current) * m_tickMs; }
+    int size() const { return static_cast<int>(m_handles.size()); }
+    bool isEmpty() const { return m_handles.isEmpty(); }
+
+private:
+    static constexpr int kLevels = 4;
+    static constexpr int kSlotBits = 6;
+    static constexpr int kSlots = 1 << kSlotBits;
+
+    struct Entry {
+        int id = 0;
+        quint64 tick = 0;
+    };
+    using Slot = std::list<Entry>;
+    struct Handle {
+        Slot *slot = nullptr;
+        Slot::iterator it;
+    };
+
+    quint64 tickFor(qint64 ms) const;
+    void place(const Entry &entry);
+    void cascade(int level);
+
+    qint64 m_tickMs;
+    qint64 m_originMs;
+    quint64 m_current = 0;   // last tick processed
+    Slot m_slots[kLevels][kSlots];
+    QHash<int, Handle> m_handles;
+};
@@ -0,0 +1,282 @@
+#include <QtTest/QtTest>
+#include <QGuiApplication>
+#include <QImage>
+#include <QPainter>
+#include <QRandomGenerator>
+#include <QThread>
+#include <QThreadPool>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "ui/chartrenderer.h"
+#include "core/indicatorengine.h"
+
+// Every heap allocation in the process goes through these, so a frame's
+// allocation count is the counter delta across one render() call.
+static std::atomic<quint64> g_allocations{0};
+
+void *operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+// Renders synthetic histories through ChartRenderer into an offscreen QImage,
+// so it needs no window system. Rows cover 1k to 1M bars at three zoom levels;
+// per-frame time comes from QBENCHMARK, allocations are printed with qInfo.
+class ChartRenderBenchmarks : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void test_rendersOffscreen();
+    void test_crosshairTouchesFewPixels();
+    void test_tiledMatchesSingleRender();
+
+    void bench_render_data();
+    void bench_render();
+
+    void bench_renderTiled_data();
+    void bench_renderTiled();
+
+private:
+    void load(int bars);
+
+    static constexpr int kMaxBars = 1000000;
+    static constexpr QSize kFrame{1600, 900};
+    QVector<Candle> m_all;
+    CandleHistory m_bars;
+    IndicatorEngine m_indicators;
+    int m_loaded = -1;
+};
+
+void ChartRenderBenchmarks::initTestCase()
+{
+    QRandomGenerator rng(7);
+    m_all.reserve(kMaxBars);
+    const QDateTime start = QDateTime::fromSecsSinceEpoch(1700000000, Qt::UTC);
+    double price = 20000.0;
+    for (int i = 0; i < kMaxBars; ++i) {
+        Candle c;
+        c.timestamp = start.addSecs(i * 60);
+        c.open = price;
+        price += rng.generateDouble() * 20.0 - 10.0;
+        c.close = price;
+        c.high = std::max(c.open, c.close) + rng.generateDouble() * 5.0;
+        c.low = std::min(c.open, c.close) - rng.generateDouble() * 5.0;
+        c.volume = 100.0 + rng.generateDouble() * 900.0;
+        m_all.append(c);
+    }
+}
+
+void ChartRenderBenchmarks::load(int bars)
+{
+    if (m_loaded == bars)
+        return;
+    const QVector<Candle> candles = m_all.mid(0, bars);
+    m_bars.clear();
+    for (const Candle &c : candles)
+        m_bars.append(c);
+    m_indicators.removeAll();
+    m_indicators.addIndicator({IndicatorSpec::Kind::SMA, 20});
+    m_indicators.addIndicator({IndicatorSpec::Kind::Bollinger, 20, 2.0});
+    m_indicators.addIndicator({IndicatorSpec::Kind::RSI, 14});
+    m_indicators.recompute(candles);
+    m_loaded = bars;
+}
+
+void ChartRenderBenchmarks::test_rendersOffscreen()
+{
+    load(1000);
+    ChartRenderer renderer;
+    renderer.setBars(&m_bars);
+
+    ChartViewState view;
+    view.viewStart = m_bars.size() - renderer.visibleCount(QRect(QPoint(), kFrame), view);
+    const QImage image = renderer.renderToImage(kFrame, view);
+    QCOMPARE(image.size(), kFrame);
+
+    // The background gradient is near-black; candles must have drawn over it.
+    bool drewSomething = false;
+    for (int y = 0; y < image.height() && !drewSomething; y += 4) {
+        for (int x = 0; x < image.width(); x += 4) {
+            if (qGreen(image.pixel(x, y)) > 150) {
+                drewSomething = true;
+                break;
+            }
+        }
+    }
+    QVERIFY(drewSomething);
+}
+
+void ChartRenderBenchmarks::test_crosshairTouchesFewPixels()
+{
+    load(1000);
+    ChartRenderer renderer;
+    renderer.setBars(&m_bars);
+    ChartViewState view;
+    view.viewStart = m_bars.size() - renderer.visibleCount(QRect(QPoint(), kFrame), view);
+    renderer.renderToImage(kFrame, view);
+
+    // Pixel and time lookups agree on the hovered bar.
+    const QPoint pos(kFrame.width() / 2, kFrame.height() / 3);
+    const int bar = renderer.barAt(pos.x());
+    QVERIFY(bar >= 0);
+    QCOMPARE(renderer.barAtTime(renderer.barTime(bar)), bar);
+    QCOMPARE(renderer.barAtTime(renderer.barTime(bar) + 1), bar);
+    QCOMPARE(renderer.barAtTime(m_bars.time[0] - 1), -1);
+
+    // A hover repaints a few strips, not the frame.
+    qint64 area = 0;
+    for (const QRect &r : renderer.crosshairRegion(pos, bar))
+        area += qint64(r.width()) * r.height();
+    QVERIFY(area * 10 < qint64(kFrame.width()) * kFrame.height());
+}
+
+void ChartRenderBenchmarks::bench_render_data()
+{
+    QTest::addColumn<int>("bars");
+    QTest::addColumn<int>("candleWidth");
+
+    for (int bars : {1000, 10000, 100000, kMaxBars}) {
+        for (int width : {1, 6, 24}) {
+            const QByteArray name = QByteArray::number(bars) + " bars, width " + QByteArray::number(width);
+            QTest::newRow(name.constData()) << bars << width;
+        }
+    }
+}
+
+void ChartRenderBenchmarks::bench_render()
+{
+    QFETCH(int, bars);
+    QFETCH(int, candleWidth);
+    load(bars);
+
+    ChartRenderer renderer;
+    renderer.setBars(&m_bars);
+    renderer.setIndicatorEngine(&m_indicators);
+    renderer.setPriceOverlays({0, 1});
+    renderer.setIndicatorPaneSeries(2);
+
+    const QRect bounds(QPoint(), kFrame);
+    ChartViewState view;
+    view.candleWidth = candleWidth;
+    view.spacing = candleWidth > 1 ? 2 : 0;
+    view.viewStart = std::max(0.0, bars - renderer.visibleCount(bounds, view));
+    view.showLiveBadge = true;
+
+    QImage image(kFrame, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&image);
+
+    // Warm the scale cache first so the counted frame is a steady-state repaint.
+    renderer.render(painter, bounds, view);
+    const quint64 before = g_allocations.load();
+    renderer.render(painter, bounds, view);
+    qInfo("%s: %llu allocations per frame", QTest::currentDataTag(),
+          static_cast<unsigned long long>(g_allocations.load() - before));
+
+    QBENCHMARK {
+        renderer.render(painter, bounds, view);
+    }
+}
+
+void ChartRenderBenchmarks::test_tiledMatchesSingleRender()
+{
+    load(10000);
+    ChartRenderer renderer;
+    renderer.setBars(&m_bars);
+    renderer.setIndicatorEngine(&m_indicators);
+    renderer.setPriceOverlays({0, 1});
+    renderer.setIndicatorPaneSeries(2);
+
+    const QSize size(2500, 1200);
+    ChartViewState view;
+    view.candleWidth = 2;
+    view.spacing = 1;
+    view.viewStart = std::max(0.0, m_bars.size() - renderer.visibleCount(QRect(QPoint(), size), view));
+
+    const QImage single = renderer.renderToImage(size, view);
+    const QImage tiled = renderer.renderTiled(size, view, 256);
+    QCOMPARE(tiled.size(), single.size());
+
+    // Antialiased strokes may differ by a shade where a path restarts at a
+    // tile's left edge; anything beyond that is a seam.
+    int differing = 0;
+    for (int y = 0; y < size.height(); ++y) {
+        for (int x = 0; x < size.width(); ++x) {
+            const QRgb a = single.pixel(x, y);
+            const QRgb b = tiled.pixel(x, y);
+            if (std::abs(qRed(a) - qRed(b)) > 8 || std::abs(qGreen(a) - qGreen(b)) > 8
+                    || std::abs(qBlue(a) - qBlue(b)) > 8) {
+                ++differing;
+            }
+        }
+    }
+    QVERIFY2(differing * 1000 < size.width() * size.height(),
+             qPrintable(QString::number(differing) + " pixels differ"));
+}
+
+void ChartRenderBenchmarks::bench_renderTiled_data()
+{
+    QTest::addColumn<int>("threads");
+    QList<int> counts{1, 2, 4};
+    if (QThread::idealThreadCount() > 4)
+        counts.append(QThread::idealThreadCount());
+    for (int threads : counts)
+        QTest::newRow(QByteArray::number(threads).append(" threads").constData()) << threads;
+}
+
+void ChartRenderBenchmarks::bench_renderTiled()
+{
+    QFETCH(int, threads);
+    load(100000);
+
+    ChartRenderer renderer;
+    renderer.setBars(&m_bars);
+    renderer.setIndicatorEngine(&m_indicators);
+    renderer.setPriceOverlays({0, 1});
+    renderer.setIndicatorPaneSeries(2);
+
+    // A 16k-wide export at two pixels per bar.
+    const QSize size(16384, 2048);
+    ChartViewState view;
+    view.candleWidth = 1;
+    view.spacing = 1;
+    view.viewStart = std::max(0.0, m_bars.size() - renderer.visibleCount(QRect(QPoint(), size), view));
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int previous = pool->maxThreadCount();
+    pool->setMaxThreadCount(threads);
+    QBENCHMARK {
+        const QImage image = renderer.renderTiled(size, view);
+        Q_UNUSED(image);
+    }
+    pool->setMaxThreadCount(previous);
+}
+
+int main(int argc, char *argv[])
+{
+    // CI runners have no display; fall back to the offscreen platform plugin.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QGuiApplication app(argc, argv);
+    ChartRenderBenchmarks bench;
+    return QTest::qExec(&bench, argc, argv);
+}
+
+#include "bench_chartrender.moc"
@@ -0,0 +1,88 @@
+#include <QtTest/QtTest>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <algorithm>
+#include <vector>
+
+#include "core/exchangesimulator.h"
+
+// Replays one million orders from 64 accounts through a single book: limits
+// a few ticks either side of a drifting mid (about a quarter of them cross),
+// with every fifth order cancelling an earlier one. Prints orders per second
+// alongside the QBENCHMARK time.
+class ExchangeSimulatorBenchmarks : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void bench_orderFlow();
+
+private:
+    struct Step {
+        ExchangeSimulator::NewOrder order;
+        int cancelStep = -1;   // >= 0: cancel the order placed at that step
+    };
+
+    void replay(std::vector<ExecutionReport> &reports) const;
+
+    static constexpr int kOrders = 1000000;
+    std::vector<Step> m_steps;
+};
+
+void ExchangeSimulatorBenchmarks::initTestCase()
+{
+    QRandomGenerator rng(7);
+    m_steps.resize(kOrders);
+    double mid = 100.0;
+    for (int i = 0; i < kOrders; ++i) {
+        Step &step = m_steps[i];
+        if (i > 0 && i % 5 == 0) {
+            step.cancelStep = static_cast<int>(rng.bounded(i));
+            continue;
+        }
+        mid += (rng.generateDouble() - 0.5) * 0.02;
+        const bool buy = rng.bounded(2) == 0;
+        const int offset = static_cast<int>(rng.bounded(12)) - 3;   // < 0 crosses
+        step.order.account = static_cast<int>(rng.bounded(64));
+        step.order.side = buy ? OrderSide::Buy : OrderSide::Sell;
+        step.order.price = mid + (buy ? -offset : offset) * 0.01;
+        step.order.quantity = 1.0 + rng.bounded(10);
+    }
+}
+
+void ExchangeSimulatorBenchmarks::replay(std::vector<ExecutionReport> &reports) const
+{
+    ExchangeSimulator exchange;
+    const int symbol = exchange.listSymbol("BENCH");
+    std::vector<quint64> ids(m_steps.size(), 0);
+    for (int i = 0; i < kOrders; ++i) {
+        const Step &step = m_steps[i];
+        reports.clear();
+        if (step.cancelStep >= 0) {
+            exchange.cancel(ids[step.cancelStep], reports);
+            continue;
+        }
+        ExchangeSimulator::NewOrder order = step.order;
+        order.symbol = symbol;
+        ids[i] = exchange.submit(order, reports);
+    }
+}
+
+void ExchangeSimulatorBenchmarks::bench_orderFlow()
+{
+    std::vector<ExecutionReport> reports;
+    reports.reserve(1024);
+
+    QElapsedTimer timer;
+    timer.start();
+    replay(reports);
+    const qint64 ns = std::max<qint64>(1, timer.nsecsElapsed());
+    qInfo("%.2f M orders/s", kOrders * 1e3 / ns);
+
+    QBENCHMARK {
+        replay(reports);
+    }
+}
+
+QTEST_MAIN(ExchangeSimulatorBenchmarks)
+#include "bench_exchangesimulator.moc"
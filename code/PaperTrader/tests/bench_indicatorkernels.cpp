@@ -0,0 +1,149 @@
+#include <QtTest/QtTest>
+#include <QRandomGenerator>
+#include <cmath>
+#include <vector>
+
+#include "core/indicatorkernels.h"
+
+using IndicatorKernels::Isa;
+
+// Benchmarks the bulk indicator kernels over one million bars, once with the
+// scalar loops and once with the best ISA the machine supports. Run with
+// `-tickcounter` or `-iterations N` for steadier numbers.
+class IndicatorKernelBenchmarks : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void test_vectorMatchesScalar();
+
+    void bench_movingAverage_data();
+    void bench_movingAverage();
+    void bench_rollingVariance_data();
+    void bench_rollingVariance();
+    void bench_trueRange_data();
+    void bench_trueRange();
+    void bench_simpleReturns_data();
+    void bench_simpleReturns();
+
+private:
+    void addIsaRows();
+
+    static constexpr std::size_t kBars = 1000000;
+    std::vector<double> m_high;
+    std::vector<double> m_low;
+    std::vector<double> m_close;
+    std::vector<double> m_out;
+};
+
+void IndicatorKernelBenchmarks::initTestCase()
+{
+    QRandomGenerator rng(42);
+    m_high.resize(kBars);
+    m_low.resize(kBars);
+    m_close.resize(kBars);
+    m_out.resize(kBars);
+
+    double price = 20000.0;
+    for (std::size_t i = 0; i < kBars; ++i) {
+        price += rng.generateDouble() - 0.5;
+        m_close[i] = price;
+        m_high[i] = price + rng.generateDouble();
+        m_low[i] = price - rng.generateDouble();
+    }
+
+    qInfo("Detected ISA: %s", IndicatorKernels::isaName(IndicatorKernels::detectedIsa()));
+}
+
+void IndicatorKernelBenchmarks::test_vectorMatchesScalar()
+{
+    if (IndicatorKernels::detectedIsa() == Isa::Scalar)
+        QSKIP("No vector ISA available on this machine");
+
+    std::vector<double> scalar(kBars);
+    std::vector<double> vector(kBars);
+
+    IndicatorKernels::movingAverage(m_close.data(), scalar.data(), kBars, 20, Isa::Scalar);
+    IndicatorKernels::movingAverage(m_close.data(), vector.data(), kBars, 20, Isa::Avx2);
+    for (std::size_t i = 19; i < kBars; ++i)
+        QVERIFY(std::fabs(scalar[i] - vector[i]) < 1e-8);
+
+    IndicatorKernels::rollingVariance(m_close.data(), scalar.data(), kBars, 20, Isa::Scalar);
+    IndicatorKernels::rollingVariance(m_close.data(), vector.data(), kBars, 20, Isa::Avx2);
+    for (std::size_t i = 19; i < kBars; ++i)
+        QVERIFY(std::fabs(scalar[i] - vector[i]) < 1e-6);
+
+    IndicatorKernels::trueRange(m_high.data(), m_low.data(), m_close.data(),
+                                scalar.data(), kBars, Isa::Scalar);
+    IndicatorKernels::trueRange(m_high.data(), m_low.data(), m_close.data(),
+                                vector.data(), kBars, Isa::Avx2);
+    QVERIFY(scalar == vector);
+}
+
+void IndicatorKernelBenchmarks::addIsaRows()
+{
+    QTest::addColumn<int>("isa");
+    QTest::newRow("scalar") << static_cast<int>(Isa::Scalar);
+    if (IndicatorKernels::detectedIsa() == Isa::Avx2)
+        QTest::newRow("avx2") << static_cast<int>(Isa::Avx2);
+}
+
+void IndicatorKernelBenchmarks::bench_movingAverage_data()
+{
+    addIsaRows();
+}
+
+void IndicatorKernelBenchmarks::bench_movingAverage()
+{
+    QFETCH(int, isa);
+    QBENCHMARK {
+        IndicatorKernels::movingAverage(m_close.data(), m_out.data(), kBars, 20,
+                                        static_cast<Isa>(isa));
+    }
+}
+
+void IndicatorKernelBenchmarks::bench_rollingVariance_data()
+{
+    addIsaRows();
+}
+
+void IndicatorKernelBenchmarks::bench_rollingVariance()
+{
+    QFETCH(int, isa);
+    QBENCHMARK {
+        IndicatorKernels::rollingVariance(m_close.data(), m_out.data(), kBars, 20,
+                                          static_cast<Isa>(isa));
+    }
+}
+
+void IndicatorKernelBenchmarks::bench_trueRange_data()
+{
+    addIsaRows();
+}
+
+void IndicatorKernelBenchmarks::bench_trueRange()
+{
+    QFETCH(int, isa);
+    QBENCHMARK {
+        IndicatorKernels::trueRange(m_high.data(), m_low.data(), m_close.data(),
+                                    m_out.data(), kBars, static_cast<Isa>(isa));
+    }
+}
+
+void IndicatorKernelBenchmarks::bench_simpleReturns_data()
+{
+    addIsaRows();
+}
+
+void IndicatorKernelBenchmarks::bench_simpleReturns()
+{
+    QFETCH(int, isa);
+    QBENCHMARK {
+        IndicatorKernels::simpleReturns(m_close.data(), m_out.data(), kBars,
+                                        static_cast<Isa>(isa));
+    }
+}
+
+QTEST_MAIN(IndicatorKernelBenchmarks)
+#include "bench_indicatorkernels.moc"
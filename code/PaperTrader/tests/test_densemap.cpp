@@ -0,0 +1,69 @@
+#include <QtTest/QtTest>
+#include <algorithm>
+#include <vector>
+
+#include "core/densemap.h"
+
+class DenseMapTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void test_insertLookupErase();
+    void test_erasedKeysDoNotResolve();
+    void test_iterationIsDense();
+};
+
+void DenseMapTests::test_insertLookupErase()
+{
+    DenseMap<int, int> map;
+    map.insert(1, 10);
+    map.insert(2, 20);
+    map.insert(3, 30);
+    QCOMPARE(map.size(), 3);
+    QCOMPARE(*map.get(2), 20);
+
+    // Erasing from the middle moves the last value into the gap.
+    QVERIFY(map.erase(1));
+    QVERIFY(!map.erase(1));
+    QCOMPARE(map.size(), 2);
+    QCOMPARE(*map.get(2), 20);
+    QCOMPARE(*map.get(3), 30);
+    *map.get(3) = 31;
+    QCOMPARE(*map.get(3), 31);
+}
+
+void DenseMapTests::test_erasedKeysDoNotResolve()
+{
+    DenseMap<int, int> map;
+    map.insert(1, 1);
+    QVERIFY(map.erase(1));
+
+    // The freed position is reused by the next key, not by the old one.
+    map.insert(2, 2);
+    QVERIFY(map.get(1) == nullptr);
+    QVERIFY(!map.contains(1));
+    QCOMPARE(*map.get(2), 2);
+
+    map.insert(2, 3);
+    QCOMPARE(map.size(), 1);
+    QCOMPARE(*map.get(2), 3);
+}
+
+void DenseMapTests::test_iterationIsDense()
+{
+    DenseMap<int, int> map;
+    for (int i = 0; i < 1000; ++i)
+        map.insert(i, i);
+    for (int i = 0; i < 1000; i += 3)
+        QVERIFY(map.erase(i));
+
+    std::vector<int> values(map.begin(), map.end());
+    QCOMPARE(static_cast<int>(values.size()), map.size());
+    std::sort(values.begin(), values.end());
+    QVERIFY(std::none_of(values.begin(), values.end(), [](int v) { return v % 3 == 0; }));
+    for (int i = 1; i < 1000; i += 3)
+        QCOMPARE(*map.get(i), i);
+}
+
+QTEST_MAIN(DenseMapTests)
+#include "test_densemap.moc"
@@ -0,0 +1,172 @@
+#include <QtTest/QtTest>
+#include <cmath>
+#include <vector>
+
+#include "core/exchangesimulator.h"
+
+using Report = ExecutionReport;
+
+class ExchangeSimulatorTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void test_priceTimePriorityAcrossAccounts();
+    void test_immediateOrdersNeverRest();
+    void test_cancelRetiresIds();
+    void test_levelDepthSnapsWithItsOrders();
+};
+
+namespace {
+
+ExchangeSimulator::NewOrder limit(int account, int symbol, OrderSide side, double price, double quantity)
+{
+    ExchangeSimulator::NewOrder order;
+    order.account = account;
+    order.symbol = symbol;
+    order.side = side;
+    order.price = price;
+    order.quantity = quantity;
+    return order;
+}
+
+} // namespace
+
+void ExchangeSimulatorTests::test_priceTimePriorityAcrossAccounts()
+{
+    ExchangeSimulator exchange;
+    const int sym = exchange.listSymbol("btcusdt");
+    QCOMPARE(exchange.listSymbol("BTCUSDT"), sym);
+
+    std::vector<Report> reports;
+    const quint64 first = exchange.submit(limit(1, sym, OrderSide::Sell, 101.0, 5.0), reports);
+    const quint64 second = exchange.submit(limit(2, sym, OrderSide::Sell, 101.0, 5.0), reports);
+    const quint64 better = exchange.submit(limit(3, sym, OrderSide::Sell, 100.5, 2.0), reports);
+    exchange.submit(limit(4, sym, OrderSide::Buy, 99.0, 1.0), reports);
+    QVERIFY(reports.empty());
+    QCOMPARE(exchange.restingCount(), 4);
+    QCOMPARE(exchange.bestAsk(sym), 100.5);
+    QCOMPARE(exchange.bestBid(sym), 99.0);
+
+    // The better price trades first, then the older order at 101; the
+    // taker is filled at each resting price and nothing is left over.
+    const quint64 taker = exchange.submit(limit(9, sym, OrderSide::Buy, 101.0, 7.0), reports);
+    QCOMPARE(reports.size(), size_t(4));
+    QCOMPARE(reports[0].orderId, taker);
+    QCOMPARE(reports[0].counterOrderId, better);
+    QCOMPARE(reports[0].fillPx, 100.5);
+    QCOMPARE(reports[0].fillQty, 2.0);
+    QCOMPARE(reports[0].status, OrderStatus::PartiallyFilled);
+    QCOMPARE(reports[1].orderId, better);
+    QCOMPARE(reports[1].account, 3);
+    QCOMPARE(reports[1].leavesQty, 0.0);
+    QCOMPARE(reports[1].status, OrderStatus::Filled);
+    QCOMPARE(reports[2].counterOrderId, first);
+    QCOMPARE(reports[2].fillPx, 101.0);
+    QCOMPARE(reports[2].fillQty, 5.0);
+    QCOMPARE(reports[3].orderId, first);
+    QCOMPARE(reports[3].side, OrderSide::Sell);
+
+    // The next buyer reaches the second seller, who keeps 4.
+    reports.clear();
+    exchange.submit(limit(9, sym, OrderSide::Buy, 101.0, 1.0), reports);
+    QCOMPARE(reports.size(), size_t(2));
+    QCOMPARE(reports[1].orderId, second);
+    QCOMPARE(reports[1].leavesQty, 4.0);
+    QCOMPARE(exchange.depthAt(sym, OrderSide::Sell, 101.0), 4.0);
+    QCOMPARE(exchange.restingCount(), 2);
+}
+
+void ExchangeSimulatorTests::test_immediateOrdersNeverRest()
+{
+    ExchangeSimulator exchange;
+    const int sym = exchange.listSymbol("ETHUSDT");
+    std::vector<Report> reports;
+    exchange.submit(limit(1, sym, OrderSide::Buy, 50.0, 3.0), reports);
+    exchange.submit(limit(1, sym, OrderSide::Buy, 49.0, 3.0), reports);
+
+    // FOK for more than the book holds is rejected without trading.
+    ExchangeSimulator::NewOrder fok = limit(2, sym, OrderSide::Sell, 49.0, 7.0);
+    fok.timeInForce = TimeInForce::FOK;
+    QCOMPARE(exchange.submit(fok, reports), quint64(0));
+    QCOMPARE(reports.size(), size_t(1));
+    QCOMPARE(reports[0].status, OrderStatus::Rejected);
+    QCOMPARE(reports[0].reason, RejectReason::Unfillable);
+    QCOMPARE(exchange.restingCount(), 2);
+
+    // IOC takes what crosses and cancels the rest.
+    reports.clear();
+    ExchangeSimulator::NewOrder ioc = limit(2, sym, OrderSide::Sell, 50.0, 5.0);
+    ioc.timeInForce = TimeInForce::IOC;
+    exchange.submit(ioc, reports);
+    QCOMPARE(reports.size(), size_t(3));
+    QCOMPARE(reports[0].fillQty, 3.0);
+    QCOMPARE(reports[2].status, OrderStatus::Cancelled);
+    QCOMPARE(exchange.bestBid(sym), 49.0);
+
+    // A market order sweeps levels and never rests.
+    reports.clear();
+    ExchangeSimulator::NewOrder market = limit(2, sym, OrderSide::Sell, 0.0, 4.0);
+    market.type = OrderType::Market;
+    exchange.submit(market, reports);
+    QCOMPARE(reports[0].fillPx, 49.0);
+    QCOMPARE(reports.back().status, OrderStatus::Cancelled);
+    QCOMPARE(exchange.restingCount(), 0);
+    QCOMPARE(exchange.bestBid(sym), 0.0);
+
+    reports.clear();
+    ExchangeSimulator::NewOrder stop = limit(2, sym, OrderSide::Sell, 10.0, 1.0);
+    stop.type = OrderType::Stop;
+    QCOMPARE(exchange.submit(stop, reports), quint64(0));
+    QCOMPARE(reports[0].reason, RejectReason::InvalidPrice);
+}
+
+void ExchangeSimulatorTests::test_cancelRetiresIds()
+{
+    ExchangeSimulator exchange;
+    const int sym = exchange.listSymbol("EURUSD");
+    std::vector<Report> reports;
+
+    const quint64 a = exchange.submit(limit(1, sym, OrderSide::Buy, 1.10, 1.0), reports);
+    const quint64 b = exchange.submit(limit(1, sym, OrderSide::Buy, 1.10, 2.0), reports);
+    QVERIFY(exchange.cancel(a, reports));
+    QVERIFY(!exchange.cancel(a, reports));
+    QCOMPARE(reports.size(), size_t(1));
+    QCOMPARE(exchange.depthAt(sym, OrderSide::Buy, 1.10), 2.0);
+
+    // The freed slot is reused under an id the old one cannot reach.
+    const quint64 c = exchange.submit(limit(1, sym, OrderSide::Buy, 1.09, 1.0), reports);
+    QVERIFY(c != a);
+    QVERIFY(!exchange.cancel(a, reports));
+    QVERIFY(exchange.cancel(b, reports));
+    QVERIFY(exchange.cancel(c, reports));
+    QCOMPARE(exchange.restingCount(), 0);
+    QCOMPARE(exchange.bestBid(sym), 0.0);
+}
+
+void ExchangeSimulatorTests::test_levelDepthSnapsWithItsOrders()
+{
+    ExchangeSimulator exchange;
+    const int sym = exchange.listSymbol("XAUUSD");
+    std::vector<Report> reports;
+
+    // Seven 0.1 lots leave about 3e-17 of the 0.7 maker; once it is snapped
+    // out, the level holds what the order behind it does.
+    exchange.submit(limit(1, sym, OrderSide::Sell, 2000.0, 0.7), reports);
+    exchange.submit(limit(2, sym, OrderSide::Sell, 2000.0, 1.0), reports);
+    for (int i = 0; i < 7; ++i)
+        exchange.submit(limit(3, sym, OrderSide::Buy, 2000.0, 0.1), reports);
+    QCOMPARE(exchange.restingCount(), 1);
+    QVERIFY(std::abs(exchange.depthAt(sym, OrderSide::Sell, 2000.0) - 1.0) < 1e-12);
+
+    reports.clear();
+    ExchangeSimulator::NewOrder fok = limit(3, sym, OrderSide::Buy, 2000.0, 1.0);
+    fok.timeInForce = TimeInForce::FOK;
+    exchange.submit(fok, reports);
+    QCOMPARE(reports.size(), size_t(2));
+    QCOMPARE(reports[0].status, OrderStatus::Filled);
+    QCOMPARE(exchange.restingCount(), 0);
+    QCOMPARE(exchange.bestAsk(sym), 0.0);
+}
+
+QTEST_MAIN(ExchangeSimulatorTests)
+#include "test_exchangesimulator.moc"
@@ -0,0 +1,175 @@
+#include <QtTest/QtTest>
+#include <cmath>
+
+#include "core/indicatorengine.h"
+#include "core/models/candle.h"
+#include "core/models/candlehistory.h"
+
+// Helper macro for readable fuzzy comparisons in assertions.
+#define VERIFY_NEAR(actual, expected, epsilon) \
+    QVERIFY2(std::fabs((actual) - (expected)) <= (epsilon), \
+             qPrintable(QStringLiteral("Expected %1 ≈ %2 (±%3)") \
+                            .arg(QString::number(actual, 'f', 6)) \
+                            .arg(QString::number(expected, 'f', 6)) \
+                            .arg(QString::number(epsilon, 'f', 6))))
+
+class IndicatorTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void test_smaMatchesNaiveWindow();
+    void test_rollingExtremesMatchNaiveWindow();
+    void test_rsiStaysInRange();
+    void test_bulkMatchesLive();
+    void test_prependedHistoryMatchesAppended();
+};
+
+static QVector<Candle> makeCandles(int count)
+{
+    // Deterministic zig-zag walk so the expected values are easy to reproduce.
+    QVector<Candle> candles;
+    candles.reserve(count);
+    double price = 100.0;
+    for (int i = 0; i < count; ++i) {
+        Candle c;
+        c.symbol = "TEST";
+        c.timestamp = QDateTime::fromMSecsSinceEpoch(1700000000000LL + i * 1000LL, Qt::UTC);
+        c.open = price;
+        price += ((i * 7) % 11 - 5) * 0.25;
+        c.close = price;
+        c.high = std::max(c.open, c.close) + 0.3;
+        c.low = std::min(c.open, c.close) - 0.3;
+        c.volume = 50.0 + (i % 13);
+        candles.append(c);
+    }
+    return candles;
+}
+
+void IndicatorTests::test_smaMatchesNaiveWindow()
+{
+    IndicatorEngine engine;
+    const int sma = engine.addIndicator({IndicatorSpec::Kind::SMA, 5});
+    const auto candles = makeCandles(200);
+    for (const Candle &c : candles)
+        engine.append(c);
+
+    QCOMPARE(engine.series(sma).size(), candles.size());
+    QVERIFY(std::isnan(engine.value(sma, 3)));
+    for (int i = 4; i < candles.size(); ++i) {
+        double sum = 0.0;
+        for (int k = 0; k < 5; ++k)
+            sum += candles[i - k].close;
+        VERIFY_NEAR(engine.value(sma, i), sum / 5.0, 1e-9);
+    }
+}
+
+void IndicatorTests::test_rollingExtremesMatchNaiveWindow()
+{
+    IndicatorEngine engine;
+    const int lo = engine.addIndicator({IndicatorSpec::Kind::RollingMin, 7});
+    const int hi = engine.addIndicator({IndicatorSpec::Kind::RollingMax, 7});
+    const auto candles = makeCandles(200);
+    for (const Candle &c : candles)
+        engine.append(c);
+
+    for (int i = 6; i < candles.size(); ++i) {
+        double minLow = candles[i].low;
+        double maxHigh = candles[i].high;
+        for (int k = 1; k < 7; ++k) {
+            minLow = std::min(minLow, candles[i - k].low);
+            maxHigh = std::max(maxHigh, candles[i - k].high);
+        }
+        VERIFY_NEAR(engine.value(lo, i), minLow, 1e-12);
+        VERIFY_NEAR(engine.value(hi, i), maxHigh, 1e-12);
+    }
+}
+
+void IndicatorTests::test_rsiStaysInRange()
+{
+    IndicatorEngine engine;
+    const int rsi = engine.addIndicator({IndicatorSpec::Kind::RSI, 14});
+    for (const Candle &c : makeCandles(300))
+        engine.append(c);
+
+    QVERIFY(std::isnan(engine.value(rsi, 13)));
+    for (int i = 14; i < engine.barCount(); ++i) {
+        const double v = engine.value(rsi, i);
+        QVERIFY(v >= 0.0 && v <= 100.0);
+    }
+}
+
+void IndicatorTests::test_bulkMatchesLive()
+{
+    const auto candles = makeCandles(500);
+
+    IndicatorEngine live;
+    IndicatorEngine bulk;
+    for (IndicatorEngine *engine : {&live, &bulk}) {
+        engine->addIndicator({IndicatorSpec::Kind::EMA, 20});
+        engine->addIndicator({IndicatorSpec::Kind::Bollinger, 20, 2.0});
+        engine->addIndicator({IndicatorSpec::Kind::ATR, 14});
+        engine->addIndicator({IndicatorSpec::Kind::VWAP, 0});
+    }
+
+    for (const Candle &c : candles)
+        live.append(c);
+    bulk.recompute(candles);
+
+    QCOMPARE(live.barCount(), bulk.barCount());
+    for (int id = 0; id < live.indicatorCount(); ++id) {
+        for (int out = 0; out < live.indicator(id)->outputCount(); ++out) {
+            const IndicatorSeries &a = live.series(id, out);
+            const IndicatorSeries &b = bulk.series(id, out);
+            QCOMPARE(a.size(), b.size());
+            for (int i = 0; i < a.size(); ++i) {
+                if (std::isnan(a[i])) {
+                    QVERIFY(std::isnan(b[i]));
+                    continue;
+                }
+                VERIFY_NEAR(a[i], b[i], 1e-12);
+            }
+        }
+    }
+}
+
+void IndicatorTests::test_prependedHistoryMatchesAppended()
+{
+    // Spans several chunks so prepends cross chunk boundaries.
+    const auto candles = makeCandles(10000);
+    const int split = 6100;
+
+    CandleHistory appended;
+    for (const Candle &c : candles)
+        appended.append(c);
+
+    CandleHistory paged;
+    for (int i = split; i < candles.size(); ++i)
+        paged.append(candles[i]);
+    for (int end = split; end > 0; end -= 2500) {
+        const int begin = std::max(0, end - 2500);
+        paged.prepend(CandleColumns::fromCandles(candles.mid(begin, end - begin)), end - begin);
+    }
+
+    QCOMPARE(paged.size(), appended.size());
+    for (int i = 0; i < paged.size(); ++i) {
+        QCOMPARE(paged.time[i], appended.time[i]);
+        QCOMPARE(paged.close[i], appended.close[i]);
+    }
+
+    paged.removeFirst(5000);
+    QCOMPARE(paged.size(), 5000);
+    QCOMPARE(paged.close.first(), appended.close[5000]);
+
+    IndicatorEngine live;
+    IndicatorEngine bulk;
+    const int ema = live.addIndicator({IndicatorSpec::Kind::EMA, 20});
+    bulk.addIndicator({IndicatorSpec::Kind::EMA, 20});
+    for (const Candle &c : candles)
+        live.append(c);
+    bulk.recompute(appended);
+    for (int i = 19; i < candles.size(); ++i)
+        VERIFY_NEAR(bulk.value(ema, i), live.value(ema, i), 1e-12);
+}
+
+QTEST_MAIN(IndicatorTests)
+#include "test_indicators.moc"
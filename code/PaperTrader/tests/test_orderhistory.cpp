@@ -0,0 +1,94 @@
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+#include "core/orderhistory.h"
+
+class OrderHistoryTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void test_pagesSpanDiskAndMemory();
+    void test_keepsEverythingInMemoryWithoutSpillFile();
+};
+
+static Order finishedOrder(int id)
+{
+    Order order;
+    order.id = id;
+    order.symbol = id % 2 ? QStringLiteral("BTCUSDT") : QStringLiteral("ETHUSDT");
+    order.side = id % 3 ? OrderSide::Buy : OrderSide::Sell;
+    order.type = OrderType::StopLimit;
+    order.status = id % 2 ? OrderStatus::Filled : OrderStatus::Cancelled;
+    order.timeInForce = TimeInForce::DAY;
+    order.triggered = true;
+    order.price = 100.0 + id;
+    order.stopPrice = 99.0 + id;
+    order.requestedQuantity = 2.0;
+    order.filledQuantity = id % 2 ? 2.0 : 0.5;
+    order.filledPrice = 100.5 + id;
+    order.fee = 0.01 * id;
+    order.parentId = id - 1;
+    order.timestamp = 1000 * id;
+    return order;
+}
+
+void OrderHistoryTests::test_pagesSpanDiskAndMemory()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    OrderHistory history(4);
+    history.setSpillPath(dir.filePath(QStringLiteral("history.bin")));
+    for (int id = 1; id <= 10; ++id)
+        history.append(finishedOrder(id));
+
+    QCOMPARE(history.size(), 10);
+    QCOMPARE(history.inMemoryCount(), 2);
+
+    // Positions 2..6 come from the file, 8..9 from memory.
+    const QList<Order> middle = history.page(2, 5);
+    QCOMPARE(middle.size(), 5);
+    QCOMPARE(middle.first().id, 3);
+    QCOMPARE(middle.last().id, 7);
+    const QList<Order> tail = history.page(7, 50);
+    QCOMPARE(tail.size(), 3);
+    QCOMPARE(tail.last().id, 10);
+    QVERIFY(history.page(10, 5).isEmpty());
+
+    const Order restored = middle.at(1);
+    const Order original = finishedOrder(4);
+    QCOMPARE(restored.symbol, original.symbol);
+    QVERIFY(restored.side == original.side);
+    QVERIFY(restored.type == original.type);
+    QVERIFY(restored.status == original.status);
+    QVERIFY(restored.timeInForce == original.timeInForce);
+    QVERIFY(restored.triggered);
+    QCOMPARE(restored.price, original.price);
+    QCOMPARE(restored.filledQuantity, original.filledQuantity);
+    QCOMPARE(restored.parentId, original.parentId);
+    QCOMPARE(restored.timestamp, original.timestamp);
+
+    QCOMPARE(history.find(2).value_or(Order{}).id, 2);
+    QCOMPARE(history.find(9).value_or(Order{}).fee, 0.09);
+    QVERIFY(!history.find(42).has_value());
+
+    // Archive order is finish order, not id order.
+    history.append(finishedOrder(12));
+    history.append(finishedOrder(11));
+    QCOMPARE(history.inMemoryCount(), 0);
+    QCOMPARE(history.find(11).value_or(Order{}).fee, 0.11);
+    QCOMPARE(history.find(12).value_or(Order{}).id, 12);
+    QCOMPARE(history.find(6).value_or(Order{}).timestamp, qint64(6000));
+}
+
+void OrderHistoryTests::test_keepsEverythingInMemoryWithoutSpillFile()
+{
+    OrderHistory history(4);
+    for (int id = 1; id <= 10; ++id)
+        history.append(finishedOrder(id));
+    QCOMPARE(history.inMemoryCount(), 10);
+    QCOMPARE(history.page(0, 3).last().id, 3);
+    QCOMPARE(history.find(7).value_or(Order{}).id, 7);
+}
+
+QTEST_MAIN(OrderHistoryTests)
+#include "test_orderhistory.moc"
@@ -0,0 +1,110 @@
+#include <QtTest/QtTest>
+#include <iterator>
+
+#include "core/orderoverlaystore.h"
+
+class OrderOverlayStoreTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void test_limitsInRangeFollowUpserts();
+    void test_fillsStaySortedByTime();
+    void test_hitTestingPicksNearest();
+};
+
+static Order makeLimit(int id, OrderSide side, double price, double quantity = 1.0)
+{
+    Order order;
+    order.id = id;
+    order.symbol = QStringLiteral("BTCUSDT");
+    order.side = side;
+    order.type = OrderType::Limit;
+    order.status = OrderStatus::Open;
+    order.price = price;
+    order.quantity = quantity;
+    order.requestedQuantity = quantity;
+    return order;
+}
+
+static Order makeFill(int id, qint64 ms, double price)
+{
+    Order fill = makeLimit(id, OrderSide::Buy, price);
+    fill.status = OrderStatus::Filled;
+    fill.timestamp = ms;
+    fill.filledPrice = price;
+    fill.filledQuantity = 1.0;
+    return fill;
+}
+
+void OrderOverlayStoreTests::test_limitsInRangeFollowUpserts()
+{
+    OrderOverlayStore store;
+    for (int i = 0; i < 100; ++i)
+        store.upsertOrder(makeLimit(i + 1, i % 2 ? OrderSide::Sell : OrderSide::Buy, 100.0 + i));
+
+    auto range = store.limitsInRange(QStringLiteral("btcusdt"), 110.0, 119.5);
+    QCOMPARE(static_cast<int>(std::distance(range.first, range.second)), 10);
+    QCOMPARE(range.first->second.orderId, 11);
+
+    // Moving an order re-keys it; filling or cancelling drops its line.
+    Order moved = makeLimit(11, OrderSide::Sell, 250.0);
+    store.upsertOrder(moved);
+    Order filled = makeLimit(12, OrderSide::Buy, 111.0);
+    filled.status = OrderStatus::Filled;
+    store.upsertOrder(filled);
+    store.removeOrder(13);
+
+    range = store.limitsInRange(QStringLiteral("BTCUSDT"), 110.0, 119.5);
+    QCOMPARE(static_cast<int>(std::distance(range.first, range.second)), 7);
+    QCOMPARE(store.limitCount(QStringLiteral("BTCUSDT")), 98);
+
+    store.setOrders({makeLimit(500, OrderSide::Buy, 42.0)});
+    QCOMPARE(store.limitCount(QStringLiteral("BTCUSDT")), 1);
+    QVERIFY(store.limitNear(QStringLiteral("BTCUSDT"), 42.0, 0.1) != nullptr);
+}
+
+void OrderOverlayStoreTests::test_fillsStaySortedByTime()
+{
+    OrderOverlayStore store;
+    const qint64 start = 1700000000000LL;
+    for (int i = 0; i < 1000; ++i)
+        store.addFill(makeFill(i, start + i * 1000, 100.0));
+    // A late report lands between its neighbours rather than at the end.
+    store.addFill(makeFill(5000, start + 500500, 101.0));
+
+    const auto range = store.fillsInRange(QStringLiteral("BTCUSDT"), start + 500000, start + 502000);
+    QCOMPARE(static_cast<int>(std::distance(range.first, range.second)), 3);
+    QCOMPARE(std::next(range.first)->orderId, 5000);
+
+    qint64 previous = 0;
+    const auto all = store.fillsInRange(QStringLiteral("BTCUSDT"), 0, start * 2);
+    for (auto it = all.first; it != all.second; ++it) {
+        QVERIFY(it->timeMs >= previous);
+        previous = it->timeMs;
+    }
+    QCOMPARE(store.fillCount(QStringLiteral("BTCUSDT")), 1001);
+}
+
+void OrderOverlayStoreTests::test_hitTestingPicksNearest()
+{
+    OrderOverlayStore store;
+    store.upsertOrder(makeLimit(1, OrderSide::Buy, 100.0));
+    store.upsertOrder(makeLimit(2, OrderSide::Sell, 101.0));
+
+    const LimitOverlay *line = store.limitNear(QStringLiteral("BTCUSDT"), 100.7, 0.5);
+    QVERIFY(line != nullptr);
+    QCOMPARE(line->orderId, 2);
+    QVERIFY(store.limitNear(QStringLiteral("BTCUSDT"), 102.0, 0.5) == nullptr);
+    QVERIFY(store.limitNear(QStringLiteral("ETHUSDT"), 100.0, 0.5) == nullptr);
+
+    store.addFill(makeFill(3, 1000, 99.0));
+    store.addFill(makeFill(4, 1500, 99.6));
+    store.addFill(makeFill(5, 2500, 99.5));
+    const FillOverlay *fill = store.fillNear(QStringLiteral("BTCUSDT"), 1000, 2000, 99.5, 0.2);
+    QVERIFY(fill != nullptr);
+    QCOMPARE(fill->orderId, 4);
+    QVERIFY(store.fillNear(QStringLiteral("BTCUSDT"), 1000, 2000, 98.0, 0.2) == nullptr);
+}
+
+QTEST_MAIN(OrderOverlayStoreTests)
+#include "test_orderoverlaystore.moc"
@@ -0,0 +1,135 @@
+#include <QtTest/QtTest>
+#include <vector>
+
+#include "core/stoptriggerindex.h"
+
+class StopTriggerIndexTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void test_stopsFireOnlyWhenCrossed();
+    void test_trailingGroupsLiftTogether();
+    void test_removeDropsPendingStops();
+    void test_groupsFireByLevelAndReportMoves();
+};
+
+static QList<int> firedIds(const std::vector<StopTriggerIndex::Trigger> &triggered)
+{
+    QList<int> ids;
+    for (const StopTriggerIndex::Trigger &trigger : triggered)
+        ids.append(trigger.orderId);
+    return ids;
+}
+
+void StopTriggerIndexTests::test_stopsFireOnlyWhenCrossed()
+{
+    StopTriggerIndex index;
+    index.addStop(1, OrderSide::Sell, 95.0);
+    index.addStop(2, OrderSide::Sell, 98.0);
+    index.addStop(3, OrderSide::Buy, 105.0);
+    index.addStop(4, OrderSide::Buy, 102.0);
+
+    std::vector<StopTriggerIndex::Trigger> triggered;
+    index.onPrice(100.0, triggered);
+    QVERIFY(triggered.empty());
+
+    // Highest sell stop first, then the next one down.
+    index.onPrice(94.0, triggered);
+    QCOMPARE(firedIds(triggered), QList<int>({2, 1}));
+    QCOMPARE(triggered.front().level, 98.0);
+
+    triggered.clear();
+    index.onPrice(103.0, triggered);
+    QCOMPARE(firedIds(triggered), QList<int>({4}));
+    QCOMPARE(triggered.front().level, 102.0);
+    QCOMPARE(index.size(), 1);
+    QCOMPARE(index.triggerLevel(3), 105.0);
+}
+
+void StopTriggerIndexTests::test_trailingGroupsLiftTogether()
+{
+    StopTriggerIndex index;
+    std::vector<StopTriggerIndex::Trigger> triggered;
+
+    index.addTrailing(1, OrderSide::Sell, 5.0, 100.0);
+    index.onPrice(104.0, triggered);
+    index.addTrailing(2, OrderSide::Sell, 2.0, 102.0);
+    QCOMPARE(index.triggerLevel(1), 99.0);
+    QCOMPARE(index.triggerLevel(2), 100.0);
+
+    // A new high lifts both orders, whatever their age.
+    index.onPrice(110.0, triggered);
+    QVERIFY(triggered.empty());
+    QCOMPARE(index.triggerLevel(1), 105.0);
+    QCOMPARE(index.triggerLevel(2), 108.0);
+
+    index.onPrice(107.0, triggered);
+    QCOMPARE(firedIds(triggered), QList<int>({2}));
+    QCOMPARE(triggered.front().level, 108.0);
+
+    // Buy trailing stops follow the low.
+    triggered.clear();
+    index.addTrailing(3, OrderSide::Buy, 3.0, 107.0);
+    index.onPrice(101.0, triggered);
+    QCOMPARE(firedIds(triggered), QList<int>({1}));
+    QCOMPARE(index.triggerLevel(3), 104.0);
+    triggered.clear();
+    index.onPrice(104.0, triggered);
+    QCOMPARE(firedIds(triggered), QList<int>({3}));
+    QVERIFY(index.isEmpty());
+}
+
+void StopTriggerIndexTests::test_removeDropsPendingStops()
+{
+    StopTriggerIndex index;
+    index.addStop(1, OrderSide::Sell, 95.0);
+    index.addTrailing(2, OrderSide::Sell, 5.0, 100.0);
+    QVERIFY(index.contains(1));
+    QVERIFY(index.remove(1));
+    QVERIFY(index.remove(2));
+    QVERIFY(!index.remove(2));
+
+    std::vector<StopTriggerIndex::Trigger> triggered;
+    index.onPrice(50.0, triggered);
+    QVERIFY(triggered.empty());
+    QVERIFY(index.isEmpty());
+}
+
+void StopTriggerIndexTests::test_groupsFireByLevelAndReportMoves()
+{
+    StopTriggerIndex index;
+    std::vector<StopTriggerIndex::Trigger> triggered;
+    std::vector<StopTriggerIndex::Trigger> moved;
+
+    // Falling marks leave one group per order: peaks 100, 99, ..., 91, each
+    // trailing by 10, except the youngest, which trails by 0.5.
+    for (int i = 0; i < 10; ++i)
+        index.addTrailing(i, OrderSide::Sell, i == 9 ? 0.5 : 10.0, 100.0 - i);
+    QCOMPARE(index.triggerLevel(0), 90.0);
+    QCOMPARE(index.triggerLevel(9), 90.5);
+
+    // The youngest group's level is above the older ones', so it fires first.
+    index.onPrice(90.0, triggered);
+    QCOMPARE(firedIds(triggered).first(), 9);
+    QCOMPARE(firedIds(triggered).size(), 2);
+    QVERIFY(!index.hasMovedLevels());
+
+    // New highs only mark the merged group; its levels are reported once,
+    // at the latest peak.
+    index.onPrice(115.0, triggered);
+    index.onPrice(120.0, triggered);
+    QVERIFY(index.hasMovedLevels());
+    index.takeMovedLevels(moved);
+    QCOMPARE(moved.size(), size_t(8));
+    for (const StopTriggerIndex::Trigger &level : moved)
+        QCOMPARE(level.level, 110.0);
+    QCOMPARE(index.triggerLevel(5), 110.0);
+
+    moved.clear();
+    index.takeMovedLevels(moved);
+    QVERIFY(moved.empty());
+    QVERIFY(!index.hasMovedLevels());
+}
+
+QTEST_MAIN(StopTriggerIndexTests)
+#include "test_stoptriggerindex.moc"
@@ -0,0 +1,155 @@
+#include <QtTest/QtTest>
+
+#include "core/orderhistory.h"
+#include "ui/models/orderhistorymodel.h"
+#include "ui/models/ordersmodel.h"
+#include "ui/models/positionsmodel.h"
+
+class TableModelTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void test_orderDeltasTouchOneRow();
+    void test_filterByStatusAndSymbol();
+    void test_historyLoadsPagesOnDemand();
+    void test_priceTickRepaintsPriceCells();
+};
+
+static Order makeOrder(int id, const QString &symbol, OrderStatus status)
+{
+    Order order;
+    order.id = id;
+    order.symbol = symbol;
+    order.side = OrderSide::Buy;
+    order.type = OrderType::Limit;
+    order.status = status;
+    order.price = 100.0 + id;
+    order.quantity = 1.5;
+    order.requestedQuantity = 1.5;
+    return order;
+}
+
+void TableModelTests::test_orderDeltasTouchOneRow()
+{
+    OrdersModel model;
+    QList<Order> initial;
+    for (int id = 1; id <= 1000; ++id)
+        initial.append(makeOrder(id, QStringLiteral("BTCUSDT"), OrderStatus::Open));
+    model.setOrders(initial);
+    QCOMPARE(model.rowCount(), 1000);
+
+    int insertedAt = -1;
+    int changedFirst = -1;
+    int changedLast = -1;
+    QObject::connect(&model, &QAbstractItemModel::rowsInserted,
+                     [&insertedAt](const QModelIndex &, int first, int) { insertedAt = first; });
+    QObject::connect(&model, &QAbstractItemModel::dataChanged,
+                     [&](const QModelIndex &from, const QModelIndex &to) {
+                         changedFirst = from.row();
+                         changedLast = to.row();
+                     });
+
+    Order filled = makeOrder(500, QStringLiteral("BTCUSDT"), OrderStatus::Filled);
+    model.upsertOrder(filled);
+    QCOMPARE(changedFirst, 499);
+    QCOMPARE(changedLast, 499);
+    QCOMPARE(model.rowCount(), 1000);
+    QCOMPARE(model.data(model.index(499, OrdersModel::Status)).toString(), OrdersModel::statusName(OrderStatus::Filled));
+    QCOMPARE(model.data(model.index(499, OrdersModel::Working)).toString(), QStringLiteral("1.5"));
+
+    model.upsertOrder(makeOrder(1001, QStringLiteral("ETHUSDT"), OrderStatus::Open));
+    QCOMPARE(insertedAt, 1000);
+
+    // Rows after a removed one shift up and keep their id lookup.
+    model.removeOrder(10);
+    QCOMPARE(model.rowCount(), 1000);
+    QCOMPARE(model.rowForId(10), -1);
+    QCOMPARE(model.rowForId(11), 9);
+    QCOMPARE(model.rowForId(1001), 999);
+    QCOMPARE(model.data(model.index(9, OrdersModel::Id), OrdersModel::OrderIdRole).toInt(), 11);
+}
+
+void TableModelTests::test_filterByStatusAndSymbol()
+{
+    OrdersModel model;
+    model.setOrders({makeOrder(1, QStringLiteral("BTCUSDT"), OrderStatus::Open),
+                     makeOrder(2, QStringLiteral("BTCUSDT"), OrderStatus::Filled),
+                     makeOrder(3, QStringLiteral("ETHUSDT"), OrderStatus::Open),
+                     makeOrder(4, QStringLiteral("EURUSD"), OrderStatus::Cancelled)});
+
+    OrdersFilterModel proxy;
+    proxy.setSourceModel(&model);
+    QCOMPARE(proxy.rowCount(), 4);
+
+    proxy.setStatusFilter(OrderStatus::Open);
+    QCOMPARE(proxy.rowCount(), 2);
+    proxy.setSymbolFilter(QStringLiteral(" eth "));
+    QCOMPARE(proxy.rowCount(), 1);
+    QCOMPARE(proxy.data(proxy.index(0, OrdersModel::Id), OrdersModel::OrderIdRole).toInt(), 3);
+
+    proxy.setStatusFilter(std::nullopt);
+    proxy.setSymbolFilter(QStringLiteral("E"));
+    QCOMPARE(proxy.rowCount(), 2);
+}
+
+void TableModelTests::test_historyLoadsPagesOnDemand()
+{
+    OrderHistory history;
+    for (int id = 1; id <= 450; ++id)
+        history.append(makeOrder(id, QStringLiteral("BTCUSDT"), OrderStatus::Filled));
+
+    OrderHistoryModel model;
+    model.setHistory(&history);
+    QCOMPARE(model.rowCount(), 0);
+    QVERIFY(model.canFetchMore(QModelIndex()));
+
+    // Newest page first, then back towards the start.
+    model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), 200);
+    QVERIFY(model.rowForId(450) >= 0);
+    QCOMPARE(model.rowForId(250), -1);
+    model.fetchMore(QModelIndex());
+    model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), 450);
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+
+    // Orders archived later are appended by refresh().
+    history.append(makeOrder(451, QStringLiteral("ETHUSDT"), OrderStatus::Cancelled));
+    model.refresh();
+    QCOMPARE(model.rowCount(), 451);
+    QCOMPARE(model.rowForId(451), 450);
+}
+
+void TableModelTests::test_priceTickRepaintsPriceCells()
+{
+    PositionsModel model;
+    Position btc;
+    btc.symbol = QStringLiteral("BTCUSDT");
+    btc.qty = 2.0;
+    btc.avgPx = 100.0;
+    btc.lastPrice = 100.0;
+    Position eth = btc;
+    eth.symbol = QStringLiteral("ETHUSDT");
+    model.setPositions({btc, eth});
+
+    int firstColumn = -1;
+    QObject::connect(&model, &QAbstractItemModel::dataChanged,
+                     [&firstColumn](const QModelIndex &from, const QModelIndex &) { firstColumn = from.column(); });
+
+    eth.lastPrice = 110.0;
+    eth.unrealizedPnL = 20.0;
+    model.upsertPosition(eth);
+    QCOMPARE(firstColumn, static_cast<int>(PositionsModel::Last));
+    QCOMPARE(model.data(model.index(1, PositionsModel::Unrealized), PositionsModel::SortRole).toDouble(), 20.0);
+
+    eth.qty = 3.0;
+    model.upsertPosition(eth);
+    QCOMPARE(firstColumn, static_cast<int>(PositionsModel::Quantity));
+
+    model.removePosition(QStringLiteral("BTCUSDT"));
+    QCOMPARE(model.rowCount(), 1);
+    QCOMPARE(model.rowForSymbol(QStringLiteral("ETHUSDT")), 0);
+}
+
+QTEST_MAIN(TableModelTests)
+#include "test_tablemodels.moc"
@@ -0,0 +1,97 @@
+#include <QtTest/QtTest>
+#include <algorithm>
+
+#include "core/tickdecimator.h"
+
+class TickDecimatorTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void test_columnsMatchNaiveBuckets();
+    void test_incrementalMatchesRebuild();
+    void test_resolutionChangeDropsColumns();
+};
+
+static TickColumns makeTicks(int count, qint64 startMs = 1700000000000LL)
+{
+    // Irregular spacing (0-9 ms) and a zig-zag price so buckets vary in size.
+    TickColumns ticks;
+    qint64 ms = startMs;
+    double price = 100.0;
+    for (int i = 0; i < count; ++i) {
+        ms += (i * 7) % 10;
+        price += ((i * 13) % 9 - 4) * 0.05;
+        ticks.append(ms, price);
+    }
+    return ticks;
+}
+
+static bool sameColumn(const TickDecimator::Column &a, const TickDecimator::Column &b)
+{
+    return a.index == b.index && a.min == b.min && a.max == b.max
+            && a.first == b.first && a.last == b.last;
+}
+
+void TickDecimatorTests::test_columnsMatchNaiveBuckets()
+{
+    const TickColumns ticks = makeTicks(5000);
+    TickDecimator decimator;
+    decimator.setResolution(25);
+    decimator.rebuild(ticks);
+
+    int column = 0;
+    for (int i = 0; i < ticks.size(); ++column) {
+        const qint64 index = ticks.time[i] / 25;
+        TickDecimator::Column expected{index, ticks.price[i], ticks.price[i],
+                                       ticks.price[i], ticks.price[i]};
+        for (; i < ticks.size() && ticks.time[i] / 25 == index; ++i) {
+            expected.min = std::min(expected.min, ticks.price[i]);
+            expected.max = std::max(expected.max, ticks.price[i]);
+            expected.last = ticks.price[i];
+        }
+        QVERIFY(column < decimator.columns().size());
+        QVERIFY(sameColumn(decimator.columns()[column], expected));
+    }
+    QCOMPARE(decimator.columns().size(), column);
+}
+
+void TickDecimatorTests::test_incrementalMatchesRebuild()
+{
+    const TickColumns all = makeTicks(20000);
+    TickColumns streamed;
+    TickDecimator incremental;
+    incremental.setResolution(40);
+    for (int i = 0; i < all.size(); ++i) {
+        streamed.append(all.time[i], all.price[i]);
+        if (i % 97 == 0)
+            incremental.update(streamed);
+    }
+    incremental.update(streamed);
+
+    TickDecimator bulk;
+    bulk.setResolution(40);
+    bulk.rebuild(all);
+
+    QCOMPARE(incremental.columns().size(), bulk.columns().size());
+    for (int i = 0; i < bulk.columns().size(); ++i)
+        QVERIFY(sameColumn(incremental.columns()[i], bulk.columns()[i]));
+}
+
+void TickDecimatorTests::test_resolutionChangeDropsColumns()
+{
+    const TickColumns ticks = makeTicks(1000);
+    TickDecimator decimator;
+    decimator.setResolution(10);
+    decimator.update(ticks);
+    const int fine = decimator.columns().size();
+
+    QVERIFY(!decimator.setResolution(10));
+    QVERIFY(decimator.setResolution(100));
+    QVERIFY(decimator.columns().isEmpty());
+    decimator.update(ticks);
+    QVERIFY(decimator.columns().size() < fine);
+    QCOMPARE(decimator.lowerBound(decimator.columnOf(ticks.time.first())), 0);
+}
+
+QTEST_MAIN(TickDecimatorTests)
+#include "test_tickdecimator.moc"
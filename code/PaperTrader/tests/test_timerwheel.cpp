@@ -0,0 +1,87 @@
+#include <QtTest/QtTest>
+#include <vector>
+
+#include "core/timerwheel.h"
+
+class TimerWheelTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void test_firesAtDeadlineNotBefore();
+    void test_farDeadlinesCascadeDown();
+    void test_cancelAndReschedule();
+};
+
+void TimerWheelTests::test_firesAtDeadlineNotBefore()
+{
+    TimerWheel wheel(1000, 0);
+    wheel.schedule(1, 2500);
+    wheel.schedule(2, 1000);
+    wheel.schedule(3, 3000);
+
+    std::vector<int> expired;
+    wheel.advance(999, expired);
+    QVERIFY(expired.empty());
+
+    wheel.advance(2999, expired);
+    QCOMPARE(expired, std::vector<int>({2}));
+
+    // 2500 rounds up to the 3000 tick.
+    expired.clear();
+    wheel.advance(3000, expired);
+    QCOMPARE(expired.size(), size_t(2));
+    QVERIFY(wheel.isEmpty());
+}
+
+void TimerWheelTests::test_farDeadlinesCascadeDown()
+{
+    TimerWheel wheel(1000, 0);
+    const qint64 day = 24 * 60 * 60 * 1000;
+    const qint64 year = 365 * day;
+    wheel.schedule(1, day);
+    wheel.schedule(2, 200 * 1000);
+    wheel.schedule(3, 2 * year);   // beyond the top level
+
+    std::vector<int> expired;
+    wheel.advance(day - 1000, expired);
+    QCOMPARE(expired, std::vector<int>({2}));
+
+    wheel.advance(day, expired);
+    QCOMPARE(expired, std::vector<int>({2, 1}));
+
+    wheel.advance(2 * year - 1000, expired);
+    QCOMPARE(expired.size(), size_t(2));
+    wheel.advance(2 * year, expired);
+    QCOMPARE(expired, std::vector<int>({2, 1, 3}));
+
+    // An empty wheel jumps straight to the new time.
+    wheel.advance(10 * year, expired);
+    QCOMPARE(wheel.now(), 10 * year);
+}
+
+void TimerWheelTests::test_cancelAndReschedule()
+{
+    TimerWheel wheel(1000, 0);
+    for (int id = 0; id < 10000; ++id)
+        wheel.schedule(id, 1000 + (id % 500) * 1000);
+    QCOMPARE(wheel.size(), 10000);
+
+    for (int id = 0; id < 10000; id += 2)
+        QVERIFY(wheel.cancel(id));
+    QVERIFY(!wheel.cancel(0));
+    wheel.schedule(1, 5000 * 1000);
+
+    std::vector<int> expired;
+    wheel.advance(500 * 1000, expired);
+    QCOMPARE(expired.size(), size_t(4999));
+    QVERIFY(wheel.contains(1));
+
+    // A deadline already passed fires on the next tick.
+    wheel.schedule(7, 0);
+    expired.clear();
+    wheel.advance(501 * 1000, expired);
+    QCOMPARE(expired, std::vector<int>({7}));
+}
+
+QTEST_MAIN(TimerWheelTests)
+#include "test_timerwheel.moc"
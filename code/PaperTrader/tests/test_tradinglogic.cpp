@@ -7,6 +7,7 @@
 #include "core/models/position.h"
 #include "core/models/portfoliosnapshot.h"
 #include "core/executionsimulator.h"
+#include "core/basketimport.h"
 
 // Helper macro for readable fuzzy comparisons in assertions.
 #define VERIFY_NEAR(actual, expected, epsilon) \
@@ -33,6 +34,17 @@ private slots:
     void test_limitBuyFillsOnCross();
     void test_limitSellFillsOnCross();
     void test_cancelReleasesOrderMargin();
+    void test_orderDeltasTrackOpenOrders();
+    void test_statusTransitionsAreGuarded();
+    void test_ladderFillsCrossedLimitsInPriority();
+    void test_quoteMatchingFillsAtTouch();
+    void test_volumeParticipationCapsBarFills();
+    void test_stopOrdersTriggerAlongCandlePath();
+    void test_timeInForce();
+    void test_bracketExitsCancelEachOther();
+    void test_basketPlacementSharesBuyingPower();
+    void test_amendOrderInPlace();
+    void test_cancelAllByFilter();
     void test_partialFillReducesOrderMargin();
     void test_feeHandlingOnClose();
 };
@@ -49,8 +61,12 @@ static void connectManagers(OrderManager &om, PortfolioManager &pm)
 {
     QObject::connect(&om, &OrderManager::orderFilled,
                      &pm, &PortfolioManager::applyFill);
-    QObject::connect(&om, &OrderManager::ordersChanged,
-                     &pm, &PortfolioManager::onOrdersUpdated);
+    QObject::connect(&om, &OrderManager::orderUpserted,
+                     &pm, &PortfolioManager::onOrderUpserted);
+    QObject::connect(&om, &OrderManager::ordersUpserted,
+                     &pm, &PortfolioManager::onOrdersUpserted);
+    QObject::connect(&om, &OrderManager::orderRemoved,
+                     &pm, &PortfolioManager::onOrderRemoved);
 }
 
 void TradingLogicTests::test_marketBuyLong()
@@ -64,7 +80,7 @@ void TradingLogicTests::test_marketBuyLong()
 
     om.setLastPrice("BTCUSDT", 20000.0);
     auto result = om.placeOrder(OrderManager::OrderType::Market,
-                                "BTCUSDT", "BUY", 1.25, 20000.0);
+                                "BTCUSDT", OrderSide::Buy, 1.25, 20000.0);
 
     QVERIFY(result.accepted);
     QVERIFY(!result.partial);
@@ -94,7 +110,7 @@ void TradingLogicTests::test_marketSellShort()
 
     om.setLastPrice("ABC", 100.0);
     auto result = om.placeOrder(OrderManager::OrderType::Market,
-                                "ABC", "SELL", 0.5, 100.0);
+                                "ABC", OrderSide::Sell, 0.5, 100.0);
 
     QVERIFY(result.accepted);
     QVERIFY(!result.partial);
@@ -121,10 +137,10 @@ void TradingLogicTests::test_longSideFlip()
     connectManagers(om, pm);
 
     om.setLastPrice("XYZ", 100.0);
-    om.placeOrder(OrderManager::OrderType::Market, "XYZ", "BUY", 60.0, 100.0);
+    om.placeOrder(OrderManager::OrderType::Market, "XYZ", OrderSide::Buy, 60.0, 100.0);
 
     om.setLastPrice("XYZ", 110.0);
-    auto flip = om.placeOrder(OrderManager::OrderType::Market, "XYZ", "SELL", 90.0, 110.0);
+    auto flip = om.placeOrder(OrderManager::OrderType::Market, "XYZ", OrderSide::Sell, 90.0, 110.0);
     QVERIFY(flip.accepted);
     QVERIFY(!flip.partial);
 
@@ -150,13 +166,13 @@ void TradingLogicTests::test_shortSideFlip()
     connectManagers(om, pm);
 
     om.setLastPrice("QQQ", 75.0);
-    om.placeOrder(OrderManager::OrderType::Market, "QQQ", "SELL", 50.0, 75.0);
+    om.placeOrder(OrderManager::OrderType::Market, "QQQ", OrderSide::Sell, 50.0, 75.0);
 
     om.setLastPrice("QQQ", 70.0);
-    om.placeOrder(OrderManager::OrderType::Market, "QQQ", "BUY", 20.0, 70.0);
+    om.placeOrder(OrderManager::OrderType::Market, "QQQ", OrderSide::Buy, 20.0, 70.0);
 
     om.setLastPrice("QQQ", 72.0);
-    auto flip = om.placeOrder(OrderManager::OrderType::Market, "QQQ", "BUY", 80.0, 72.0);
+    auto flip = om.placeOrder(OrderManager::OrderType::Market, "QQQ", OrderSide::Buy, 80.0, 72.0);
     QVERIFY(flip.accepted);
     QVERIFY(!flip.partial);
 
@@ -181,9 +197,9 @@ void TradingLogicTests::test_buyRejectedForFunds()
 
     om.setLastPrice("FUNDS", 500000.0);
     auto result = om.placeOrder(OrderManager::OrderType::Market,
-                                "FUNDS", "BUY", 5.0, 500000.0);
+                                "FUNDS", OrderSide::Buy, 5.0, 500000.0);
     QVERIFY(!result.accepted);
-    QCOMPARE(result.errorCode, QStringLiteral("ERR_INSUFFICIENT_FUNDS"));
+    QVERIFY(result.reason == RejectReason::InsufficientFunds);
 }
 
 void TradingLogicTests::test_shortRejectedForMargin()
@@ -194,9 +210,9 @@ void TradingLogicTests::test_shortRejectedForMargin()
 
     om.setLastPrice("MARGIN", 1000.0);
     auto result = om.placeOrder(OrderManager::OrderType::Market,
-                                "MARGIN", "SELL", 400.0, 1000.0);
+                                "MARGIN", OrderSide::Sell, 400.0, 1000.0);
     QVERIFY(!result.accepted);
-    QCOMPARE(result.errorCode, QStringLiteral("ERR_INSUFFICIENT_MARGIN"));
+    QVERIFY(result.reason == RejectReason::InsufficientMargin);
 }
 
 void TradingLogicTests::test_limitBuyRejected()
@@ -206,9 +222,9 @@ void TradingLogicTests::test_limitBuyRejected()
     om.setPortfolioManager(&pm);
 
     auto result = om.placeOrder(OrderManager::OrderType::Limit,
-                                "LIMITBUY", "BUY", 2.0, 75000.0);
+                                "LIMITBUY", OrderSide::Buy, 2.0, 75000.0);
     QVERIFY(!result.accepted);
-    QCOMPARE(result.errorCode, QStringLiteral("ERR_INSUFFICIENT_FUNDS"));
+    QVERIFY(result.reason == RejectReason::InsufficientFunds);
 }
 
 void TradingLogicTests::test_limitShortRejected()
@@ -218,9 +234,9 @@ void TradingLogicTests::test_limitShortRejected()
     om.setPortfolioManager(&pm);
 
     auto result = om.placeOrder(OrderManager::OrderType::Limit,
-                                "LIMITSELL", "SELL", 500.0, 800.0);
+                                "LIMITSELL", OrderSide::Sell, 500.0, 800.0);
     QVERIFY(!result.accepted);
-    QCOMPARE(result.errorCode, QStringLiteral("ERR_INSUFFICIENT_MARGIN"));
+    QVERIFY(result.reason == RejectReason::InsufficientMargin);
 }
 
 void TradingLogicTests::test_limitBuyFillsOnCross()
@@ -236,9 +252,9 @@ void TradingLogicTests::test_limitBuyFillsOnCross()
     exec.setPortfolioManager(&pm);
 
     auto result = om.placeOrder(OrderManager::OrderType::Limit,
-                                "LIMITFILL", "BUY", 2.0, 100.0);
+                                "LIMITFILL", OrderSide::Buy, 2.0, 100.0);
     QVERIFY(result.accepted);
-    QCOMPARE(result.order.status, QStringLiteral("Open"));
+    QVERIFY(result.order.status == OrderStatus::Open);
 
     Candle c;
     c.symbol = "LIMITFILL";
@@ -257,14 +273,9 @@ void TradingLogicTests::test_limitBuyFillsOnCross()
     VERIFY_NEAR(pos.qty, 2.0, 1e-9);
     VERIFY_NEAR(pos.avgPx, 99.5, 1e-6);
 
-    const auto orders = om.orders();
-    for (const Order &o : orders) {
-        if (o.id == result.order.id) {
-            QCOMPARE(o.status, QStringLiteral("Filled"));
-            VERIFY_NEAR(o.filledQuantity, 2.0, 1e-9);
-            break;
-        }
-    }
+    const Order filled = om.order(result.order.id);
+    QVERIFY(filled.status == OrderStatus::Filled);
+    VERIFY_NEAR(filled.filledQuantity, 2.0, 1e-9);
 }
 
 void TradingLogicTests::test_limitSellFillsOnCross()
@@ -280,7 +291,7 @@ void TradingLogicTests::test_limitSellFillsOnCross()
     exec.setPortfolioManager(&pm);
 
     auto result = om.placeOrder(OrderManager::OrderType::Limit,
-                                "LIMITSHORT", "SELL", 1.0, 103.0);
+                                "LIMITSHORT", OrderSide::Sell, 1.0, 103.0);
     QVERIFY(result.accepted);
 
     Candle c;
@@ -302,14 +313,9 @@ void TradingLogicTests::test_limitSellFillsOnCross()
     VERIFY_NEAR(pos.qty, -1.0, 1e-9);
     VERIFY_NEAR(pos.avgPx, 104.0, 1e-6);
 
-    const auto orders = om.orders();
-    for (const Order &o : orders) {
-        if (o.id == result.order.id) {
-            QCOMPARE(o.status, QStringLiteral("Filled"));
-            VERIFY_NEAR(o.filledQuantity, 1.0, 1e-9);
-            break;
-        }
-    }
+    const Order filled = om.order(result.order.id);
+    QVERIFY(filled.status == OrderStatus::Filled);
+    VERIFY_NEAR(filled.filledQuantity, 1.0, 1e-9);
 }
 
 void TradingLogicTests::test_cancelReleasesOrderMargin()
@@ -321,7 +327,7 @@ void TradingLogicTests::test_cancelReleasesOrderMargin()
 
     om.setLastPrice("ORDER", 1000.0);
     auto result = om.placeOrder(OrderManager::OrderType::Limit,
-                                "ORDER", "BUY", 10.0, 1000.0);
+                                "ORDER", OrderSide::Buy, 10.0, 1000.0);
     QVERIFY(result.accepted);
 
     auto snapshot = pm.snapshot();
@@ -332,6 +338,602 @@ void TradingLogicTests::test_cancelReleasesOrderMargin()
     VERIFY_NEAR(snapshot.orderMargin, 0.0, 1e-6);
 }
 
+void TradingLogicTests::test_orderDeltasTrackOpenOrders()
+{
+    PortfolioManager pm;
+    OrderManager om;
+    ExecutionSimulator exec;
+    om.setPortfolioManager(&pm);
+    connectManagers(om, pm);
+    exec.setOrderManager(&om);
+    exec.setPortfolioManager(&pm);
+
+    int upserts = 0;
+    QList<int> removed;
+    QObject::connect(&om, &OrderManager::orderUpserted, [&upserts](const Order &) { ++upserts; });
+    QObject::connect(&om, &OrderManager::orderRemoved, [&removed](int id) { removed.append(id); });
+
+    om.setLastPrice("DELTA", 100.0);
+    const auto near = om.placeOrder(OrderManager::OrderType::Limit, "DELTA", OrderSide::Buy, 2.0, 99.0);
+    const auto far = om.placeOrder(OrderManager::OrderType::Limit, "DELTA", OrderSide::Buy, 1.0, 90.0);
+    QVERIFY(near.accepted && far.accepted);
+    QCOMPARE(upserts, 2);
+    VERIFY_NEAR(pm.snapshot().orderMargin, (2.0 * 99.0 + 90.0) * 1.0004, 1e-6);
+
+    // Only the crossed order fills; the other keeps its reservation.
+    Candle c;
+    c.symbol = "DELTA";
+    c.open = 100.0;
+    c.high = 101.0;
+    c.low = 98.0;
+    c.close = 99.5;
+    exec.onCandle(c);
+    QCOMPARE(upserts, 3);
+    VERIFY_NEAR(pm.snapshot().orderMargin, 90.0 * 1.0004, 1e-6);
+
+    // Finished orders leave the live book for the history.
+    QCOMPARE(removed, QList<int>{near.order.id});
+    QCOMPARE(om.orders().size(), 1);
+    QVERIFY(om.cancelOrder(far.order.id));
+    VERIFY_NEAR(pm.snapshot().orderMargin, 0.0, 1e-9);
+    QCOMPARE(removed, QList<int>({near.order.id, far.order.id}));
+    QVERIFY(om.orders().isEmpty());
+    QCOMPARE(om.history().size(), 2);
+    QVERIFY(om.order(far.order.id).status == OrderStatus::Cancelled);
+    QCOMPARE(om.order(near.order.id).filledQuantity, 2.0);
+}
+
+void TradingLogicTests::test_statusTransitionsAreGuarded()
+{
+    QVERIFY(OrderState::canTransition(OrderStatus::Open, OrderStatus::PartiallyFilled));
+    QVERIFY(OrderState::canTransition(OrderStatus::PartiallyFilled, OrderStatus::Cancelled));
+    QVERIFY(!OrderState::canTransition(OrderStatus::Filled, OrderStatus::Cancelled));
+    QVERIFY(!OrderState::canTransition(OrderStatus::Cancelled, OrderStatus::Open));
+
+    OrderManager om;
+    om.setLastPrice("STATE", 100.0);
+    const auto limit = om.placeOrder(OrderManager::OrderType::Limit, "STATE", OrderSide::Buy, 4.0, 95.0);
+    QVERIFY(limit.accepted);
+
+    om.applyFill(limit.order.id, 95.0, 1.0);
+    QVERIFY(om.order(limit.order.id).status == OrderStatus::PartiallyFilled);
+    QVERIFY(om.cancelOrder(limit.order.id));
+    QVERIFY(!om.cancelOrder(limit.order.id));
+
+    // A cancelled order ignores late fills.
+    om.applyFill(limit.order.id, 95.0, 3.0);
+    const Order cancelled = om.order(limit.order.id);
+    QVERIFY(cancelled.status == OrderStatus::Cancelled);
+    VERIFY_NEAR(cancelled.filledQuantity, 1.0, 1e-9);
+
+    const auto market = om.placeOrder(OrderManager::OrderType::Market, "STATE", OrderSide::Sell, 1.0);
+    QVERIFY(market.order.status == OrderStatus::Filled);
+    QVERIFY(!om.cancelOrder(market.order.id));
+}
+
+void TradingLogicTests::test_ladderFillsCrossedLimitsInPriority()
+{
+    OrderManager om;
+    ExecutionSimulator exec;
+    exec.setOrderManager(&om);
+
+    QList<int> fillOrder;
+    QObject::connect(&om, &OrderManager::orderFilled,
+                     [&fillOrder](const Order &fill) { fillOrder.append(fill.id); });
+
+    // 100 bids from 1 to 100 and 100 offers from 201 to 300, plus a second
+    // bid at 99 that queues behind the first.
+    for (int i = 1; i <= 100; ++i) {
+        om.placeOrder(OrderManager::OrderType::Limit, "LADDER", OrderSide::Buy, 1.0, i);
+        om.placeOrder(OrderManager::OrderType::Limit, "LADDER", OrderSide::Sell, 1.0, 200.0 + i);
+    }
+    const int lateBid = om.placeOrder(OrderManager::OrderType::Limit, "LADDER", OrderSide::Buy, 1.0, 99.0).order.id;
+    om.placeOrder(OrderManager::OrderType::Limit, "OTHER", OrderSide::Buy, 1.0, 500.0);
+    QCOMPARE(exec.restingOrderCount(), 202);
+
+    Candle c;
+    c.symbol = "ladder";
+    c.open = 150.0;
+    c.high = 202.0;
+    c.low = 98.5;
+    c.close = 150.0;
+    exec.onCandle(c);
+
+    // Bids at 100, 99, 99 (late) then offers at 201, 202.
+    QCOMPARE(fillOrder.size(), 5);
+    QCOMPARE(fillOrder.at(0), 199);
+    QCOMPARE(fillOrder.at(1), 197);
+    QCOMPARE(fillOrder.at(2), lateBid);
+    QCOMPARE(fillOrder.at(3), 2);
+    QCOMPARE(fillOrder.at(4), 4);
+    QCOMPARE(exec.restingOrderCount(), 197);
+
+    // Cancelling takes an order off the ladder.
+    QVERIFY(om.cancelOrder(1));
+    QCOMPARE(exec.restingOrderCount(), 196);
+}
+
+void TradingLogicTests::test_quoteMatchingFillsAtTouch()
+{
+    OrderManager om;
+    ExecutionSimulator exec;
+    exec.setOrderManager(&om);
+    exec.setMatchMode(ExecutionSimulator::MatchMode::Quote);
+
+    QList<Order> fills;
+    QObject::connect(&om, &OrderManager::orderFilled,
+                     [&fills](const Order &fill) { fills.append(fill); });
+
+    const int bid100 = om.placeOrder(OrderManager::OrderType::Limit, "TOUCH", OrderSide::Buy, 1.0, 100.0).order.id;
+    const int bid99 = om.placeOrder(OrderManager::OrderType::Limit, "TOUCH", OrderSide::Buy, 1.0, 99.0).order.id;
+    const int ask105 = om.placeOrder(OrderManager::OrderType::Limit, "TOUCH", OrderSide::Sell, 1.0, 105.0).order.id;
+
+    // Candles no longer match the ladder in quote mode.
+    Candle c;
+    c.symbol = "TOUCH";
+    c.open = c.high = c.low = c.close = 90.0;
+    exec.onCandle(c);
+    QVERIFY(fills.isEmpty());
+
+    Quote quote;
+    quote.symbol = "touch";
+    quote.bid = 99.0;
+    quote.ask = 100.5;
+    exec.onQuote(quote);
+    QVERIFY(fills.isEmpty());
+
+    // The ask reaching a limit fills it at the ask; deeper bids wait.
+    quote.ask = 99.5;
+    exec.onQuote(quote);
+    QCOMPARE(fills.size(), 1);
+    QCOMPARE(fills.at(0).id, bid100);
+    VERIFY_NEAR(fills.at(0).filledPrice, 99.5, 1e-9);
+
+    quote.bid = 106.0;
+    quote.ask = 98.0;
+    exec.onQuote(quote);
+    QCOMPARE(fills.size(), 3);
+    QCOMPARE(fills.at(1).id, bid99);
+    VERIFY_NEAR(fills.at(1).filledPrice, 98.0, 1e-9);
+    QCOMPARE(fills.at(2).id, ask105);
+    VERIFY_NEAR(fills.at(2).filledPrice, 106.0, 1e-9);
+    QCOMPARE(exec.restingOrderCount(), 0);
+}
+
+void TradingLogicTests::test_volumeParticipationCapsBarFills()
+{
+    OrderManager om;
+    ExecutionSimulator exec;
+    exec.setOrderManager(&om);
+    exec.setVolumeParticipation(0.1);
+
+    const int first = om.placeOrder(OrderManager::OrderType::Limit, "VOL", OrderSide::Buy, 6.0, 100.0).order.id;
+    const int second = om.placeOrder(OrderManager::OrderType::Limit, "VOL", OrderSide::Buy, 6.0, 99.0).order.id;
+    const int offer = om.placeOrder(OrderManager::OrderType::Limit, "VOL", OrderSide::Sell, 3.0, 101.0).order.id;
+
+    // 10% of 100 lets 10 units trade on each side: the better bid fills
+    // in full, the next gets the remaining 4, the offer fills in full.
+    Candle c;
+    c.symbol = "VOL";
+    c.open = 100.0;
+    c.high = 101.0;
+    c.low = 98.0;
+    c.close = 100.0;
+    c.volume = 100.0;
+    exec.onCandle(c);
+
+    QCOMPARE(om.order(first).status, OrderStatus::Filled);
+    QCOMPARE(om.order(offer).status, OrderStatus::Filled);
+    const Order partial = om.order(second);
+    QCOMPARE(partial.status, OrderStatus::PartiallyFilled);
+    VERIFY_NEAR(partial.quantity, 2.0, 1e-9);
+    QCOMPARE(exec.restingOrderCount(), 1);
+
+    // The remainder carries to the next bar; a bar without volume fills nothing.
+    c.volume = 0.0;
+    exec.onCandle(c);
+    QCOMPARE(om.order(second).status, OrderStatus::PartiallyFilled);
+    c.volume = 50.0;
+    exec.onCandle(c);
+    QCOMPARE(om.order(second).status, OrderStatus::Filled);
+    QCOMPARE(exec.restingOrderCount(), 0);
+}
+
+void TradingLogicTests::test_stopOrdersTriggerAlongCandlePath()
+{
+    OrderManager om;
+    qint64 now = 0;
+    om.setClock([&now] { return now; });
+    ExecutionSimulator exec;
+    exec.setOrderManager(&om);
+
+    QHash<int, double> fills;
+    QObject::connect(&om, &OrderManager::orderFilled,
+                     [&fills](const Order &fill) { fills.insert(fill.id, fill.filledPrice); });
+
+    om.setLastPrice("STOP", 100.0);
+    OrderRequest request;
+    request.symbol = "STOP";
+    request.quantity = 1.0;
+
+    request.type = OrderType::Stop;
+    request.side = OrderSide::Sell;
+    request.stopPrice = 95.0;
+    const int sellStop = om.placeOrder(request).order.id;
+
+    request.type = OrderType::StopLimit;
+    request.side = OrderSide::Buy;
+    request.stopPrice = 104.0;
+    request.price = 103.0;
+    const int buyStopLimit = om.placeOrder(request).order.id;
+
+    request.type = OrderType::TrailingStop;
+    request.side = OrderSide::Sell;
+    request.stopPrice = 0.0;
+    request.price = 0.0;
+    request.trailAmount = 3.0;
+    const auto trailing = om.placeOrder(request);
+    QVERIFY(trailing.accepted);
+    QCOMPARE(trailing.order.stopPrice, 97.0);
+
+    request.trailAmount = 0.0;
+    QCOMPARE(om.placeOrder(request).reason, RejectReason::InvalidPrice);
+    QCOMPARE(exec.pendingStopCount(), 3);
+    QCOMPARE(exec.restingOrderCount(), 0);
+
+    // A new high lifts the trailing stop, and the order shows the new level.
+    om.setLastPrice("STOP", 101.0);
+    QCOMPARE(om.order(trailing.order.id).stopPrice, 98.0);
+    QCOMPARE(exec.pendingStopCount(), 3);
+
+    // Further highs within the publish interval are held back, then sent
+    // as one level.
+    om.setLastPrice("STOP", 101.5);
+    QCOMPARE(om.order(trailing.order.id).stopPrice, 98.0);
+    now += 250;
+    om.setLastPrice("STOP", 101.0);
+    QCOMPARE(om.order(trailing.order.id).stopPrice, 98.5);
+
+    // Up candle: the path runs open 100, low 99, high 105, close 101. The
+    // stop-limit triggers at 104 and its 103 limit fills on the way down; the
+    // trailing stop follows the high to 102 and fires before the close.
+    Candle c;
+    c.symbol = "stop";
+    c.open = 100.0;
+    c.low = 99.0;
+    c.high = 105.0;
+    c.close = 101.0;
+    exec.onCandle(c);
+
+    QVERIFY(!fills.contains(sellStop));
+    VERIFY_NEAR(fills.value(trailing.order.id), 102.0, 1e-9);
+    QVERIFY(om.order(buyStopLimit).triggered);
+    VERIFY_NEAR(fills.value(buyStopLimit), 101.0, 1e-9);
+    QCOMPARE(exec.restingOrderCount(), 0);
+    QCOMPARE(exec.pendingStopCount(), 1);
+
+    // A tick through the sell stop fills it at the tick.
+    om.setLastPrice("STOP", 94.0);
+    VERIFY_NEAR(fills.value(sellStop), 94.0, 1e-9);
+    QCOMPARE(exec.pendingStopCount(), 0);
+}
+
+void TradingLogicTests::test_timeInForce()
+{
+    PortfolioManager pm;
+    OrderManager om;
+    qint64 now = 0;
+    om.setClock([&now] { return now; });
+    om.setPortfolioManager(&pm);
+    connectManagers(om, pm);
+    om.setLastPrice("TIF", 100.0);
+
+    OrderRequest request;
+    request.type = OrderType::Limit;
+    request.symbol = "TIF";
+    request.side = OrderSide::Buy;
+    request.quantity = 1.0;
+
+    // IOC/FOK limits execute against the last price or not at all.
+    request.timeInForce = TimeInForce::IOC;
+    request.price = 99.0;
+    auto result = om.placeOrder(request);
+    QVERIFY(!result.accepted);
+    QCOMPARE(result.reason, RejectReason::Unfillable);
+
+    request.price = 101.0;
+    result = om.placeOrder(request);
+    QVERIFY(result.accepted);
+    QVERIFY(result.order.status == OrderStatus::Filled);
+    VERIFY_NEAR(result.order.filledPrice, 100.0, 1e-9);
+
+    // FOK refuses a fill the account can only partly fund.
+    request.timeInForce = TimeInForce::FOK;
+    request.quantity = 2000.0;
+    result = om.placeOrder(request);
+    QCOMPARE(result.reason, RejectReason::Unfillable);
+    QCOMPARE(pm.positions().first().qty, 1.0);
+
+    // GTD and DAY orders rest until their deadline.
+    request.quantity = 1.0;
+    request.price = 90.0;
+    request.timeInForce = TimeInForce::GTD;
+    request.expiresAt = 0;
+    QCOMPARE(om.placeOrder(request).reason, RejectReason::InvalidTimeInForce);
+    request.expiresAt = 5000;
+    const int gtd = om.placeOrder(request).order.id;
+    request.timeInForce = TimeInForce::DAY;
+    const auto day = om.placeOrder(request);
+    QCOMPARE(day.order.expiresAt, qint64(24 * 60 * 60 * 1000));
+    QCOMPARE(om.pendingExpiryCount(), 2);
+    const double reserved = pm.snapshot().orderMargin;
+    QVERIFY(reserved > 180.0);
+
+    // The app's timer advances the wheel on the manager's own clock.
+    now = 4999;
+    om.advanceClock(om.currentTime());
+    QVERIFY(om.order(gtd).status == OrderStatus::Open);
+    now = 5000;
+    om.advanceClock(om.currentTime());
+    QVERIFY(om.order(gtd).status == OrderStatus::Cancelled);
+    QCOMPARE(om.order(gtd).rejectReason, RejectReason::Expired);
+    VERIFY_NEAR(pm.snapshot().orderMargin, reserved / 2.0, 1e-9);
+
+    // Cancelling by hand takes the order off the wheel.
+    QVERIFY(om.cancelOrder(day.order.id));
+    QCOMPARE(om.pendingExpiryCount(), 0);
+}
+
+void TradingLogicTests::test_bracketExitsCancelEachOther()
+{
+    PortfolioManager pm;
+    OrderManager om;
+    om.setPortfolioManager(&pm);
+    connectManagers(om, pm);
+    ExecutionSimulator exec;
+    exec.setOrderManager(&om);
+    om.setLastPrice("BRKT", 100.0);
+
+    QList<QList<Order>> batches;
+    QObject::connect(&om, &OrderManager::ordersUpserted,
+                     [&batches](const QList<Order> &orders) { batches.append(orders); });
+
+    OrderRequest entry;
+    entry.type = OrderType::Limit;
+    entry.symbol = "BRKT";
+    entry.side = OrderSide::Buy;
+    entry.quantity = 2.0;
+    entry.price = 99.0;
+    const auto placed = om.placeBracket(entry, 110.0, 95.0);
+    QVERIFY(placed.accepted);
+    QCOMPARE(om.orders().size(), 1);
+
+    // The entry fills; its exits appear as an OCO pair for the filled size.
+    Candle c;
+    c.symbol = "BRKT";
+    c.open = 100.0;
+    c.high = 100.0;
+    c.low = 98.0;
+    c.close = 99.0;
+    exec.onCandle(c);
+    QVERIFY(om.order(placed.order.id).status == OrderStatus::Filled);
+    const QList<Order> orders = om.orders();
+    QCOMPARE(orders.size(), 2);
+    const Order takeProfit = orders.at(0);
+    const Order stopLoss = orders.at(1);
+    QCOMPARE(takeProfit.parentId, placed.order.id);
+    QVERIFY(takeProfit.type == OrderType::Limit);
+    QVERIFY(stopLoss.type == OrderType::Stop);
+    QVERIFY(stopLoss.side == OrderSide::Sell);
+    QCOMPARE(stopLoss.quantity, 2.0);
+    QCOMPARE(om.ocoGroup(takeProfit.ocoGroupId), QVector<int>({takeProfit.id, stopLoss.id}));
+
+    // The take-profit fills and the stop-loss is cancelled in the same batch.
+    c.open = 105.0;
+    c.high = 111.0;
+    c.low = 104.0;
+    c.close = 108.0;
+    exec.onCandle(c);
+    QVERIFY(om.order(takeProfit.id).status == OrderStatus::Filled);
+    QVERIFY(om.order(stopLoss.id).status == OrderStatus::Cancelled);
+    QCOMPARE(batches.size(), 1);
+    QCOMPARE(batches.first().size(), 2);
+    QVERIFY(om.ocoGroup(takeProfit.ocoGroupId).isEmpty());
+    QCOMPARE(exec.pendingStopCount(), 0);
+    QVERIFY(pm.positions().isEmpty() || qFuzzyIsNull(pm.positions().first().qty));
+
+    // A plain OCO pair: cancelling one leg leaves the other working.
+    OrderRequest low = entry;
+    low.quantity = 1.0;
+    low.price = 90.0;
+    OrderRequest high = low;
+    high.price = 91.0;
+    const int group = om.placeOco(low, high);
+    QVERIFY(group != 0);
+    const QVector<int> members = om.ocoGroup(group);
+    QVERIFY(om.cancelOrder(members.first()));
+    QVERIFY(om.ocoGroup(group).isEmpty());
+    QVERIFY(om.order(members.last()).status == OrderStatus::Open);
+
+    // A marketable first leg settles the pair before the second is placed.
+    const int openBefore = om.orders().size();
+    OrderRequest marketable = low;
+    marketable.type = OrderType::Market;
+    marketable.price = 0.0;
+    const int settled = om.placeOco(marketable, high);
+    QVERIFY(settled != 0);
+    QCOMPARE(om.orders().size(), openBefore);
+    QVERIFY(om.ocoGroup(settled).isEmpty());
+}
+
+void TradingLogicTests::test_basketPlacementSharesBuyingPower()
+{
+    PortfolioManager pm;
+    OrderManager om;
+    om.setPortfolioManager(&pm);
+    connectManagers(om, pm);
+    om.setLastPrice("BSKA", 110.0);
+    om.setLastPrice("BSKB", 50.0);
+
+    const auto basket = BasketImport::parseCsv(QStringLiteral(
+        "symbol,side,type,quantity,price\n"
+        "bska,buy,limit,600,100\n"
+        "# comment\n"
+        "BSKA,hold,limit,1,100\n"
+        "bskb,buy,market,10\n"
+        "bska,buy,limit,600,100\n"
+        "bskb,sell,limit,5,60,,gtc\n"));
+    QCOMPARE(basket.orders.size(), 4);
+    QCOMPARE(basket.errors, QStringList({"line 4: unknown side"}));
+
+    QList<QList<Order>> batches;
+    QObject::connect(&om, &OrderManager::ordersUpserted,
+                     [&batches](const QList<Order> &orders) { batches.append(orders); });
+    int placedSignals = 0;
+    QObject::connect(&om, &OrderManager::orderPlaced, [&placedSignals] { ++placedSignals; });
+
+    // Alone, each 60k limit fits; once the first and the market buy have
+    // drawn on the same budget the second is cut to what is left.
+    const auto results = om.placeOrders(
+        std::span<const OrderRequest>(basket.orders.constData(), basket.orders.size()));
+    QCOMPARE(results.size(), 4);
+    QVERIFY(results.at(0).accepted);
+    QVERIFY(results.at(1).accepted);
+    QVERIFY(results.at(2).partial);
+    QVERIFY(results.at(2).reason == RejectReason::PartialFill);
+    QVERIFY(results.at(2).order.quantity < 400.0);
+    QVERIFY(results.at(3).accepted);
+    QCOMPARE(results.at(3).order.symbol, QString("BSKB"));
+
+    QCOMPARE(batches.size(), 1);
+    QCOMPARE(batches.first().size(), 4);
+    QCOMPARE(placedSignals, 4);
+    QCOMPARE(om.orders().size(), 3);   // the market buy filled and was archived
+    QCOMPARE(om.history().size(), 1);
+    QCOMPARE(pm.positions().size(), 1);
+    QVERIFY(pm.snapshot().availableFunds < 1.0);
+}
+
+void TradingLogicTests::test_amendOrderInPlace()
+{
+    PortfolioManager pm;
+    OrderManager om;
+    om.setPortfolioManager(&pm);
+    connectManagers(om, pm);
+    ExecutionSimulator exec;
+    exec.setOrderManager(&om);
+    om.setLastPrice("AMND", 100.0);
+
+    const auto placed = om.placeOrder(OrderManager::OrderType::Limit,
+                                      "AMND", OrderSide::Buy, 10.0, 95.0);
+    QVERIFY(placed.accepted);
+    const int id = placed.order.id;
+    const double feeRate = pm.estimateFee(1.0, 1.0);
+
+    QList<Order> upserts;
+    QObject::connect(&om, &OrderManager::orderUpserted,
+                     [&upserts](const Order &order) { upserts.append(order); });
+
+    const auto amended = om.amendOrder(id, 90.0, 20.0);
+    QVERIFY(amended.accepted);
+    QCOMPARE(amended.order.id, id);
+    QCOMPARE(upserts.size(), 1);
+    QCOMPARE(om.orders().size(), 1);
+    QCOMPARE(om.order(id).price, 90.0);
+    QCOMPARE(om.order(id).quantity, 20.0);
+    VERIFY_NEAR(pm.snapshot().orderMargin, 20.0 * 90.0 * (1.0 + feeRate), 1e-6);
+
+    // The simulator moved it down the ladder: 92 no longer crosses.
+    Candle c;
+    c.symbol = "AMND";
+    c.open = 94.0;
+    c.high = 96.0;
+    c.low = 92.0;
+    c.close = 93.0;
+    exec.onCandle(c);
+    QVERIFY(om.order(id).status == OrderStatus::Open);
+    QCOMPARE(exec.restingOrderCount(), 1);
+
+    // Only the extra reservation is checked, and a rejection changes nothing.
+    const auto tooLarge = om.amendOrder(id, 90.0, 5000.0);
+    QVERIFY(!tooLarge.accepted);
+    QVERIFY(tooLarge.reason == RejectReason::InsufficientFunds);
+    QCOMPARE(om.order(id).quantity, 20.0);
+    QVERIFY(om.amendOrder(id, 90.0, 1000.0).accepted);
+
+    // A partly filled order keeps its fills; the new size includes them.
+    om.applyFill(id, 90.0, 400.0);
+    QVERIFY(om.amendOrder(id, 90.0, 400.0).reason == RejectReason::InvalidQuantity);
+    QVERIFY(om.amendOrder(id, 89.0, 500.0).accepted);
+    QCOMPARE(om.order(id).quantity, 100.0);
+    QCOMPARE(om.order(id).filledQuantity, 400.0);
+
+    QVERIFY(om.cancelOrder(id));
+    QVERIFY(om.amendOrder(id, 89.0, 500.0).reason == RejectReason::NotAmendable);
+    QVERIFY(qFuzzyIsNull(pm.snapshot().orderMargin));
+
+    const auto next = om.placeOrder(OrderManager::OrderType::Limit,
+                                    "AMND", OrderSide::Buy, 1.0, 80.0);
+    QCOMPARE(next.order.id, id + 1);
+}
+
+void TradingLogicTests::test_cancelAllByFilter()
+{
+    PortfolioManager pm;
+    OrderManager om;
+    om.setPortfolioManager(&pm);
+    connectManagers(om, pm);
+    om.setLastPrice("MASSA", 100.0);
+    om.setLastPrice("MASSB", 50.0);
+
+    QVector<int> buysA;
+    for (int i = 0; i < 3; ++i) {
+        buysA.append(om.placeOrder(OrderManager::OrderType::Limit,
+                                   "MASSA", OrderSide::Buy, 1.0, 90.0 - i).order.id);
+    }
+    for (int i = 0; i < 2; ++i) {
+        QVERIFY(om.placeOrder(OrderManager::OrderType::Limit,
+                              "MASSA", OrderSide::Sell, 1.0, 110.0 + i).accepted);
+        QVERIFY(om.placeOrder(OrderManager::OrderType::Limit,
+                              "MASSB", OrderSide::Buy, 2.0, 45.0).accepted);
+    }
+    om.applyFill(buysA.at(1), 89.0, 0.5);
+
+    OrderFilter buyA;
+    buyA.symbol = "massa";
+    buyA.side = OrderSide::Buy;
+    QCOMPARE(om.orders(buyA).size(), 3);
+    OrderFilter partial;
+    partial.status = OrderStatus::PartiallyFilled;
+    QCOMPARE(om.orders(partial).size(), 1);
+    QCOMPARE(om.orders(partial).first().id, buysA.at(1));
+
+    QList<QList<Order>> batches;
+    QObject::connect(&om, &OrderManager::ordersUpserted,
+                     [&batches](const QList<Order> &orders) { batches.append(orders); });
+    int snapshots = 0;
+    QObject::connect(&pm, &PortfolioManager::portfolioChanged, [&snapshots] { ++snapshots; });
+
+    // One pass, one batch, one portfolio update.
+    QCOMPARE(om.cancelAll(buyA), 3);
+    QCOMPARE(batches.size(), 1);
+    QCOMPARE(batches.first().size(), 3);
+    QCOMPARE(batches.first().first().id, buysA.first());
+    QCOMPARE(snapshots, 1);
+    QVERIFY(om.orders(buyA).isEmpty());
+    QVERIFY(om.order(buysA.first()).status == OrderStatus::Cancelled);
+
+    OrderFilter cancelled;
+    cancelled.status = OrderStatus::Cancelled;
+    QCOMPARE(om.cancelAll(cancelled), 0);
+    QCOMPARE(om.cancelAll(), 4);
+    QVERIFY(om.orders().isEmpty());
+    QCOMPARE(om.history().size(), 7);
+    QVERIFY(qFuzzyIsNull(pm.snapshot().orderMargin));
+    QCOMPARE(om.cancelAll(), 0);
+    QCOMPARE(batches.size(), 2);
+}
+
 void TradingLogicTests::test_partialFillReducesOrderMargin()
 {
     PortfolioManager pm;
@@ -341,13 +943,13 @@ void TradingLogicTests::test_partialFillReducesOrderMargin()
 
     om.setLastPrice("PARTIAL", 100.0);
     auto result = om.placeOrder(OrderManager::OrderType::Limit,
-                                "PARTIAL", "BUY", 10.0, 100.0);
+                                "PARTIAL", OrderSide::Buy, 10.0, 100.0);
     QVERIFY(result.accepted);
 
     // Simulate a fill of 4 units so only 6 remain working on the order book.
     Order fill;
     fill.symbol = "PARTIAL";
-    fill.side = "BUY";
+    fill.side = OrderSide::Buy;
     fill.price = 100.0;
     fill.filledPrice = 100.0;
     fill.filledQuantity = 4.0;
@@ -357,7 +959,7 @@ void TradingLogicTests::test_partialFillReducesOrderMargin()
 
     Order remaining = result.order;
     remaining.quantity = 6.0;
-    remaining.status = QStringLiteral("Open");
+    remaining.status = OrderStatus::Open;
     pm.onOrdersUpdated({remaining});
 
     const auto snapshot = pm.snapshot();
@@ -372,10 +974,10 @@ void TradingLogicTests::test_feeHandlingOnClose()
     connectManagers(om, pm);
 
     om.setLastPrice("FEE", 100.0);
-    om.placeOrder(OrderManager::OrderType::Market, "FEE", "BUY", 10.0, 100.0);
+    om.placeOrder(OrderManager::OrderType::Market, "FEE", OrderSide::Buy, 10.0, 100.0);
 
     om.setLastPrice("FEE", 80.0);
-    auto exit = om.placeOrder(OrderManager::OrderType::Market, "FEE", "SELL", 10.0, 80.0);
+    auto exit = om.placeOrder(OrderManager::OrderType::Market, "FEE", OrderSide::Sell, 10.0, 80.0);
     QVERIFY(exit.accepted);
     QVERIFY(!exit.partial);
 
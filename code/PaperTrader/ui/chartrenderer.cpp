@@ -0,0 +1,1021 @@
+#include "chartrenderer.h"
+
+#include <QDateTime>
+#include <QFontMetrics>
+#include <QLinearGradient>
+#include <QPainter>
+#include <QPainterPath>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+#include <limits>
+#include <QtGlobal>
+
+#include "core/indicatorengine.h"
+#include "core/orderoverlaystore.h"
+
+namespace {
+constexpr int kPaneGap = 6;
+constexpr int kOverlayHitPx = 4;
+
+const QColor kOverlayColors[] = {
+    QColor(255, 196, 0),
+    QColor(90, 170, 255),
+    QColor(200, 120, 255),
+    QColor(255, 128, 64),
+};
+}
+
+ChartRenderer::ChartRenderer()
+{
+    m_panes.append(Pane{PaneKind::Price, 4});
+    m_panes.append(Pane{PaneKind::Volume, 1});
+    m_panes.append(Pane{PaneKind::Indicator, 1, false});
+}
+
+void ChartRenderer::setBars(const CandleHistory *bars)
+{
+    m_bars = bars;
+    m_scaleDirty = true;
+}
+
+void ChartRenderer::setIndicatorEngine(const IndicatorEngine *engine)
+{
+    m_indicators = engine;
+    m_scaleDirty = true;
+}
+
+void ChartRenderer::setPriceOverlays(const QVector<int> &indicatorIds)
+{
+    m_priceOverlays = indicatorIds;
+    m_scaleDirty = true;
+}
+
+void ChartRenderer::setIndicatorPaneSeries(int indicatorId)
+{
+    m_indicatorPaneId = indicatorId;
+    setPaneVisible(PaneKind::Indicator, indicatorId >= 0);
+    m_scaleDirty = true;
+}
+
+void ChartRenderer::setPaneVisible(PaneKind kind, bool visible)
+{
+    for (Pane &pane : m_panes) {
+        if (pane.kind == kind)
+            pane.visible = visible || kind == PaneKind::Price;
+    }
+}
+
+bool ChartRenderer::isPaneVisible(PaneKind kind) const
+{
+    for (const Pane &pane : m_panes) {
+        if (pane.kind == kind)
+            return pane.visible;
+    }
+    return false;
+}
+
+void ChartRenderer::setOrderOverlays(const OrderOverlayStore *overlays, const QString &symbol)
+{
+    m_orderOverlays = overlays;
+    m_overlaySymbol = symbol;
+}
+
+void ChartRenderer::invalidate()
+{
+    m_scaleDirty = true;
+}
+
+double ChartRenderer::visibleCount(const QRect &bounds, const ChartViewState &view) const
+{
+    const int w = std::max(1, chartRect(bounds).width());
+    return std::max(1.0, w / static_cast<double>(view.pitch()));
+}
+
+void ChartRenderer::render(QPainter &p, const QRect &bounds, const ChartViewState &view)
+{
+    m_view = view;
+    drawBackground(p, bounds);
+    m_frameArea = QRect();
+
+    const int totalCount = total();
+    if (totalCount == 0)
+        return;
+
+    const QRect area = chartRect(bounds);
+    layoutPanes(area);
+
+    int startIdx = 0;
+    int endIdx = 0;
+    visibleRange(bounds, startIdx, endIdx);
+    updatePaneScales(startIdx, endIdx);
+
+    // Autoscale and the time axis use the whole view; bars are only drawn
+    // under the painter's clip, so a tile of an export draws its own slice.
+    int drawStart = startIdx;
+    int drawEnd = endIdx;
+    if (p.hasClipping()) {
+        const QRect clip = p.clipBoundingRect().toAlignedRect();
+        const double pxPitch = m_view.pitch();
+        drawStart = std::max(startIdx, static_cast<int>(std::floor(m_view.viewStart + (clip.left() - area.left()) / pxPitch)) - 2);
+        drawEnd = std::min(endIdx, static_cast<int>(std::ceil(m_view.viewStart + (clip.right() - area.left()) / pxPitch)) + 2);
+        drawEnd = std::max(drawStart, drawEnd);
+    }
+
+    m_frameArea = area;
+    for (Pane &pane : m_panes) {
+        if (!pane.visible)
+            continue;
+
+        double minV = 0.0;
+        double maxV = 0.0;
+        paneRange(pane, minV, maxV);
+        const QRect &paneArea = pane.rect;
+
+        // Only the price pane follows the user's vertical zoom and pan.
+        const bool price = pane.kind == PaneKind::Price;
+        pane.minValue = minV;
+        pane.yScale = (paneArea.height() / std::max(price ? 1e-6 : 1e-9, maxV - minV))
+                * (price ? m_view.verticalScale : 1.0);
+        pane.yOffset = price ? m_view.verticalPan * paneArea.height() : 0.0;
+
+        switch (pane.kind) {
+        case PaneKind::Price: {
+            const double yScale = pane.yScale;
+            const double yOffset = pane.yOffset;
+
+            drawGridAndAxes(p, paneArea, minV, maxV, yScale, yOffset);
+            drawCandles(p, paneArea, drawStart, drawEnd, minV, maxV, yScale, yOffset);
+
+            if (m_indicators) {
+                p.save();
+                p.setClipRect(paneArea);
+                int colorIndex = 0;
+                for (int id : m_priceOverlays) {
+                    const Indicator *indicator = m_indicators->indicator(id);
+                    if (!indicator)
+                        continue;
+                    const QColor color = kOverlayColors[colorIndex++ % std::size(kOverlayColors)];
+                    for (int out = 0; out < indicator->outputCount(); ++out) {
+                        drawSeries(p, paneArea, indicator->output(out), drawStart, drawEnd,
+                                   minV, yScale, yOffset, color);
+                    }
+                }
+                p.restore();
+            }
+
+            if (m_orderOverlays)
+                drawOrderOverlays(p, paneArea, drawStart, drawEnd, minV, yScale, yOffset);
+            break;
+        }
+        case PaneKind::Volume:
+            drawVolume(p, pane, drawStart, drawEnd);
+            break;
+        case PaneKind::Indicator:
+            drawIndicatorPane(p, pane, drawStart, drawEnd);
+            break;
+        }
+    }
+
+    drawTimeAxis(p, area, startIdx, endIdx);
+
+    if (m_view.showLiveBadge)
+        drawLiveBadge(p, bounds);
+}
+
+qint64 ChartRenderer::tickResolution(const QRect &plot, const ChartViewState &view)
+{
+    return std::max<qint64>(1, view.tickSpanMs / std::max(1, plot.width()));
+}
+
+void ChartRenderer::renderTicks(QPainter &p, const QRect &bounds, const ChartViewState &view,
+                                const TickColumns &ticks, TickDecimator &decimator)
+{
+    m_view = view;
+    m_frameArea = QRect();
+    drawBackground(p, bounds);
+
+    const QRect area = chartRect(bounds);
+    decimator.setResolution(tickResolution(area, view));
+    decimator.update(ticks);
+
+    // Column k of the plot is decimator column firstCol + k.
+    const qint64 lastCol = decimator.columnOf(view.tickRightMs);
+    const qint64 firstCol = lastCol - area.width() + 1;
+    const QVector<TickDecimator::Column> &cols = decimator.columns();
+    const int begin = decimator.lowerBound(firstCol);
+    const int end = decimator.lowerBound(lastCol + 1);
+    if (begin >= end)
+        return;
+
+    double minV = std::numeric_limits<double>::max();
+    double maxV = std::numeric_limits<double>::lowest();
+    for (int i = begin; i < end; ++i) {
+        minV = std::min(minV, cols[i].min);
+        maxV = std::max(maxV, cols[i].max);
+    }
+    if (qFuzzyCompare(minV, maxV)) {
+        minV -= 1.0;
+        maxV += 1.0;
+    }
+    const double yScale = (area.height() / (maxV - minV)) * view.verticalScale;
+    const double yOffset = view.verticalPan * area.height();
+
+    drawGridAndAxes(p, area, minV, maxV, yScale, yOffset);
+
+    // Up to four vertices per pixel column: first, low, high, last.
+    m_linePoints.clear();
+    for (int i = begin; i < end; ++i) {
+        const TickDecimator::Column &col = cols[i];
+        const double x = area.left() + static_cast<double>(col.index - firstCol) + 0.5;
+        m_linePoints.emplace_back(x, priceToY(col.first, minV, area, yScale, yOffset));
+        if (col.min != col.max) {
+            m_linePoints.emplace_back(x, priceToY(col.min, minV, area, yScale, yOffset));
+            m_linePoints.emplace_back(x, priceToY(col.max, minV, area, yScale, yOffset));
+        }
+        m_linePoints.emplace_back(x, priceToY(col.last, minV, area, yScale, yOffset));
+    }
+
+    p.save();
+    p.setClipRect(area);
+    p.setRenderHint(QPainter::Antialiasing, false);
+    p.setPen(QPen(QColor(90, 170, 255), 1));
+    p.drawPolyline(m_linePoints.data(), static_cast<int>(m_linePoints.size()));
+    p.restore();
+
+    // Time labels at fixed pixel steps; the axis is linear in time.
+    p.save();
+    QFont labelFont = m_font;
+    labelFont.setPointSizeF(labelFont.pointSizeF() * 0.9);
+    p.setFont(labelFont);
+    const qint64 resolution = decimator.resolution();
+    const int step = std::max(1, area.width() / 6);
+    for (int x = area.left(); x <= area.right(); x += step) {
+        p.setPen(QColor(255, 255, 255, 30));
+        p.drawLine(x, area.top(), x, area.bottom());
+        const qint64 ms = (firstCol + (x - area.left())) * resolution;
+        QRect textRect(x - 50, area.bottom() + 8, 100, m_margins.bottom() - 16);
+        p.setPen(QColor(200, 210, 230));
+        p.drawText(textRect, Qt::AlignHCenter | Qt::AlignTop,
+                   QDateTime::fromMSecsSinceEpoch(ms).toString("hh:mm:ss"));
+    }
+    p.restore();
+
+    if (view.showLiveBadge)
+        drawLiveBadge(p, bounds);
+}
+
+void ChartRenderer::drawBackground(QPainter &p, const QRect &bounds)
+{
+    QLinearGradient grad(bounds.topLeft(), bounds.bottomLeft());
+    grad.setColorAt(0.0, QColor("#10131b"));
+    grad.setColorAt(1.0, QColor("#07090f"));
+    p.fillRect(bounds, grad);
+}
+
+void ChartRenderer::drawLiveBadge(QPainter &p, const QRect &bounds)
+{
+    p.setRenderHint(QPainter::Antialiasing, true);
+    p.setPen(Qt::NoPen);
+    p.setBrush(QColor(0, 255, 102));
+    QRect badge(bounds.right() - 59, bounds.bottom() - 29, 48, 20);
+    p.drawRoundedRect(badge, 6, 6);
+    p.setPen(Qt::black);
+    p.drawText(badge, Qt::AlignCenter, "LIVE");
+}
+
+QImage ChartRenderer::renderToImage(const QSize &size, const ChartViewState &view)
+{
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter p(&image);
+    p.setFont(m_font);
+    render(p, QRect(QPoint(0, 0), size), view);
+    return image;
+}
+
+QImage ChartRenderer::renderTiled(const QSize &size, const ChartViewState &view, int tileSize) const
+{
+    const QRect bounds(QPoint(0, 0), size);
+
+    // Autoscale once over the whole range; every tile starts from a copy of
+    // this renderer with the scale cache already warm.
+    ChartRenderer prepared(*this);
+    prepared.m_view = view;
+    if (prepared.total() > 0) {
+        int startIdx = 0;
+        int endIdx = 0;
+        prepared.visibleRange(bounds, startIdx, endIdx);
+        prepared.updatePaneScales(startIdx, endIdx);
+    }
+
+    struct Tile {
+        QRect rect;
+        QImage image;
+    };
+    QVector<Tile> tiles;
+    tileSize = std::max(64, tileSize);
+    for (int y = 0; y < size.height(); y += tileSize) {
+        for (int x = 0; x < size.width(); x += tileSize) {
+            tiles.append(Tile{QRect(x, y, std::min(tileSize, size.width() - x),
+                                    std::min(tileSize, size.height() - y)), QImage()});
+        }
+    }
+
+    // Each tile draws the full-size frame through a translated, clipped
+    // painter, so the stitched result matches a single render pixel for pixel.
+    QtConcurrent::blockingMap(tiles, [&prepared, &bounds, &view](Tile &tile) {
+        ChartRenderer renderer(prepared);
+        tile.image = QImage(tile.rect.size(), QImage::Format_ARGB32_Premultiplied);
+        tile.image.fill(Qt::transparent);
+        QPainter p(&tile.image);
+        p.setFont(renderer.m_font);
+        p.translate(-tile.rect.topLeft());
+        p.setClipRect(tile.rect);
+        renderer.render(p, bounds, view);
+    });
+
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter p(&image);
+    for (const Tile &tile : std::as_const(tiles))
+        p.drawImage(tile.rect.topLeft(), tile.image);
+    return image;
+}
+
+void ChartRenderer::visibleRange(const QRect &bounds, int &startIdx, int &endIdx) const
+{
+    const int totalCount = total();
+    startIdx = std::clamp(static_cast<int>(std::floor(m_view.viewStart)), 0, std::max(0, totalCount - 1));
+    endIdx = std::clamp(static_cast<int>(std::ceil(m_view.viewStart + visibleCount(bounds, m_view))),
+                        startIdx + 1, totalCount);
+}
+
+void ChartRenderer::layoutPanes(const QRect &area)
+{
+    int totalStretch = 0;
+    int visibleCount = 0;
+    for (const Pane &pane : m_panes) {
+        if (pane.visible) {
+            totalStretch += pane.stretch;
+            ++visibleCount;
+        }
+    }
+    if (totalStretch <= 0)
+        return;
+
+    const int available = std::max(visibleCount, area.height() - kPaneGap * (visibleCount - 1));
+    int y = area.top();
+    int remaining = available;
+    int placed = 0;
+    for (Pane &pane : m_panes) {
+        if (!pane.visible) {
+            pane.rect = QRect();
+            continue;
+        }
+        ++placed;
+        const int h = (placed == visibleCount)
+                ? remaining
+                : std::max(1, available * pane.stretch / totalStretch);
+        pane.rect = QRect(area.left(), y, area.width(), h);
+        y += h + kPaneGap;
+        remaining -= h;
+    }
+}
+
+QRect ChartRenderer::paneRect(const QRect &bounds, PaneKind kind)
+{
+    layoutPanes(chartRect(bounds));
+    for (const Pane &pane : m_panes) {
+        if (pane.kind == kind && pane.visible && !pane.rect.isNull())
+            return pane.rect;
+    }
+    return chartRect(bounds);
+}
+
+void ChartRenderer::updatePaneScales(int startIdx, int endIdx)
+{
+    if (!m_scaleDirty && startIdx == m_scaleStart && endIdx == m_scaleEnd)
+        return;
+
+    // Bars never change once appended, so a view that only grew on the right
+    // (the usual live-tail case) extends the cached extremes instead of
+    // rescanning the whole visible range.
+    const bool extend = !m_scaleDirty && startIdx == m_scaleStart && endIdx > m_scaleEnd;
+    const int from = extend ? m_scaleEnd : startIdx;
+    if (!extend) {
+        for (Pane &pane : m_panes) {
+            pane.low = std::numeric_limits<double>::max();
+            pane.high = std::numeric_limits<double>::lowest();
+        }
+    }
+
+    // Resolve the series once so the per-bar loop is plain array reads.
+    QVector<const IndicatorSeries *> overlays;
+    QVector<const IndicatorSeries *> lowerSeries;
+    if (m_indicators) {
+        for (int id : m_priceOverlays) {
+            if (const Indicator *indicator = m_indicators->indicator(id)) {
+                for (int out = 0; out < indicator->outputCount(); ++out)
+                    overlays.append(&indicator->output(out));
+            }
+        }
+        if (const Indicator *indicator = m_indicators->indicator(m_indicatorPaneId)) {
+            for (int out = 0; out < indicator->outputCount(); ++out)
+                lowerSeries.append(&indicator->output(out));
+        }
+    }
+
+    Pane *pricePane = nullptr;
+    Pane *volumePane = nullptr;
+    Pane *indicatorPane = nullptr;
+    for (Pane &pane : m_panes) {
+        switch (pane.kind) {
+        case PaneKind::Price:     pricePane = &pane; break;
+        case PaneKind::Volume:    volumePane = &pane; break;
+        case PaneKind::Indicator: indicatorPane = &pane; break;
+        }
+    }
+
+    // One pass over the visible bars feeds every pane's autoscale.
+    const CandleHistory &bars = *m_bars;
+    for (int i = from; i < endIdx; ++i) {
+        pricePane->low = std::min(pricePane->low, bars.low[i]);
+        pricePane->high = std::max(pricePane->high, bars.high[i]);
+        for (const IndicatorSeries *series : overlays) {
+            if (i < series->size() && std::isfinite((*series)[i])) {
+                pricePane->low = std::min(pricePane->low, (*series)[i]);
+                pricePane->high = std::max(pricePane->high, (*series)[i]);
+            }
+        }
+        volumePane->high = std::max(volumePane->high, bars.volume[i]);
+        for (const IndicatorSeries *series : lowerSeries) {
+            if (i < series->size() && std::isfinite((*series)[i])) {
+                indicatorPane->low = std::min(indicatorPane->low, (*series)[i]);
+                indicatorPane->high = std::max(indicatorPane->high, (*series)[i]);
+            }
+        }
+    }
+
+    m_scaleStart = startIdx;
+    m_scaleEnd = endIdx;
+    m_scaleDirty = false;
+}
+
+void ChartRenderer::paneRange(const Pane &pane, double &minValue, double &maxValue) const
+{
+    minValue = pane.low;
+    maxValue = pane.high;
+
+    switch (pane.kind) {
+    case PaneKind::Price:
+        break;
+    case PaneKind::Volume:
+        minValue = 0.0;
+        if (maxValue <= 0.0)
+            maxValue = 1.0;
+        return;
+    case PaneKind::Indicator:
+        if (m_indicators) {
+            const Indicator *indicator = m_indicators->indicator(m_indicatorPaneId);
+            if (indicator && indicator->spec().kind == IndicatorSpec::Kind::RSI) {
+                minValue = 0.0;
+                maxValue = 100.0;
+                return;
+            }
+        }
+        break;
+    }
+
+    if (minValue > maxValue) {
+        minValue = 0.0;
+        maxValue = 1.0;
+    }
+    if (qFuzzyCompare(minValue, maxValue)) {
+        minValue -= 1.0;
+        maxValue += 1.0;
+    }
+}
+
+QRect ChartRenderer::chartRect(const QRect &bounds) const
+{
+    QRect area = bounds;
+    area.adjust(m_margins.left(), m_margins.top(),
+                -m_margins.right(), -m_margins.bottom());
+    if (area.width() <= 0 || area.height() <= 0) {
+        area = QRect(bounds.left() + m_margins.left(), bounds.top() + m_margins.top(), 1, 1);
+    }
+    return area;
+}
+
+void ChartRenderer::drawCandles(QPainter &p, const QRect &area,
+                              int startIdx, int endIdx,
+                              double minP, double maxP,
+                              double yScale, double yOffset)
+{
+    Q_UNUSED(maxP);
+    const int pxPitch = m_view.pitch();
+    const int baseX = area.left();
+    const int maxX = area.right();
+
+    p.setRenderHint(QPainter::Antialiasing, false);
+
+    // Built once per frame; the loop only switches between them.
+    const QColor upColor(0, 214, 143);
+    const QColor downColor(252, 79, 112);
+    const QPen upPen(upColor, 1);
+    const QPen downPen(downColor, 1);
+
+    const CandleHistory &bars = *m_bars;
+    for (int i = startIdx; i < endIdx; ++i) {
+        const double rel = static_cast<double>(i) - m_view.viewStart;
+        const int x = baseX + static_cast<int>(rel * pxPitch);
+        if (x > maxX + m_view.candleWidth)
+            continue;
+
+        const double yO = priceToY(bars.open[i],  minP, area, yScale, yOffset);
+        const double yC = priceToY(bars.close[i], minP, area, yScale, yOffset);
+        const double yH = priceToY(bars.high[i],  minP, area, yScale, yOffset);
+        const double yL = priceToY(bars.low[i],   minP, area, yScale, yOffset);
+
+        const bool up = bars.close[i] >= bars.open[i];
+
+        p.setPen(up ? upPen : downPen);
+        const int midX = x + m_view.candleWidth / 2;
+        p.drawLine(midX, static_cast<int>(yH), midX, static_cast<int>(yL));
+
+        p.setBrush(up ? upColor : downColor);
+        const int bodyTop = static_cast<int>(std::min(yO, yC));
+        int bodyHeight = static_cast<int>(std::fabs(yC - yO));
+        if (bodyHeight < 1) bodyHeight = 1;
+        QRect bodyRect(x, bodyTop, m_view.candleWidth, bodyHeight);
+        bodyRect = bodyRect.intersected(area);
+        p.drawRect(bodyRect);
+    }
+}
+
+void ChartRenderer::drawVolume(QPainter &p, const Pane &pane, int startIdx, int endIdx)
+{
+    double minV = 0.0;
+    double maxV = 0.0;
+    paneRange(pane, minV, maxV);
+    const QRect &area = pane.rect;
+    const double yScale = pane.yScale;
+
+    drawGridAndAxes(p, area, minV, maxV, yScale, 0.0);
+
+    const int pxPitch = m_view.pitch();
+    p.setRenderHint(QPainter::Antialiasing, false);
+    p.setPen(Qt::NoPen);
+    const QColor upColor(0, 214, 143, 120);
+    const QColor downColor(252, 79, 112, 120);
+    const CandleHistory &bars = *m_bars;
+    for (int i = startIdx; i < endIdx; ++i) {
+        const int x = area.left() + static_cast<int>((static_cast<double>(i) - m_view.viewStart) * pxPitch);
+        if (x > area.right())
+            continue;
+        const int barHeight = std::max(1, static_cast<int>(bars.volume[i] * yScale));
+        p.setBrush(bars.close[i] >= bars.open[i] ? upColor : downColor);
+        p.drawRect(QRect(x, area.bottom() - barHeight + 1, m_view.candleWidth, barHeight).intersected(area));
+    }
+}
+
+void ChartRenderer::drawIndicatorPane(QPainter &p, const Pane &pane, int startIdx, int endIdx)
+{
+    double minV = 0.0;
+    double maxV = 0.0;
+    paneRange(pane, minV, maxV);
+    const QRect &area = pane.rect;
+    const double yScale = pane.yScale;
+
+    drawGridAndAxes(p, area, minV, maxV, yScale, 0.0);
+
+    const Indicator *indicator = m_indicators ? m_indicators->indicator(m_indicatorPaneId) : nullptr;
+    if (!indicator)
+        return;
+
+    p.save();
+    p.setClipRect(area);
+    if (indicator->spec().kind == IndicatorSpec::Kind::RSI) {
+        QPen guidePen(QColor(255, 255, 255, 60));
+        guidePen.setStyle(Qt::DotLine);
+        p.setPen(guidePen);
+        for (double level : {30.0, 70.0}) {
+            const int y = static_cast<int>(priceToY(level, minV, area, yScale, 0.0));
+            p.drawLine(area.left(), y, area.right(), y);
+        }
+    }
+    for (int out = 0; out < indicator->outputCount(); ++out) {
+        drawSeries(p, area, indicator->output(out), startIdx, endIdx, minV, yScale, 0.0,
+                   kOverlayColors[out % std::size(kOverlayColors)]);
+    }
+    p.setPen(QColor(200, 210, 230));
+    p.drawText(area.adjusted(6, 4, -6, -4), Qt::AlignLeft | Qt::AlignTop, indicator->name());
+    p.restore();
+}
+
+void ChartRenderer::drawSeries(QPainter &p, const QRect &area, const QVector<double> &series,
+                             int startIdx, int endIdx, double minValue,
+                             double yScale, double yOffset, const QColor &color)
+{
+    const int pxPitch = m_view.pitch();
+    const double half = m_view.candleWidth / 2.0;
+    QPainterPath path;
+    bool penDown = false;
+    const int last = std::min(endIdx, static_cast<int>(series.size()));
+    for (int i = startIdx; i < last; ++i) {
+        const double v = series[i];
+        if (!std::isfinite(v)) {
+            penDown = false;
+            continue;
+        }
+        const QPointF pt(area.left() + (static_cast<double>(i) - m_view.viewStart) * pxPitch + half,
+                         priceToY(v, minValue, area, yScale, yOffset));
+        if (penDown) {
+            path.lineTo(pt);
+        } else {
+            path.moveTo(pt);
+            penDown = true;
+        }
+    }
+
+    p.setRenderHint(QPainter::Antialiasing, true);
+    p.setBrush(Qt::NoBrush);
+    p.setPen(QPen(color, 1.2));
+    p.drawPath(path);
+}
+
+double ChartRenderer::priceToY(double price, double minPrice,
+                             const QRect &area, double yScale, double yOffset) const
+{
+    return area.bottom() - ((price - minPrice) * yScale) - yOffset;
+}
+
+void ChartRenderer::drawGridAndAxes(QPainter &p, const QRect &area,
+                                  double minPrice, double maxPrice,
+                                  double yScale, double yOffset)
+{
+    Q_UNUSED(maxPrice);
+    p.save();
+    p.setRenderHint(QPainter::Antialiasing, false);
+
+    const double visibleMin = minPrice - (yOffset / yScale);
+    const double visibleMax = minPrice + ((area.height() - yOffset) / yScale);
+    const double priceSpan = visibleMax - visibleMin;
+
+    // Short panes get fewer levels so the labels do not collide.
+    const int levels = std::clamp(area.height() / 40, 2, 6);
+    const double priceStep = niceStep(priceSpan / levels);
+    const double firstLevel = std::floor(visibleMin / priceStep) * priceStep;
+
+    QPen gridPen(QColor(255, 255, 255, 30));
+    gridPen.setStyle(Qt::DashLine);
+
+    QFont labelFont = m_font;
+    labelFont.setPointSizeF(labelFont.pointSizeF() * 0.9);
+    p.setFont(labelFont);
+
+    for (double level = firstLevel; level <= visibleMax + priceStep; level += priceStep) {
+        const double y = priceToY(level, minPrice, area, yScale, yOffset);
+        if (y < area.top() - 1 || y > area.bottom() + 1)
+            continue;
+        p.setPen(gridPen);
+        p.drawLine(area.left(), static_cast<int>(y), area.right(), static_cast<int>(y));
+
+        QRect labelRect(area.right() + 8, static_cast<int>(y) - 10,
+                         m_margins.right() - 12, 20);
+        p.setPen(QColor(200, 210, 230));
+        p.drawText(labelRect, Qt::AlignRight | Qt::AlignVCenter,
+                   QString::number(level, 'f', priceStep < 1.0 ? 4 : 2));
+    }
+
+    // pane border
+    p.setPen(QColor(255, 255, 255, 40));
+    p.drawRect(area);
+
+    p.restore();
+}
+
+void ChartRenderer::drawTimeAxis(QPainter &p, const QRect &area, int startIdx, int endIdx)
+{
+    p.save();
+    p.setRenderHint(QPainter::Antialiasing, false);
+
+    QFont labelFont = m_font;
+    labelFont.setPointSizeF(labelFont.pointSizeF() * 0.9);
+    p.setFont(labelFont);
+
+    const int visibleCount = std::max(1, endIdx - startIdx);
+    const int step = std::max(1, visibleCount / 6);
+    const int pxPitch = m_view.pitch();
+    const int baseX = area.left();
+
+    for (int i = startIdx; i < endIdx; i += step) {
+        const double rel = static_cast<double>(i) - m_view.viewStart;
+        const int x = baseX + static_cast<int>(rel * pxPitch);
+        if (x < area.left() || x > area.right())
+            continue;
+
+        // Vertical grid lines run through every pane so they line up.
+        p.setPen(QColor(255, 255, 255, 30));
+        for (const Pane &pane : m_panes) {
+            if (pane.visible && !pane.rect.isNull())
+                p.drawLine(x, pane.rect.top(), x, pane.rect.bottom());
+        }
+
+        const qint64 time = m_bars->time[i];
+        QString text;
+        if (time != 0) {
+            text = QDateTime::fromMSecsSinceEpoch(time).toString("hh:mm:ss");
+        }
+        if (text.isEmpty()) {
+            text = QString::number(i);
+        }
+
+        QRect textRect(x - 50, area.bottom() + 8, 100, m_margins.bottom() - 16);
+        p.setPen(QColor(200, 210, 230));
+        p.drawText(textRect, Qt::AlignHCenter | Qt::AlignTop, text);
+    }
+
+    p.restore();
+}
+
+void ChartRenderer::drawOrderOverlays(QPainter &p, const QRect &area, int startIdx, int endIdx,
+                                      double minPrice, double yScale, double yOffset)
+{
+    const CandleHistory &bars = *m_bars;
+    const QColor buyColor(0, 214, 143);
+    const QColor sellColor(252, 79, 112);
+
+    p.save();
+    p.setClipRect(area);
+    QFont labelFont = m_font;
+    labelFont.setPointSizeF(labelFont.pointSizeF() * 0.85);
+    p.setFont(labelFont);
+
+    // Only lines inside the visible price band are visited.
+    const double visibleMin = minPrice - (yOffset / yScale);
+    const double visibleMax = minPrice + ((area.height() - yOffset) / yScale);
+    const auto limits = m_orderOverlays->limitsInRange(m_overlaySymbol, visibleMin, visibleMax);
+    p.setRenderHint(QPainter::Antialiasing, false);
+    for (auto it = limits.first; it != limits.second; ++it) {
+        const LimitOverlay &line = it->second;
+        const int y = static_cast<int>(priceToY(line.price, minPrice, area, yScale, yOffset));
+        const QColor color = line.buy ? buyColor : sellColor;
+        QPen pen(color, 1);
+        pen.setStyle(Qt::DashLine);
+        p.setPen(pen);
+        p.drawLine(area.left(), y, area.right(), y);
+
+        const QString label = QStringLiteral("%1 %2 @ %3")
+                .arg(line.buy ? QStringLiteral("BUY") : QStringLiteral("SELL"))
+                .arg(line.quantity)
+                .arg(line.price, 0, 'f', 2);
+        QRect labelRect(area.right() - 150, y - 16, 146, 14);
+        p.setPen(color);
+        p.drawText(labelRect, Qt::AlignRight | Qt::AlignBottom, label);
+    }
+
+    // Fills inside the visible bars' time span, walked alongside the bars
+    // (both are time-sorted) so each marker lands on its bar without a search.
+    if (startIdx >= endIdx) {
+        p.restore();
+        return;
+    }
+    const qint64 fromMs = bars.time[startIdx];
+    const qint64 toMs = endIdx < total() ? bars.time[endIdx] : std::numeric_limits<qint64>::max();
+    const auto fills = m_orderOverlays->fillsInRange(m_overlaySymbol, fromMs, toMs);
+    p.setRenderHint(QPainter::Antialiasing, true);
+    p.setPen(Qt::NoPen);
+    const int pxPitch = m_view.pitch();
+    const double half = m_view.candleWidth / 2.0;
+    int bar = startIdx;
+    for (auto it = fills.first; it != fills.second; ++it) {
+        while (bar + 1 < endIdx && bars.time[bar + 1] <= it->timeMs)
+            ++bar;
+        const double x = area.left() + (static_cast<double>(bar) - m_view.viewStart) * pxPitch + half;
+        const double y = priceToY(it->price, minPrice, area, yScale, yOffset);
+        // Buys point up from below the fill price, sells down from above.
+        const double dir = it->buy ? 1.0 : -1.0;
+        const QPointF marker[3] = {
+            QPointF(x, y),
+            QPointF(x - 5.0, y + dir * 8.0),
+            QPointF(x + 5.0, y + dir * 8.0),
+        };
+        p.setBrush(it->buy ? buyColor : sellColor);
+        p.drawPolygon(marker, 3);
+    }
+    p.restore();
+}
+
+ChartRenderer::OverlayHit ChartRenderer::overlayAt(const QPoint &pos) const
+{
+    OverlayHit hit;
+    const Pane *pricePane = paneAt(pos.y());
+    if (!m_orderOverlays || !pricePane || pricePane->kind != PaneKind::Price
+            || !pricePane->rect.contains(pos)) {
+        return hit;
+    }
+
+    const double price = pricePane->minValue
+            + (pricePane->rect.bottom() - pos.y() - pricePane->yOffset) / pricePane->yScale;
+    const double tolerance = kOverlayHitPx / pricePane->yScale;
+
+    // Markers sit on their bar; test the bar under the cursor first.
+    const int bar = barAt(pos.x());
+    if (bar >= 0) {
+        const qint64 fromMs = m_bars->time[bar];
+        const qint64 toMs = bar + 1 < total() ? m_bars->time[bar + 1] : std::numeric_limits<qint64>::max();
+        hit.fill = m_orderOverlays->fillNear(m_overlaySymbol, fromMs, toMs, price,
+                                              (kOverlayHitPx + 8) / pricePane->yScale);
+    }
+    if (!hit.fill)
+        hit.limit = m_orderOverlays->limitNear(m_overlaySymbol, price, tolerance);
+    return hit;
+}
+
+const ChartRenderer::Pane *ChartRenderer::paneAt(int y) const
+{
+    if (m_frameArea.isNull())
+        return nullptr;
+    for (const Pane &pane : m_panes) {
+        if (pane.visible && !pane.rect.isNull() && y >= pane.rect.top() && y <= pane.rect.bottom())
+            return &pane;
+    }
+    return nullptr;
+}
+
+const ChartRenderer::Pane *ChartRenderer::pane(PaneKind kind) const
+{
+    for (const Pane &pane : m_panes) {
+        if (pane.kind == kind && pane.visible && !pane.rect.isNull())
+            return &pane;
+    }
+    return nullptr;
+}
+
+int ChartRenderer::barAt(int x) const
+{
+    if (m_frameArea.isNull() || x < m_frameArea.left() || x > m_frameArea.right())
+        return -1;
+    const int index = static_cast<int>(std::floor(m_view.viewStart
+            + (x - m_frameArea.left()) / static_cast<double>(m_view.pitch())));
+    return (index >= 0 && index < total()) ? index : -1;
+}
+
+int ChartRenderer::barAtTime(qint64 ms) const
+{
+    // Last bar opening at or before ms.
+    int lo = 0;
+    int hi = total();
+    while (lo < hi) {
+        const int mid = lo + (hi - lo) / 2;
+        if (m_bars->time[mid] <= ms)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo - 1;
+}
+
+qint64 ChartRenderer::barTime(int index) const
+{
+    return (index >= 0 && index < total()) ? m_bars->time[index] : 0;
+}
+
+int ChartRenderer::barCenterX(int index) const
+{
+    return m_frameArea.left()
+            + static_cast<int>((static_cast<double>(index) - m_view.viewStart) * m_view.pitch())
+            + m_view.candleWidth / 2;
+}
+
+QRect ChartRenderer::readoutRect() const
+{
+    const Pane *pricePane = pane(PaneKind::Price);
+    if (!pricePane)
+        return QRect();
+    const int lineHeight = QFontMetrics(m_font).height();
+    return QRect(pricePane->rect.left() + 1, pricePane->rect.top() + 1,
+                 pricePane->rect.width() - 2, lineHeight * 2 + 8);
+}
+
+QRegion ChartRenderer::crosshairRegion(const QPoint &pos, int index) const
+{
+    QRegion region;
+    if (m_frameArea.isNull() || index < 0 || index >= total())
+        return region;
+
+    const QRect &area = m_frameArea;
+    const int x = barCenterX(index);
+    region += QRect(x - 1, area.top(), 3, area.height());
+    region += QRect(x - 60, area.bottom() + 1, 120, m_margins.bottom());
+    if (pos.y() >= 0 && paneAt(pos.y())) {
+        region += QRect(area.left(), pos.y() - 1, area.width(), 3);
+        region += QRect(area.right() + 1, pos.y() - 11, m_margins.right(), 22);
+    }
+    region += readoutRect();
+    return region;
+}
+
+void ChartRenderer::drawCrosshair(QPainter &p, const QPoint &pos, int index)
+{
+    if (m_frameArea.isNull() || index < 0 || index >= total())
+        return;
+
+    const QRect &area = m_frameArea;
+    const CandleHistory &bars = *m_bars;
+    const QColor labelBg(40, 46, 60);
+    const QColor textColor(230, 235, 245);
+    QPen linePen(QColor(255, 255, 255, 110), 1);
+    linePen.setStyle(Qt::DashLine);
+
+    p.save();
+    p.setRenderHint(QPainter::Antialiasing, false);
+    QFont labelFont = m_font;
+    labelFont.setPointSizeF(labelFont.pointSizeF() * 0.9);
+    p.setFont(labelFont);
+
+    // Vertical line through every pane, snapped to the bar centre.
+    const int x = barCenterX(index);
+    p.setPen(linePen);
+    p.drawLine(x, area.top(), x, area.bottom());
+
+    const QString timeText = QDateTime::fromMSecsSinceEpoch(bars.time[index]).toString("yyyy-MM-dd hh:mm");
+    const QRect timeRect(x - 60, area.bottom() + 4, 120, 18);
+    p.fillRect(timeRect, labelBg);
+    p.setPen(textColor);
+    p.drawText(timeRect, Qt::AlignCenter, timeText);
+
+    // Horizontal line and the value of whichever pane the cursor is over.
+    if (pos.y() >= 0) {
+        if (const Pane *hovered = paneAt(pos.y())) {
+            const double value = hovered->minValue
+                    + (hovered->rect.bottom() - pos.y() - hovered->yOffset) / hovered->yScale;
+            p.setPen(linePen);
+            p.drawLine(area.left(), pos.y(), area.right(), pos.y());
+            const QRect valueRect(area.right() + 2, pos.y() - 10, m_margins.right() - 4, 20);
+            p.fillRect(valueRect, labelBg);
+            p.setPen(textColor);
+            p.drawText(valueRect, Qt::AlignCenter,
+                       QString::number(value, 'f', std::fabs(value) < 10.0 ? 4 : 2));
+        }
+    }
+
+    // OHLCV on the first line, indicator values at the same bar on the second.
+    const QRect readout = readoutRect();
+    if (!readout.isNull()) {
+        const QString ohlcv = QStringLiteral("O %1  H %2  L %3  C %4  V %5")
+                .arg(bars.open[index], 0, 'f', 2)
+                .arg(bars.high[index], 0, 'f', 2)
+                .arg(bars.low[index], 0, 'f', 2)
+                .arg(bars.close[index], 0, 'f', 2)
+                .arg(bars.volume[index], 0, 'f', 2);
+
+        QString values;
+        if (m_indicators) {
+            QVector<int> ids = m_priceOverlays;
+            if (isPaneVisible(PaneKind::Indicator))
+                ids.append(m_indicatorPaneId);
+            for (int id : ids) {
+                const Indicator *indicator = m_indicators->indicator(id);
+                if (!indicator)
+                    continue;
+                QString text = indicator->name();
+                for (int out = 0; out < indicator->outputCount(); ++out) {
+                    const IndicatorSeries &series = indicator->output(out);
+                    const double v = index < series.size() ? series[index] : std::numeric_limits<double>::quiet_NaN();
+                    text += QLatin1Char(' ') + (std::isfinite(v) ? QString::number(v, 'f', 2) : QStringLiteral("-"));
+                }
+                if (!values.isEmpty())
+                    values += QStringLiteral("   ");
+                values += text;
+            }
+        }
+
+        p.fillRect(readout, QColor(16, 19, 27, 200));
+        p.setPen(textColor);
+        const QRect textArea = readout.adjusted(6, 3, -6, -3);
+        p.drawText(textArea, Qt::AlignLeft | Qt::AlignTop, ohlcv);
+        p.setPen(QColor(200, 210, 230));
+        p.drawText(textArea, Qt::AlignLeft | Qt::AlignBottom, values);
+    }
+    p.restore();
+}
+
+double ChartRenderer::niceStep(double rawStep) const
+{
+    if (rawStep <= 0.0)
+        return 1.0;
+
+    const double exponent = std::floor(std::log10(rawStep));
+    const double fraction = rawStep / std::pow(10.0, exponent);
+    double niceFraction;
+    if (fraction < 1.5) niceFraction = 1.0;
+    else if (fraction < 3.0) niceFraction = 2.0;
+    else if (fraction < 7.0) niceFraction = 5.0;
+    else niceFraction = 10.0;
+    return niceFraction * std::pow(10.0, exponent);
+}
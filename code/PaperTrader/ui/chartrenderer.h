@@ -0,0 +1,159 @@
+#pragma once
+#include <QColor>
+#include <QFont>
+#include <QImage>
+#include <QMargins>
+#include <QRect>
+#include <QRegion>
+#include <QVector>
+#include <QPointF>
+#include <algorithm>
+#include <vector>
+#include "core/models/candlehistory.h"
+#include "core/tickdecimator.h"
+
+class IndicatorEngine;
+class OrderOverlayStore;
+struct FillOverlay;
+struct LimitOverlay;
+class QPainter;
+
+// Horizontal/vertical view parameters shared by every pane of a chart.
+struct ChartViewState {
+    double viewStart = 0.0;      // fractional candle index at the left edge
+    int candleWidth = 6;
+    int spacing = 2;
+    double verticalScale = 1.0;
+    double verticalPan = 0.0;
+    bool showLiveBadge = false;
+    // Tick mode: the window is time-based rather than bar-based.
+    qint64 tickRightMs = 0;      // time at the right edge of the plot
+    qint64 tickSpanMs = 120000;  // time covered by the plot width
+
+    int pitch() const { return std::max(1, candleWidth + spacing); }
+};
+
+/**
+ * ChartRenderer: paints the candle chart and its panes onto any QPainter.
+ *
+ * Has no QWidget dependency, so the same drawing code serves ChartWidget,
+ * offscreen QImage rendering and the headless benchmarks.
+ */
+class ChartRenderer {
+public:
+    enum class PaneKind { Price, Volume, Indicator };
+
+    ChartRenderer();
+
+    // Non-owning; the caller keeps the bars alive while rendering.
+    void setBars(const CandleHistory *bars);
+    void setIndicatorEngine(const IndicatorEngine *engine);
+    void setPriceOverlays(const QVector<int> &indicatorIds);
+    void setIndicatorPaneSeries(int indicatorId);
+    void setPaneVisible(PaneKind kind, bool visible);
+    bool isPaneVisible(PaneKind kind) const;
+    // Limit lines and fill markers of `symbol`, drawn on the price pane.
+    void setOrderOverlays(const OrderOverlayStore *overlays, const QString &symbol);
+
+    void setFont(const QFont &font) { m_font = font; }
+    void setMargins(const QMargins &margins) { m_margins = margins; }
+    QMargins margins() const { return m_margins; }
+
+    // Call when existing bars change (cleared or replaced); appends are
+    // picked up automatically.
+    void invalidate();
+
+    QRect chartRect(const QRect &bounds) const;
+    double visibleCount(const QRect &bounds, const ChartViewState &view) const;
+    QRect paneRect(const QRect &bounds, PaneKind kind);
+
+    void render(QPainter &p, const QRect &bounds, const ChartViewState &view);
+    // Line chart of raw ticks, one decimated column per pixel, so the cost
+    // follows the plot width rather than the tick count.
+    void renderTicks(QPainter &p, const QRect &bounds, const ChartViewState &view,
+                     const TickColumns &ticks, TickDecimator &decimator);
+    static qint64 tickResolution(const QRect &plot, const ChartViewState &view);
+    QImage renderToImage(const QSize &size, const ChartViewState &view);
+    // Same image as renderToImage, rasterised as tiles on the QtConcurrent
+    // pool and stitched. Blocks until done; the bars must not change meanwhile.
+    QImage renderTiled(const QSize &size, const ChartViewState &view, int tileSize = 512) const;
+
+    // Hit-testing against the last rendered candle frame.
+    struct OverlayHit {
+        const LimitOverlay *limit = nullptr;
+        const FillOverlay *fill = nullptr;
+    };
+    OverlayHit overlayAt(const QPoint &pos) const;
+
+    // Crosshair over the last rendered candle frame. Pixel -> bar is plain
+    // arithmetic; time -> bar (aligning charts of other symbols) is a binary
+    // search over the bar times. Both return -1 when there is no such bar.
+    int barAt(int x) const;
+    int barAtTime(qint64 ms) const;
+    qint64 barTime(int index) const;
+    // Pixels touched by drawCrosshair(), so a hover repaints only those.
+    // A negative pos.y() draws the vertical line alone.
+    QRegion crosshairRegion(const QPoint &pos, int index) const;
+    void drawCrosshair(QPainter &p, const QPoint &pos, int index);
+
+private:
+    struct Pane {
+        PaneKind kind = PaneKind::Price;
+        int stretch = 1;
+        bool visible = true;
+        QRect rect;
+        // Raw extremes over the cached visible range (autoscale input).
+        double low = 0.0;
+        double high = 0.0;
+        // Value -> y mapping of the last frame (see priceToY).
+        double minValue = 0.0;
+        double yScale = 1.0;
+        double yOffset = 0.0;
+    };
+
+    int total() const { return m_bars ? m_bars->size() : 0; }
+    void drawBackground(QPainter &p, const QRect &bounds);
+    void drawLiveBadge(QPainter &p, const QRect &bounds);
+    void layoutPanes(const QRect &area);
+    void visibleRange(const QRect &bounds, int &startIdx, int &endIdx) const;
+    void updatePaneScales(int startIdx, int endIdx);
+    void paneRange(const Pane &pane, double &minValue, double &maxValue) const;
+    void drawCandles(QPainter &p, const QRect &area,
+                     int startIdx, int endIdx,
+                     double minPrice, double maxPrice,
+                     double yScale, double yOffset);
+    void drawVolume(QPainter &p, const Pane &pane, int startIdx, int endIdx);
+    const Pane *paneAt(int y) const;
+    const Pane *pane(PaneKind kind) const;
+    int barCenterX(int index) const;
+    QRect readoutRect() const;
+    void drawIndicatorPane(QPainter &p, const Pane &pane, int startIdx, int endIdx);
+    void drawSeries(QPainter &p, const QRect &area, const QVector<double> &series,
+                    int startIdx, int endIdx, double minValue,
+                    double yScale, double yOffset, const QColor &color);
+    void drawGridAndAxes(QPainter &p, const QRect &area,
+                         double minPrice, double maxPrice,
+                         double yScale, double yOffset);
+    void drawTimeAxis(QPainter &p, const QRect &area, int startIdx, int endIdx);
+    void drawOrderOverlays(QPainter &p, const QRect &area, int startIdx, int endIdx,
+                           double minPrice, double yScale, double yOffset);
+    double priceToY(double price, double minPrice,
+                    const QRect &area, double yScale, double yOffset) const;
+    double niceStep(double rawStep) const;
+
+    const CandleHistory *m_bars = nullptr;
+    const IndicatorEngine *m_indicators = nullptr;
+    QVector<Pane> m_panes;
+    QVector<int> m_priceOverlays;
+    int m_indicatorPaneId = -1;
+    int m_scaleStart = -1;
+    int m_scaleEnd = -1;
+    bool m_scaleDirty = true;
+    QMargins m_margins{60, 20, 80, 40};
+    QFont m_font;
+    ChartViewState m_view;   // view of the frame being rendered
+    std::vector<QPointF> m_linePoints;   // reused tick polyline buffer
+    const OrderOverlayStore *m_orderOverlays = nullptr;
+    QString m_overlaySymbol;
+    QRect m_frameArea;   // plot area of the last candle frame; null after a tick frame
+};
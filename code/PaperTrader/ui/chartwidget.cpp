@@ -1,14 +1,15 @@
 #include "chartwidget.h"
 
-#include <QLinearGradient>
 #include <QMouseEvent>
 #include <QPainter>
+#include <QDateTime>
 #include <QResizeEvent>
+#include <QToolTip>
 #include <QWheelEvent>
 #include <algorithm>
-#include <limits>
-#include <cmath>
-#include <QtGlobal>
+
+#include "core/candlestore.h"
+#include "core/orderoverlaystore.h"
 
 Q_LOGGING_CATEGORY(lcChart, "chart")
 
@@ -19,9 +20,106 @@ ChartWidget::ChartWidget(QWidget *parent)
     setMouseTracking(true);
 }
 
-void ChartWidget::appendCandle(const Candle &c)
+void ChartWidget::setSource(CandleStore *store, const QString &symbol)
+{
+    if (m_store && m_store != store)
+        disconnect(m_store, nullptr, this, nullptr);
+
+    m_store = store;
+    m_symbol = CandleStore::key(symbol);
+    m_series = (m_store && !m_symbol.isEmpty()) ? m_store->ensureSeries(m_symbol) : nullptr;
+    m_renderer.setBars(m_series ? &m_series->bars : nullptr);
+    m_renderer.setIndicatorEngine(m_series ? &m_series->indicators : nullptr);
+    m_renderer.setOrderOverlays(m_orderOverlays, m_symbol);
+
+    if (m_store) {
+        connect(m_store, &CandleStore::candleAppended,
+                this, &ChartWidget::onCandleAppended, Qt::UniqueConnection);
+        connect(m_store, &CandleStore::seriesReset,
+                this, &ChartWidget::onSeriesReset, Qt::UniqueConnection);
+        connect(m_store, &CandleStore::tickAppended,
+                this, &ChartWidget::onTickAppended, Qt::UniqueConnection);
+        connect(m_store, &CandleStore::barsPrepended,
+                this, &ChartWidget::onBarsPrepended, Qt::UniqueConnection);
+        connect(m_store, &CandleStore::barsTrimmed,
+                this, &ChartWidget::onBarsTrimmed, Qt::UniqueConnection);
+    }
+    resetView();
+}
+
+void ChartWidget::setCompact(bool compact)
+{
+    m_renderer.setPaneVisible(PaneKind::Volume, !compact);
+    if (compact)
+        m_renderer.setPaneVisible(PaneKind::Indicator, false);
+    m_renderer.setMargins(compact ? QMargins(6, 6, 56, 6) : QMargins(60, 20, 80, 40));
+    setMinimumHeight(compact ? 140 : 300);
+    refreshVisibleFromWidth();
+    redraw();
+}
+
+void ChartWidget::setDisplayMode(DisplayMode mode)
+{
+    if (mode == m_mode)
+        return;
+    m_mode = mode;
+    m_panning = false;
+    resetView();
+}
+
+int ChartWidget::total() const
+{
+    return m_series ? m_series->bars.size() : 0;
+}
+
+void ChartWidget::setPriceOverlays(const QVector<int> &indicatorIds)
+{
+    m_renderer.setPriceOverlays(indicatorIds);
+    redraw();
+}
+
+void ChartWidget::setIndicatorPaneSeries(int indicatorId)
+{
+    m_renderer.setIndicatorPaneSeries(indicatorId);
+    redraw();
+}
+
+void ChartWidget::setPaneVisible(PaneKind kind, bool visible)
+{
+    m_renderer.setPaneVisible(kind, visible);
+    redraw();
+}
+
+bool ChartWidget::isPaneVisible(PaneKind kind) const
+{
+    return m_renderer.isPaneVisible(kind);
+}
+
+void ChartWidget::setOrderOverlays(const OrderOverlayStore *overlays)
+{
+    if (m_orderOverlays)
+        disconnect(m_orderOverlays, nullptr, this, nullptr);
+
+    m_orderOverlays = overlays;
+    m_renderer.setOrderOverlays(m_orderOverlays, m_symbol);
+    if (m_orderOverlays) {
+        connect(m_orderOverlays, &OrderOverlayStore::overlaysChanged,
+                this, &ChartWidget::onOverlaysChanged);
+    }
+    redraw();
+}
+
+void ChartWidget::onOverlaysChanged(const QString &symbol)
+{
+    // An empty symbol means every symbol changed.
+    if (symbol.isEmpty() || symbol == m_symbol)
+        redrawIfVisible();
+}
+
+void ChartWidget::onCandleAppended(const QString &symbol, int)
 {
-    m_candles.append(c);
+    if (!m_series || symbol != m_symbol)
+        return;
     refreshVisibleFromWidth();
 
     if (m_followTail) {
@@ -30,13 +128,81 @@ void ChartWidget::appendCandle(const Candle &c)
     }
 
     clampView();
-    if (isVisible()) update();
+    redrawIfVisible();
+}
+
+void ChartWidget::onTickAppended(const QString &symbol)
+{
+    if (m_mode != DisplayMode::Ticks || !m_series || symbol != m_symbol)
+        return;
+    if (m_followTail)
+        m_tickRightMs = lastTickMs();
+    // Decimation catches up lazily in paint, so off-screen charts do no work.
+    redrawIfVisible();
+}
+
+void ChartWidget::onBarsPrepended(const QString &symbol, int count)
+{
+    if (!m_series || symbol != m_symbol)
+        return;
+    // Shift by the page so the bars on screen stay put.
+    m_viewStart += count;
+    if (m_crosshairBar >= 0)
+        m_crosshairBar += count;
+    m_historyRequested = false;
+    m_renderer.invalidate();
+    clampView();
+    redrawIfVisible();
+}
+
+void ChartWidget::onBarsTrimmed(const QString &symbol, int count)
+{
+    if (!m_series || symbol != m_symbol)
+        return;
+    m_viewStart -= count;
+    if (m_crosshairBar >= 0)
+        m_crosshairBar = std::max(-1, m_crosshairBar - count);
+    m_renderer.invalidate();
+    clampView();
+    redrawIfVisible();
+}
+
+void ChartWidget::maybeRequestHistory()
+{
+    if (!m_series || m_mode != DisplayMode::Candles || total() == 0)
+        return;
+    // Ask for the next page while a screenful of bars is still left.
+    if (m_viewStart >= m_visibleCount) {
+        m_historyRequested = false;
+        return;
+    }
+    if (!m_historyRequested) {
+        m_historyRequested = true;
+        emit historyRequested(m_symbol);
+    }
+}
+
+void ChartWidget::releaseHistory()
+{
+    // Back at the live edge: deep history goes back to disk.
+    if (m_store && m_series && m_followTail && total() > CandleStore::kResidentBars)
+        m_store->trimFront(m_symbol, CandleStore::kResidentBars);
+}
+
+qint64 ChartWidget::lastTickMs() const
+{
+    return (m_series && !m_series->ticks.isEmpty()) ? m_series->ticks.time.last() : 0;
+}
+
+void ChartWidget::onSeriesReset(const QString &symbol)
+{
+    if (m_series && symbol == m_symbol)
+        resetView();
 }
 
 void ChartWidget::refreshVisibleFromWidth()
 {
-    const int w = std::max(1, chartRect().width());
-    m_visibleCount = std::max(1.0, w / static_cast<double>(pitch()));
+    m_visibleCount = m_renderer.visibleCount(rect(), viewState());
 }
 
 void ChartWidget::clampView()
@@ -51,109 +217,125 @@ bool ChartWidget::latestVisible() const
     return (m_viewStart + m_visibleCount) >= (static_cast<double>(total()) - 0.5);
 }
 
+ChartViewState ChartWidget::viewState() const
+{
+    ChartViewState view;
+    view.viewStart = m_viewStart;
+    view.candleWidth = m_candleWidth;
+    view.spacing = m_spacing;
+    view.verticalScale = m_verticalScale;
+    view.verticalPan = m_verticalPan;
+    view.showLiveBadge = m_followTail && !m_panning;
+    view.tickRightMs = m_tickRightMs;
+    view.tickSpanMs = m_tickSpanMs;
+    return view;
+}
+
+void ChartWidget::redraw()
+{
+    m_baseDirty = true;
+    update();
+}
+
+void ChartWidget::redrawIfVisible()
+{
+    // Hidden or scrolled-out charts (e.g. off-screen grid cells) skip the
+    // repaint, but the cached base layer is still marked stale so the next
+    // visible paint picks up every new bar.
+    m_baseDirty = true;
+    if (!visibleRegion().isEmpty())
+        update();
+}
+
 void ChartWidget::paintEvent(QPaintEvent *)
 {
-    QPainter p(this);
+    const qreal dpr = devicePixelRatioF();
+    const QSize pixelSize = size() * dpr;
+    if (m_baseLayer.size() != pixelSize) {
+        m_baseLayer = QPixmap(pixelSize);
+        m_baseLayer.setDevicePixelRatio(dpr);
+        m_baseDirty = true;
+    }
 
-    if (m_candles.isEmpty()) {
-        p.fillRect(rect(), QColor("#111319"));
-        return;
+    if (m_baseDirty) {
+        m_baseDirty = false;
+        QPainter base(&m_baseLayer);
+        const bool ticks = m_mode == DisplayMode::Ticks;
+        if (ticks ? (!m_series || m_series->ticks.isEmpty()) : total() == 0) {
+            base.fillRect(rect(), QColor("#111319"));
+            m_crosshairBar = -1;
+        } else {
+            m_renderer.setFont(font());
+            if (ticks) {
+                m_renderer.renderTicks(base, rect(), viewState(), m_series->ticks, m_decimator);
+            } else {
+                refreshVisibleFromWidth();
+                clampView();
+                m_renderer.render(base, rect(), viewState());
+            }
+        }
+        // The bar under the crosshair may have scrolled; re-snap to it.
+        if (m_crosshairBar >= 0 && m_crosshairPos.x() >= 0)
+            m_crosshairBar = m_renderer.barAt(m_crosshairPos.x());
+        m_crosshairRegion = m_renderer.crosshairRegion(m_crosshairPos, m_crosshairBar);
     }
 
-    QLinearGradient grad(rect().topLeft(), rect().bottomLeft());
-    grad.setColorAt(0.0, QColor("#10131b"));
-    grad.setColorAt(1.0, QColor("#07090f"));
-    p.fillRect(rect(), grad);
+    // Qt clips to the update region, so a hover-only paint copies just the
+    // crosshair strips back from the cached layer.
+    QPainter p(this);
+    p.drawPixmap(0, 0, m_baseLayer);
+    if (m_crosshairBar >= 0 && !m_panning)
+        m_renderer.drawCrosshair(p, m_crosshairPos, m_crosshairBar);
+}
 
-    refreshVisibleFromWidth();
-    clampView();
+void ChartWidget::moveCrosshair(const QPoint &pos, int bar)
+{
+    if (bar == m_crosshairBar && pos == m_crosshairPos)
+        return;
+    const QRegion region = m_renderer.crosshairRegion(pos, bar);
+    update(m_crosshairRegion | region);
+    m_crosshairRegion = region;
+    m_crosshairPos = pos;
+    m_crosshairBar = bar;
+}
 
-    const QRect area = chartRect();
-    const int totalCount = total();
-    const int startIdx = std::clamp(static_cast<int>(std::floor(m_viewStart)), 0, std::max(0, totalCount - 1));
-    const int endIdx = std::clamp(static_cast<int>(std::ceil(m_viewStart + m_visibleCount)),
-                                  startIdx + 1, totalCount);
-
-    double minP = std::numeric_limits<double>::max();
-    double maxP = std::numeric_limits<double>::lowest();
-    for (int i = startIdx; i < endIdx; ++i) {
-        minP = std::min(minP, m_candles[i].low);
-        maxP = std::max(maxP, m_candles[i].high);
-    }
-    if (qFuzzyCompare(minP, maxP)) {
-        minP -= 1.0;
-        maxP += 1.0;
+QImage ChartWidget::exportImage(int height) const
+{
+    if (total() == 0)
+        return QImage();
+
+    ChartViewState view = viewState();
+    view.verticalScale = 1.0;
+    view.verticalPan = 0.0;
+    view.showLiveBadge = false;
+
+    const QMargins margins = m_renderer.margins();
+    const int chrome = margins.left() + margins.right();
+    if (static_cast<qint64>(total()) * view.pitch() + chrome > kMaxExportWidth) {
+        view.candleWidth = 1;
+        view.spacing = 0;
     }
+    const int bars = std::min(total(), (kMaxExportWidth - chrome) / view.pitch());
+    view.viewStart = total() - bars;
 
-    const double priceRange = std::max(1e-6, maxP - minP);
-    const double yScale = (area.height() / priceRange) * m_verticalScale;
-    const double yOffset = m_verticalPan * area.height();
-
-    drawGridAndAxes(p, area, startIdx, endIdx, minP, maxP, yScale, yOffset);
-    drawCandles(p, area, startIdx, endIdx, minP, maxP, yScale, yOffset);
-
-    if (m_followTail && !m_panning) {
-        p.setRenderHint(QPainter::Antialiasing, true);
-        p.setPen(Qt::NoPen);
-        p.setBrush(QColor(0, 255, 102));
-        QRect badge(width() - 60, height() - 30, 48, 20);
-        p.drawRoundedRect(badge, 6, 6);
-        p.setPen(Qt::black);
-        p.drawText(badge, Qt::AlignCenter, "LIVE");
-    }
+    const QSize size(bars * view.pitch() + chrome, std::max(height, margins.top() + margins.bottom() + 100));
+    return m_renderer.renderTiled(size, view);
 }
 
-QRect ChartWidget::chartRect() const
+void ChartWidget::setCrosshairTime(qint64 ms)
 {
-    QRect area = rect();
-    area.adjust(m_chartMargins.left(), m_chartMargins.top(),
-                -m_chartMargins.right(), -m_chartMargins.bottom());
-    if (area.width() <= 0 || area.height() <= 0) {
-        area = QRect(m_chartMargins.left(), m_chartMargins.top(), 1, 1);
-    }
-    return area;
-}
-
-void ChartWidget::drawCandles(QPainter &p, const QRect &area,
-                              int startIdx, int endIdx,
-                              double minP, double maxP,
-                              double yScale, double yOffset)
-{
-    Q_UNUSED(maxP);
-    const int pxPitch = pitch();
-    const int baseX = area.left();
-    const int maxX = area.right();
-
-    p.setRenderHint(QPainter::Antialiasing, false);
-
-    for (int i = startIdx; i < endIdx; ++i) {
-        const Candle &c = m_candles[i];
-        const double rel = static_cast<double>(i) - m_viewStart;
-        const int x = baseX + static_cast<int>(rel * pxPitch);
-        if (x > maxX + m_candleWidth)
-            continue;
-
-        const double yO = priceToY(c.open,  minP, area, yScale, yOffset);
-        const double yC = priceToY(c.close, minP, area, yScale, yOffset);
-        const double yH = priceToY(c.high,  minP, area, yScale, yOffset);
-        const double yL = priceToY(c.low,   minP, area, yScale, yOffset);
-
-        const QColor color = (c.close >= c.open)
-                ? QColor(0, 214, 143)
-                : QColor(252, 79, 112);
-
-        p.setPen(QPen(color, 1));
-        const int midX = x + m_candleWidth / 2;
-        p.drawLine(midX, static_cast<int>(yH), midX, static_cast<int>(yL));
-
-        p.setBrush(color);
-        const int bodyTop = static_cast<int>(std::min(yO, yC));
-        int bodyHeight = static_cast<int>(std::fabs(yC - yO));
-        if (bodyHeight < 1) bodyHeight = 1;
-        QRect bodyRect(x, bodyTop, m_candleWidth, bodyHeight);
-        bodyRect = bodyRect.intersected(area);
-        p.drawRect(bodyRect);
-    }
+    if (m_mode != DisplayMode::Candles)
+        return;
+    const int bar = ms < 0 ? -1 : m_renderer.barAtTime(ms);
+    // Only the vertical line: the cursor is over another chart.
+    moveCrosshair(QPoint(-1, -1), bar);
+}
+
+void ChartWidget::leaveEvent(QEvent *event)
+{
+    QWidget::leaveEvent(event);
+    moveCrosshair(QPoint(-1, -1), -1);
+    emit crosshairMoved(-1);
 }
 
 void ChartWidget::wheelEvent(QWheelEvent *e)
@@ -164,6 +346,15 @@ void ChartWidget::wheelEvent(QWheelEvent *e)
     if (ctrl) {
         m_verticalScale *= (1.0 + steps * 0.1);
         m_verticalScale = std::clamp(m_verticalScale, 0.5, 3.0);
+    } else if (m_mode == DisplayMode::Ticks) {
+        // Zooming changes the pixel resolution; the decimator rebuilds once
+        // on the next paint.
+        const double span = m_tickSpanMs * (1.0 - steps * 0.1);
+        m_tickSpanMs = static_cast<qint64>(std::clamp(span, 1000.0, 86400000.0));
+        if (m_followTail)
+            m_tickRightMs = lastTickMs();
+        redraw();
+        return;
     } else {
         const double oldVisible = m_visibleCount;
         m_scale *= (1.0 + steps * 0.1);
@@ -180,9 +371,12 @@ void ChartWidget::wheelEvent(QWheelEvent *e)
         }
     }
 
-    m_followTail = !m_panning && latestVisible();
+    if (m_mode == DisplayMode::Candles)
+        m_followTail = !m_panning && latestVisible();
     clampView();
-    update();
+    maybeRequestHistory();
+    releaseHistory();
+    redraw();
 }
 
 void ChartWidget::mousePressEvent(QMouseEvent *e)
@@ -194,32 +388,84 @@ void ChartWidget::mousePressEvent(QMouseEvent *e)
 
 void ChartWidget::mouseMoveEvent(QMouseEvent *e)
 {
-    if (!m_panning) return;
+    if (!m_panning) {
+        if (m_mode == DisplayMode::Candles) {
+            const int bar = m_renderer.barAt(e->pos().x());
+            moveCrosshair(e->pos(), bar);
+            emit crosshairMoved(bar >= 0 ? m_renderer.barTime(bar) : -1);
+        }
+        showOverlayTip(e->pos());
+        return;
+    }
     const int dx = e->pos().x() - m_lastMousePos.x();
     const int dy = e->pos().y() - m_lastMousePos.y();
+    if (m_mode == DisplayMode::Ticks) {
+        const qint64 msPerPixel = ChartRenderer::tickResolution(m_renderer.chartRect(rect()), viewState());
+        m_tickRightMs = std::min(lastTickMs(), m_tickRightMs - dx * msPerPixel);
+    }
     const double pxPerCandle = std::max(1.0, static_cast<double>(pitch()));
     m_viewStart -= dx / pxPerCandle;
-    m_verticalPan -= dy / static_cast<double>(std::max(1, chartRect().height()));
+    m_verticalPan -= dy / static_cast<double>(std::max(1, m_renderer.paneRect(rect(), PaneKind::Price).height()));
     m_verticalPan = std::clamp(m_verticalPan, -1.0, 1.0);
     clampView();
+    maybeRequestHistory();
     m_lastMousePos = e->pos();
-    update();
+    redraw();
 }
 
 void ChartWidget::mouseReleaseEvent(QMouseEvent *)
 {
     m_panning = false;
-    m_followTail = latestVisible();
+    m_followTail = (m_mode == DisplayMode::Ticks)
+            ? m_tickRightMs >= lastTickMs()
+            : latestVisible();
+    releaseHistory();
+}
+
+void ChartWidget::showOverlayTip(const QPoint &pos)
+{
+    if (!m_orderOverlays || m_mode != DisplayMode::Candles)
+        return;
+
+    const ChartRenderer::OverlayHit hit = m_renderer.overlayAt(pos);
+    QString text;
+    if (hit.fill) {
+        text = tr("Fill #%1: %2 %3 @ %4\n%5")
+                .arg(hit.fill->orderId)
+                .arg(hit.fill->buy ? tr("BUY") : tr("SELL"))
+                .arg(hit.fill->quantity)
+                .arg(hit.fill->price, 0, 'f', 2)
+                .arg(QDateTime::fromMSecsSinceEpoch(hit.fill->timeMs).toString("yyyy-MM-dd hh:mm:ss"));
+    } else if (hit.limit) {
+        text = tr("Limit #%1: %2 %3 @ %4")
+                .arg(hit.limit->orderId)
+                .arg(hit.limit->buy ? tr("BUY") : tr("SELL"))
+                .arg(hit.limit->quantity)
+                .arg(hit.limit->price, 0, 'f', 2);
+    }
+
+    if (text.isEmpty())
+        QToolTip::hideText();
+    else
+        QToolTip::showText(mapToGlobal(pos), text, this);
 }
 
 void ChartWidget::clearCandles()
 {
-    m_candles.clear();
-    m_viewStart = 0.0;
+    setSource(nullptr, QString());
+}
+
+void ChartWidget::resetView()
+{
+    m_renderer.invalidate();
+    m_decimator.clear();
+    m_tickRightMs = lastTickMs();
     m_followTail = true;
     m_verticalPan = 0.0;
     m_verticalScale = 1.0;
-    update();
+    refreshVisibleFromWidth();
+    m_viewStart = std::max(0.0, static_cast<double>(total()) - m_visibleCount);
+    redraw();
 }
 
 void ChartWidget::resizeEvent(QResizeEvent *event)
@@ -227,98 +473,5 @@ void ChartWidget::resizeEvent(QResizeEvent *event)
     QWidget::resizeEvent(event);
     refreshVisibleFromWidth();
     clampView();
-}
-
-double ChartWidget::priceToY(double price, double minPrice,
-                             const QRect &area, double yScale, double yOffset) const
-{
-    return area.bottom() - ((price - minPrice) * yScale) - yOffset;
-}
-
-void ChartWidget::drawGridAndAxes(QPainter &p, const QRect &area,
-                                  int startIdx, int endIdx,
-                                  double minPrice, double maxPrice,
-                                  double yScale, double yOffset)
-{
-    Q_UNUSED(maxPrice);
-    p.save();
-    p.setRenderHint(QPainter::Antialiasing, false);
-
-    const double visibleMin = minPrice - (yOffset / yScale);
-    const double visibleMax = minPrice + ((area.height() - yOffset) / yScale);
-    const double priceSpan = visibleMax - visibleMin;
-
-    const double priceStep = niceStep(priceSpan / 6.0);
-    const double firstLevel = std::floor(visibleMin / priceStep) * priceStep;
-
-    QPen gridPen(QColor(255, 255, 255, 30));
-    gridPen.setStyle(Qt::DashLine);
-    p.setPen(gridPen);
-
-    QFont labelFont = font();
-    labelFont.setPointSizeF(labelFont.pointSizeF() * 0.9);
-    p.setFont(labelFont);
-
-    for (double level = firstLevel; level <= visibleMax + priceStep; level += priceStep) {
-        const double y = priceToY(level, minPrice, area, yScale, yOffset);
-        if (y < area.top() - 1 || y > area.bottom() + 1)
-            continue;
-        p.drawLine(area.left(), static_cast<int>(y), area.right(), static_cast<int>(y));
-
-        QRect labelRect(area.right() + 8, static_cast<int>(y) - 10,
-                         m_chartMargins.right() - 12, 20);
-        p.setPen(QColor(200, 210, 230));
-        p.drawText(labelRect, Qt::AlignRight | Qt::AlignVCenter,
-                   QString::number(level, 'f', priceStep < 1.0 ? 4 : 2));
-    }
-
-    // chart border
-    p.setPen(QColor(255, 255, 255, 40));
-    p.drawRect(area);
-
-    // time axis
-    const int visibleCount = std::max(1, endIdx - startIdx);
-    const int step = std::max(1, visibleCount / 6);
-    const int pxPitch = pitch();
-    const int baseX = area.left();
-
-    for (int i = startIdx; i < endIdx; i += step) {
-        const double rel = static_cast<double>(i) - m_viewStart;
-        const int x = baseX + static_cast<int>(rel * pxPitch);
-        if (x < area.left() || x > area.right())
-            continue;
-
-        p.setPen(QColor(255, 255, 255, 30));
-        p.drawLine(x, area.top(), x, area.bottom());
-
-        const Candle &c = m_candles[i];
-        QString text;
-        if (c.timestamp.isValid()) {
-            text = c.timestamp.toLocalTime().toString("hh:mm:ss");
-        }
-        if (text.isEmpty()) {
-            text = QString::number(i);
-        }
-
-        QRect textRect(x - 50, area.bottom() + 8, 100, m_chartMargins.bottom() - 16);
-        p.setPen(QColor(200, 210, 230));
-        p.drawText(textRect, Qt::AlignHCenter | Qt::AlignTop, text);
-    }
-
-    p.restore();
-}
-
-double ChartWidget::niceStep(double rawStep) const
-{
-    if (rawStep <= 0.0)
-        return 1.0;
-
-    const double exponent = std::floor(std::log10(rawStep));
-    const double fraction = rawStep / std::pow(10.0, exponent);
-    double niceFraction;
-    if (fraction < 1.5) niceFraction = 1.0;
-    else if (fraction < 3.0) niceFraction = 2.0;
-    else if (fraction < 7.0) niceFraction = 5.0;
-    else niceFraction = 10.0;
-    return niceFraction * std::pow(10.0, exponent);
+    m_baseDirty = true;
 }
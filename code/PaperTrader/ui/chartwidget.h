@@ -1,19 +1,61 @@
 #pragma once
+#include <QPixmap>
+#include <QRegion>
 #include <QWidget>
 #include <QVector>
 #include <QLoggingCategory>
-#include <QMargins>
-#include "core/models/candle.h"
+#include "chartrenderer.h"
+
+class CandleStore;
+class OrderOverlayStore;
+struct CandleSeries;
 
 Q_DECLARE_LOGGING_CATEGORY(lcChart)
 
 class ChartWidget : public QWidget {
     Q_OBJECT
 public:
+    // Stacked panes share the x-axis and view state; each has its own y scale.
+    using PaneKind = ChartRenderer::PaneKind;
+    // Candles plot bars by index; Ticks plots the raw tick line over time.
+    enum class DisplayMode { Candles, Ticks };
+
     explicit ChartWidget(QWidget *parent = nullptr);
-    void appendCandle(const Candle &c);
+
+    // Shows one symbol of a shared store; the widget holds no copy of the bars
+    // and repaints only while it is on screen.
+    void setSource(CandleStore *store, const QString &symbol);
+    QString symbol() const { return m_symbol; }
     void clearCandles();
 
+    // Compact charts (grid cells) drop the lower panes and most margins.
+    void setCompact(bool compact);
+
+    void setDisplayMode(DisplayMode mode);
+    DisplayMode displayMode() const { return m_mode; }
+
+    // Ids refer to the series' IndicatorEngine (see CandleStore::indicatorId).
+    void setPriceOverlays(const QVector<int> &indicatorIds);
+    void setIndicatorPaneSeries(int indicatorId);
+    void setPaneVisible(PaneKind kind, bool visible);
+    bool isPaneVisible(PaneKind kind) const;
+
+    // Limit lines and fills for the shown symbol; hovering one shows its details.
+    void setOrderOverlays(const OrderOverlayStore *overlays);
+
+    // Every loaded bar in one image for reports, at the current zoom when it
+    // fits, rendered in parallel tiles. Null when there are no bars.
+    QImage exportImage(int height = 1600) const;
+
+    // Shows the crosshair at the bar open at `ms` (another chart's hover);
+    // a negative time hides it.
+    void setCrosshairTime(qint64 ms);
+
+signals:
+    // The view is near the oldest loaded bar; older bars are welcome.
+    void historyRequested(const QString &symbol);
+    // Time of the hovered bar, or -1 when the cursor leaves the chart.
+    void crosshairMoved(qint64 ms);
 
 protected:
     void paintEvent(QPaintEvent *) override;
@@ -22,9 +64,26 @@ protected:
     void mouseMoveEvent(QMouseEvent *) override;
     void mouseReleaseEvent(QMouseEvent *) override;
     void resizeEvent(QResizeEvent *event) override;
+    void leaveEvent(QEvent *event) override;
+
+private slots:
+    void onCandleAppended(const QString &symbol, int index);
+    void onSeriesReset(const QString &symbol);
+    void onTickAppended(const QString &symbol);
+    void onBarsPrepended(const QString &symbol, int count);
+    void onBarsTrimmed(const QString &symbol, int count);
+    void onOverlaysChanged(const QString &symbol);
 
 private:
-    QVector<Candle> m_candles;
+    CandleStore *m_store = nullptr;
+    const CandleSeries *m_series = nullptr;
+    const OrderOverlayStore *m_orderOverlays = nullptr;
+    QString m_symbol;
+    ChartRenderer m_renderer;
+    DisplayMode m_mode = DisplayMode::Candles;
+    TickDecimator m_decimator;
+    qint64 m_tickRightMs = 0;
+    qint64 m_tickSpanMs = 120000;
     double m_scale = 1.0;
     int m_candleWidth = 6;
     int m_spacing = 2;
@@ -35,23 +94,30 @@ private:
     QPoint m_lastMousePos;
     bool m_panning = false;
     bool m_followTail = true;
-    QMargins m_chartMargins{60, 20, 80, 40};
+    bool m_historyRequested = false;
+    // Everything but the crosshair, rendered once per data/view change so a
+    // hover only repaints the crosshair's own pixels over it.
+    QPixmap m_baseLayer;
+    bool m_baseDirty = true;
+    QPoint m_crosshairPos;
+    int m_crosshairBar = -1;
+    QRegion m_crosshairRegion;
+
+    // Wider exports drop to one pixel per bar, then to the newest bars.
+    static constexpr int kMaxExportWidth = 16384;
 
-    int total() const { return static_cast<int>(m_candles.size()); }
+    int total() const;
     int pitch() const { return std::max(1, m_candleWidth + m_spacing); }
+    ChartViewState viewState() const;
     void refreshVisibleFromWidth();
     void clampView();
     bool latestVisible() const;
-    QRect chartRect() const;
-    void drawCandles(QPainter &p, const QRect &area,
-                     int startIdx, int endIdx,
-                     double minPrice, double maxPrice,
-                     double yScale, double yOffset);
-    void drawGridAndAxes(QPainter &p, const QRect &area,
-                         int startIdx, int endIdx,
-                         double minPrice, double maxPrice,
-                         double yScale, double yOffset);
-    double priceToY(double price, double minPrice,
-                    const QRect &area, double yScale, double yOffset) const;
-    double niceStep(double rawStep) const;
+    qint64 lastTickMs() const;
+    void maybeRequestHistory();
+    void releaseHistory();
+    void resetView();
+    void showOverlayTip(const QPoint &pos);
+    void redraw();
+    void redrawIfVisible();
+    void moveCrosshair(const QPoint &pos, int bar);
 };
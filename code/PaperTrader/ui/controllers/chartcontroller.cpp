@@ -79,3 +79,14 @@ QString ChartController::lastSymbol() const
 {
     return m_chartManager ? m_chartManager->lastSymbol() : QString{};
 }
+
+CandleStore *ChartController::candleStore() const
+{
+    return m_chartManager ? m_chartManager->candleStore() : nullptr;
+}
+
+void ChartController::requestHistory(const QString &symbol)
+{
+    if (m_chartManager)
+        m_chartManager->requestHistory(symbol);
+}
@@ -23,6 +23,8 @@ public:
     double lastPrice() const;
     Quote lastQuote() const;
     QString lastSymbol() const;
+    CandleStore *candleStore() const;
+    void requestHistory(const QString &symbol);
 
     QStringList loadWatchlist() const;
     void saveWatchlist(const QStringList &symbols) const;
@@ -3,7 +3,8 @@
 
 TradingController::TradingController(PaperTraderApp *app, QObject *parent)
     : QObject(parent),
-      m_app(app)
+      m_app(app),
+      m_overlays(new OrderOverlayStore(this))
 {
     if (!m_app)
         return;
@@ -29,7 +30,7 @@ QList<Position> TradingController::positions() const
 
 OrderManager::OrderPlacementResult TradingController::placeOrder(OrderManager::OrderType type,
                                                                  const QString &symbol,
-                                                                 const QString &side,
+                                                                 OrderSide side,
                                                                  double quantity,
                                                                  double price)
 {
@@ -38,11 +39,66 @@ OrderManager::OrderPlacementResult TradingController::placeOrder(OrderManager::O
     return m_orderManager->placeOrder(type, symbol, side, quantity, price);
 }
 
+OrderManager::OrderPlacementResult TradingController::placeOrder(const OrderRequest &request)
+{
+    if (!m_orderManager)
+        return {};
+    return m_orderManager->placeOrder(request);
+}
+
+QList<OrderManager::OrderPlacementResult> TradingController::placeOrders(std::span<const OrderRequest> requests)
+{
+    if (!m_orderManager)
+        return {};
+    return m_orderManager->placeOrders(requests);
+}
+
+OrderManager::OrderPlacementResult TradingController::placeBracket(const OrderRequest &entry,
+                                                                   double takeProfit,
+                                                                   double stopLoss)
+{
+    if (!m_orderManager)
+        return {};
+    return m_orderManager->placeBracket(entry, takeProfit, stopLoss);
+}
+
+int TradingController::placeOco(const OrderRequest &first, const OrderRequest &second)
+{
+    return m_orderManager ? m_orderManager->placeOco(first, second) : 0;
+}
+
 bool TradingController::cancelOrder(int orderId)
 {
     return m_orderManager && m_orderManager->cancelOrder(orderId);
 }
 
+int TradingController::cancelAll(const OrderFilter &filter)
+{
+    return m_orderManager ? m_orderManager->cancelAll(filter) : 0;
+}
+
+OrderManager::OrderPlacementResult TradingController::amendOrder(int orderId,
+                                                                 double newPrice,
+                                                                 double newQuantity)
+{
+    if (!m_orderManager)
+        return {};
+    return m_orderManager->amendOrder(orderId, newPrice, newQuantity);
+}
+
+void TradingController::setQuoteMatching(bool enabled)
+{
+    if (m_app && m_app->executionSimulator())
+        m_app->executionSimulator()->setMatchMode(enabled ? ExecutionSimulator::MatchMode::Quote
+                                                          : ExecutionSimulator::MatchMode::Candle);
+}
+
+void TradingController::setVolumeParticipation(double fraction)
+{
+    if (m_app && m_app->executionSimulator())
+        m_app->executionSimulator()->setVolumeParticipation(fraction);
+}
+
 void TradingController::onLastPriceChanged(const QString &symbol, double price)
 {
     if (m_orderManager)
@@ -71,11 +127,26 @@ void TradingController::bindOrderManager(OrderManager *manager)
         disconnect(m_orderManager, nullptr, this, nullptr);
 
     m_orderManager = manager;
-    if (!m_orderManager)
+    if (!m_orderManager) {
+        m_overlays->clear();
         return;
-
-    connect(m_orderManager, &OrderManager::ordersChanged,
-            this, &TradingController::ordersChanged);
+    }
+
+    connect(m_orderManager, &OrderManager::orderUpserted,
+            this, &TradingController::orderUpserted);
+    connect(m_orderManager, &OrderManager::ordersUpserted,
+            this, &TradingController::ordersUpserted);
+    connect(m_orderManager, &OrderManager::orderRemoved,
+            this, &TradingController::orderRemoved);
+    connect(m_orderManager, &OrderManager::orderUpserted,
+            m_overlays, &OrderOverlayStore::upsertOrder);
+    connect(m_orderManager, &OrderManager::ordersUpserted,
+            m_overlays, &OrderOverlayStore::upsertOrders);
+    connect(m_orderManager, &OrderManager::orderRemoved,
+            m_overlays, &OrderOverlayStore::removeOrder);
+    connect(m_orderManager, &OrderManager::orderFilled,
+            m_overlays, &OrderOverlayStore::addFill);
+    m_overlays->setOrders(m_orderManager->orders());
     connect(m_orderManager, &OrderManager::orderRejected,
             this, &TradingController::orderRejected);
 }
@@ -94,4 +165,8 @@ void TradingController::bindPortfolioManager(PortfolioManager *manager)
 
     connect(m_portfolioManager, &PortfolioManager::portfolioChanged,
             this, &TradingController::portfolioChanged);
+    connect(m_portfolioManager, &PortfolioManager::positionChanged,
+            this, &TradingController::positionChanged);
+    connect(m_portfolioManager, &PortfolioManager::positionClosed,
+            this, &TradingController::positionClosed);
 }
@@ -2,6 +2,7 @@
 #include <QObject>
 #include <QList>
 #include <QString>
+#include "core/orderoverlaystore.h"
 #include "core/ordermanager.h"
 #include "core/portfoliomanager.h"
 #include "core/models/order.h"
@@ -19,22 +20,45 @@ public:
     QList<Order> orders() const;
     PortfolioSnapshot snapshot() const;
     QList<Position> positions() const;
+    // Limit lines and fill markers for the chart, kept in step with the orders.
+    OrderOverlayStore *orderOverlays() const { return m_overlays; }
+    // Finished orders, for the history view.
+    const OrderHistory *orderHistory() const
+    {
+        return m_orderManager ? &m_orderManager->history() : nullptr;
+    }
 
     OrderManager::OrderPlacementResult placeOrder(OrderManager::OrderType type,
                                                   const QString &symbol,
-                                                  const QString &side,
+                                                  OrderSide side,
                                                   double quantity,
                                                   double price);
+    OrderManager::OrderPlacementResult placeOrder(const OrderRequest &request);
+    QList<OrderManager::OrderPlacementResult> placeOrders(std::span<const OrderRequest> requests);
+    OrderManager::OrderPlacementResult placeBracket(const OrderRequest &entry,
+                                                    double takeProfit,
+                                                    double stopLoss);
+    int placeOco(const OrderRequest &first, const OrderRequest &second);
     bool cancelOrder(int orderId);
+    int cancelAll(const OrderFilter &filter = {});
+    OrderManager::OrderPlacementResult amendOrder(int orderId, double newPrice, double newQuantity);
+    // Resting limits match against quotes (at the touch) instead of bar closes.
+    void setQuoteMatching(bool enabled);
+    // Caps each bar's fills at this fraction of its volume; 0 lifts the cap.
+    void setVolumeParticipation(double fraction);
 
 public slots:
     void onLastPriceChanged(const QString &symbol, double price);
     void onQuoteUpdated(const Quote &quote);
 
 signals:
-    void ordersChanged(const QList<Order> &orders);
-    void orderRejected(const QString &symbol, const QString &errorCode, double rejectedQuantity);
-    void portfolioChanged(const PortfolioSnapshot &snapshot, const QList<Position> &positions);
+    void orderUpserted(const Order &order);
+    void ordersUpserted(const QList<Order> &orders);
+    void orderRemoved(int orderId);
+    void orderRejected(const QString &symbol, RejectReason reason, double rejectedQuantity);
+    void portfolioChanged(const PortfolioSnapshot &snapshot);
+    void positionChanged(const Position &position);
+    void positionClosed(const QString &symbol);
 
 private:
     void bindOrderManager(OrderManager *manager);
@@ -43,4 +67,5 @@ private:
     PaperTraderApp *m_app = nullptr;
     OrderManager *m_orderManager = nullptr;
     PortfolioManager *m_portfolioManager = nullptr;
+    OrderOverlayStore *m_overlays = nullptr;
 };
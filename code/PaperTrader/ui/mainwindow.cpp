@@ -5,13 +5,18 @@
 #include <QFrame>
 #include <QStatusBar>
 #include <QSplitter>
+#include <QStackedWidget>
+#include <QScrollArea>
 #include <QToolButton>
 #include <QListWidget>
-#include <QTableWidget>
+#include <QTableView>
+#include <QSortFilterProxyModel>
 #include <QHeaderView>
 #include <QGridLayout>
 #include <QLabel>
 #include <QDoubleValidator>
+#include <QDateTimeEdit>
+#include <QDateTime>
 #include <QLocale>
 #include <QJsonObject>
 #include <QItemSelectionModel>
@@ -20,9 +25,19 @@
 #include <QAbstractAnimation>
 #include <QSignalBlocker>
 #include <QStyle>
+#include <QApplication>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QFile>
+#include <QDebug>
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
+#include <utility>
+
+#include "core/basketimport.h"
+#include "core/candlestore.h"
 
 namespace {
 void animateSplitterSizes(QSplitter *splitter,
@@ -131,6 +146,28 @@ void MainWindow::setupUi()
     toolbarLayout->addWidget(m_stopButton);
     toolbarLayout->addWidget(m_statusLabel);
 
+    m_gridToggle = new QToolButton(this);
+    m_gridToggle->setCheckable(true);
+    m_gridToggle->setChecked(false);
+    m_gridToggle->setText(tr("Grid"));
+    m_gridToggle->setToolTip(tr("Show one chart per watchlist symbol"));
+    m_gridToggle->setAutoRaise(false);
+    toolbarLayout->addWidget(m_gridToggle);
+
+    m_tickModeToggle = new QToolButton(this);
+    m_tickModeToggle->setCheckable(true);
+    m_tickModeToggle->setChecked(false);
+    m_tickModeToggle->setText(tr("Ticks"));
+    m_tickModeToggle->setToolTip(tr("Plot raw ticks as a line instead of candles"));
+    m_tickModeToggle->setAutoRaise(false);
+    toolbarLayout->addWidget(m_tickModeToggle);
+
+    m_exportButton = new QToolButton(this);
+    m_exportButton->setText(tr("Export"));
+    m_exportButton->setToolTip(tr("Save the loaded history as a PNG image"));
+    m_exportButton->setAutoRaise(false);
+    toolbarLayout->addWidget(m_exportButton);
+
     m_themeToggle = new QToolButton(this);
     m_themeToggle->setObjectName("themeToggle");
     m_themeToggle->setCheckable(true);
@@ -193,7 +230,20 @@ void MainWindow::setupUi()
     chartPanel->setObjectName("chartPanel");
     QVBoxLayout *chartLayout = new QVBoxLayout(chartPanel);
     chartLayout->setContentsMargins(0, 0, 0, 0);
-    chartLayout->addWidget(m_chart);
+
+    QScrollArea *gridScroll = new QScrollArea(chartPanel);
+    gridScroll->setWidgetResizable(true);
+    gridScroll->setFrameShape(QFrame::NoFrame);
+    m_gridContainer = new QWidget(gridScroll);
+    m_gridLayout = new QGridLayout(m_gridContainer);
+    m_gridLayout->setContentsMargins(0, 0, 0, 0);
+    m_gridLayout->setSpacing(8);
+    gridScroll->setWidget(m_gridContainer);
+
+    m_chartStack = new QStackedWidget(chartPanel);
+    m_chartStack->addWidget(m_chart);
+    m_chartStack->addWidget(gridScroll);
+    chartLayout->addWidget(m_chartStack);
 
     QFrame *orderPanel = new QFrame(horizontalSplit);
     orderPanel->setObjectName("orderPanel");
@@ -333,7 +383,8 @@ void MainWindow::buildOrderPanel(QFrame *panel)
     form->setVerticalSpacing(6);
 
     m_orderTypeCombo = new QComboBox(panel);
-    m_orderTypeCombo->addItems({"Market", "Limit"});
+    // Item order follows OrderType.
+    m_orderTypeCombo->addItems({"Market", "Limit", "Stop", "Stop Limit", "Trailing Stop"});
 
     m_orderSideCombo = new QComboBox(panel);
     m_orderSideCombo->addItems({"Buy", "Sell"});
@@ -350,6 +401,17 @@ void MainWindow::buildOrderPanel(QFrame *panel)
     m_priceValidator->setNotation(QDoubleValidator::StandardNotation);
     m_orderPriceEdit->setValidator(m_priceValidator);
 
+    m_orderStopEdit = new QLineEdit(panel);
+    m_orderStopEdit->setValidator(m_priceValidator);
+
+    // Item order follows TimeInForce.
+    m_orderTifCombo = new QComboBox(panel);
+    m_orderTifCombo->addItems({"GTC", "IOC", "FOK", "GTD", "DAY"});
+
+    m_orderExpiryEdit = new QDateTimeEdit(QDateTime::currentDateTime().addSecs(3600), panel);
+    m_orderExpiryEdit->setCalendarPopup(true);
+    m_orderExpiryEdit->setDisplayFormat("yyyy-MM-dd HH:mm");
+
     form->addWidget(new QLabel("Type", panel), 0, 0);
     form->addWidget(m_orderTypeCombo, 0, 1);
     form->addWidget(new QLabel("Side", panel), 0, 2);
@@ -358,6 +420,28 @@ void MainWindow::buildOrderPanel(QFrame *panel)
     form->addWidget(m_orderQtyEdit, 1, 1);
     form->addWidget(new QLabel("Price", panel), 1, 2);
     form->addWidget(m_orderPriceEdit, 1, 3);
+    form->addWidget(new QLabel("TIF", panel), 2, 0);
+    form->addWidget(m_orderTifCombo, 2, 1);
+    form->addWidget(new QLabel("Stop", panel), 2, 2);
+    form->addWidget(m_orderStopEdit, 2, 3);
+    form->addWidget(new QLabel("Expires", panel), 3, 0);
+    form->addWidget(m_orderExpiryEdit, 3, 1, 1, 3);
+
+    m_fillModelCombo = new QComboBox(panel);
+    m_fillModelCombo->addItems({"Bar close", "Quote touch"});
+    m_fillModelCombo->setToolTip(tr("Fill resting limits at the bar close, or as soon as "
+                                    "the bid/ask reaches them"));
+    form->addWidget(new QLabel("Fills", panel), 4, 0);
+    form->addWidget(m_fillModelCombo, 4, 1);
+
+    m_participationSpin = new QDoubleSpinBox(panel);
+    m_participationSpin->setRange(0.0, 100.0);
+    m_participationSpin->setDecimals(1);
+    m_participationSpin->setSuffix(" %");
+    m_participationSpin->setSpecialValueText(tr("No cap"));
+    m_participationSpin->setToolTip(tr("Largest share of a bar's volume resting limits may fill"));
+    form->addWidget(new QLabel("Max vol", panel), 4, 2);
+    form->addWidget(m_participationSpin, 4, 3);
 
     containerLayout->addLayout(form);
 
@@ -366,28 +450,88 @@ void MainWindow::buildOrderPanel(QFrame *panel)
     m_placeOrderButton = new QPushButton("Place Order", panel);
     m_cancelOrderButton = new QPushButton("Cancel Selected", panel);
     m_cancelOrderButton->setEnabled(false);
+    m_amendOrderButton = new QPushButton("Amend Selected", panel);
+    m_amendOrderButton->setEnabled(false);
+    m_amendOrderButton->setToolTip(tr("Apply the ticket's price and quantity to the selected order"));
     m_placeOrderButton->setObjectName("tradeActionButton");
     m_placeOrderButton->setProperty("accent", "buy");
     m_cancelOrderButton->setProperty("accent", "neutral");
+    m_amendOrderButton->setProperty("accent", "neutral");
     buttonRow->addWidget(m_placeOrderButton, 1);
+    buttonRow->addWidget(m_amendOrderButton, 1);
     buttonRow->addWidget(m_cancelOrderButton, 1);
+    m_cancelAllButton = new QPushButton("Cancel All", panel);
+    m_cancelAllButton->setProperty("accent", "neutral");
+    m_cancelAllButton->setToolTip(tr("Cancel every working order matching the status "
+                                     "and symbol filters below"));
+    buttonRow->addWidget(m_cancelAllButton, 1);
+    m_importBasketButton = new QPushButton("Import Basket…", panel);
+    m_importBasketButton->setProperty("accent", "neutral");
+    m_importBasketButton->setToolTip(tr("Place every order of a CSV basket"));
+    buttonRow->addWidget(m_importBasketButton, 1);
     containerLayout->addLayout(buttonRow);
 
     QLabel *ordersHeader = new QLabel("Orders", panel);
     ordersHeader->setObjectName("sectionTitle");
     containerLayout->addWidget(ordersHeader);
 
-    m_ordersTable = new QTableWidget(panel);
-    m_ordersTable->setColumnCount(10);
-    m_ordersTable->setHorizontalHeaderLabels({"ID", "Symbol", "Side", "Type", "Requested", "Working", "Filled", "Price", "Fee", "Status"});
+    QHBoxLayout *filterRow = new QHBoxLayout();
+    filterRow->setSpacing(8);
+    m_orderStatusFilter = new QComboBox(panel);
+    m_orderStatusFilter->addItem(tr("All"), -1);
+    for (OrderStatus status : {OrderStatus::Open, OrderStatus::PartiallyFilled,
+                               OrderStatus::Filled, OrderStatus::Cancelled}) {
+        m_orderStatusFilter->addItem(OrdersModel::statusName(status), static_cast<int>(status));
+    }
+    m_orderSymbolFilter = new QLineEdit(panel);
+    m_orderSymbolFilter->setPlaceholderText(tr("Filter symbol"));
+    m_orderSymbolFilter->setClearButtonEnabled(true);
+    filterRow->addWidget(m_orderStatusFilter, 1);
+    filterRow->addWidget(m_orderSymbolFilter, 1);
+    containerLayout->addLayout(filterRow);
+
+    m_ordersModel = new OrdersModel(this);
+    m_ordersModel->setQuantityPrecision(m_quantityPrecision);
+    m_ordersProxy = new OrdersFilterModel(this);
+    m_ordersProxy->setSourceModel(m_ordersModel);
+
+    m_ordersTable = new QTableView(panel);
+    m_ordersTable->setModel(m_ordersProxy);
+    m_ordersTable->setSortingEnabled(true);
+    m_ordersTable->sortByColumn(OrdersModel::Id, Qt::DescendingOrder);
     m_ordersTable->horizontalHeader()->setStretchLastSection(true);
     m_ordersTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    // Size columns from a sample of rows, not all of them.
+    m_ordersTable->horizontalHeader()->setResizeContentsPrecision(64);
     m_ordersTable->verticalHeader()->setVisible(false);
+    m_ordersTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
     m_ordersTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     m_ordersTable->setSelectionMode(QAbstractItemView::SingleSelection);
     m_ordersTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
     containerLayout->addWidget(m_ordersTable, 1);
 
+    QLabel *historyHeader = new QLabel("History", panel);
+    historyHeader->setObjectName("sectionTitle");
+    containerLayout->addWidget(historyHeader);
+
+    m_historyModel = new OrderHistoryModel(this);
+    m_historyModel->setQuantityPrecision(m_quantityPrecision);
+    m_historyProxy = new OrdersFilterModel(this);
+    m_historyProxy->setSourceModel(m_historyModel);
+
+    m_historyTable = new QTableView(panel);
+    m_historyTable->setModel(m_historyProxy);
+    m_historyTable->setSortingEnabled(true);
+    m_historyTable->sortByColumn(OrdersModel::Id, Qt::DescendingOrder);
+    m_historyTable->horizontalHeader()->setStretchLastSection(true);
+    m_historyTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    m_historyTable->horizontalHeader()->setResizeContentsPrecision(64);
+    m_historyTable->verticalHeader()->setVisible(false);
+    m_historyTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    m_historyTable->setSelectionMode(QAbstractItemView::NoSelection);
+    m_historyTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    containerLayout->addWidget(m_historyTable, 1);
+
     layout->addWidget(m_orderContainer);
 
     updateOrderPriceVisibility();
@@ -431,12 +575,21 @@ void MainWindow::buildPortfolioPanel(QFrame *panel)
 
     contentLayout->addLayout(metrics);
 
-    m_positionsTable = new QTableWidget(panel);
-    m_positionsTable->setColumnCount(5);
-    m_positionsTable->setHorizontalHeaderLabels({"Symbol", "Qty", "Avg Price", "Last", "Unrealized"});
+    m_positionsModel = new PositionsModel(this);
+    m_positionsModel->setQuantityPrecision(m_quantityPrecision);
+    auto *positionsProxy = new QSortFilterProxyModel(this);
+    positionsProxy->setSourceModel(m_positionsModel);
+    positionsProxy->setSortRole(PositionsModel::SortRole);
+
+    m_positionsTable = new QTableView(panel);
+    m_positionsTable->setModel(positionsProxy);
+    m_positionsTable->setSortingEnabled(true);
+    m_positionsTable->sortByColumn(PositionsModel::Symbol, Qt::AscendingOrder);
     m_positionsTable->horizontalHeader()->setStretchLastSection(true);
     m_positionsTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    m_positionsTable->horizontalHeader()->setResizeContentsPrecision(64);
     m_positionsTable->verticalHeader()->setVisible(false);
+    m_positionsTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
     m_positionsTable->setSelectionMode(QAbstractItemView::NoSelection);
     m_positionsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
     contentLayout->addWidget(m_positionsTable, 1);
@@ -478,21 +631,77 @@ void MainWindow::setupConnections()
 
     connect(m_orderTypeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &MainWindow::onOrderTypeChanged);
+    connect(m_orderTifCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &MainWindow::onOrderTypeChanged);
     connect(m_orderSideCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &MainWindow::onOrderSideChanged);
     connect(m_placeOrderButton, &QPushButton::clicked,
             this, &MainWindow::onPlaceOrder);
+    connect(m_fillModelCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, [this](int index) {
+        if (m_tradingController)
+            m_tradingController->setQuoteMatching(index == 1);
+    });
+    connect(m_participationSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+            this, [this](double percent) {
+        if (m_tradingController)
+            m_tradingController->setVolumeParticipation(percent / 100.0);
+    });
+    connect(m_amendOrderButton, &QPushButton::clicked,
+            this, &MainWindow::onAmendSelectedOrder);
+    connect(m_cancelAllButton, &QPushButton::clicked,
+            this, &MainWindow::onCancelAllOrders);
     connect(m_cancelOrderButton, &QPushButton::clicked,
             this, &MainWindow::onCancelSelectedOrder);
-    connect(m_ordersTable, &QTableWidget::itemSelectionChanged,
+    connect(m_importBasketButton, &QPushButton::clicked,
+            this, &MainWindow::onImportBasket);
+    connect(m_ordersTable->selectionModel(), &QItemSelectionModel::selectionChanged,
+            this, &MainWindow::onOrderSelectionChanged);
+    // Rows leaving the filter or the model drop out of the selection silently.
+    connect(m_ordersProxy, &QAbstractItemModel::rowsRemoved,
+            this, &MainWindow::onOrderSelectionChanged);
+    connect(m_ordersProxy, &QAbstractItemModel::modelReset,
             this, &MainWindow::onOrderSelectionChanged);
+    connect(m_orderStatusFilter, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this]() {
+        const int status = m_orderStatusFilter->currentData().toInt();
+        const auto filter = status < 0 ? std::nullopt
+                                       : std::optional(static_cast<OrderStatus>(status));
+        m_ordersProxy->setStatusFilter(filter);
+        m_historyProxy->setStatusFilter(filter);
+    });
+    connect(m_orderSymbolFilter, &QLineEdit::textChanged,
+            m_ordersProxy, &OrdersFilterModel::setSymbolFilter);
+    connect(m_orderSymbolFilter, &QLineEdit::textChanged,
+            m_historyProxy, &OrdersFilterModel::setSymbolFilter);
 
     connect(m_themeToggle, &QToolButton::toggled,
             this, &MainWindow::onThemeToggled);
+    connect(m_gridToggle, &QToolButton::toggled,
+            this, &MainWindow::onGridToggled);
+    connect(m_exportButton, &QToolButton::clicked,
+            this, &MainWindow::onExportChart);
+    connect(m_tickModeToggle, &QToolButton::toggled, this, [this](bool ticks) {
+        m_chart->setDisplayMode(ticks ? ChartWidget::DisplayMode::Ticks
+                                      : ChartWidget::DisplayMode::Candles);
+    });
 
     if (m_chartController) {
+        if (CandleStore *store = m_chartController->candleStore()) {
+            m_chart->setPriceOverlays({store->indicatorId(IndicatorSpec::Kind::SMA),
+                                       store->indicatorId(IndicatorSpec::Kind::Bollinger)});
+            m_chart->setIndicatorPaneSeries(store->indicatorId(IndicatorSpec::Kind::RSI));
+        }
+
+        connect(m_chart, &ChartWidget::historyRequested,
+                m_chartController, &ChartController::requestHistory);
+
+        // The main chart follows whichever series the feed is writing; the
+        // bars themselves stay in the store.
         connect(m_chartController, &ChartController::candleReceived,
-                m_chart, &ChartWidget::appendCandle);
+                this, [this](const Candle &c) {
+                    if (m_chart->symbol() != CandleStore::key(c.symbol))
+                        m_chart->setSource(m_chartController->candleStore(), c.symbol);
+                });
         connect(m_chartController, &ChartController::lastPriceChanged,
                 this, [this](const QString &symbol, double price) {
                     m_lastSymbol = symbol;
@@ -534,16 +743,29 @@ void MainWindow::setupConnections()
     }
 
     if (m_tradingController) {
-        connect(m_tradingController, &TradingController::ordersChanged,
-                this, &MainWindow::refreshOrders);
+        m_chart->setOrderOverlays(m_tradingController->orderOverlays());
+        connect(m_tradingController, &TradingController::orderUpserted,
+                m_ordersModel, &OrdersModel::upsertOrder);
+        connect(m_tradingController, &TradingController::ordersUpserted,
+                m_ordersModel, &OrdersModel::upsertOrders);
+        connect(m_tradingController, &TradingController::orderRemoved,
+                m_ordersModel, &OrdersModel::removeOrder);
+        // Removed orders are the ones just archived.
+        connect(m_tradingController, &TradingController::orderRemoved,
+                m_historyModel, &OrderHistoryModel::refresh);
         connect(m_tradingController, &TradingController::orderRejected,
                 this, &MainWindow::onOrderRejected);
         connect(m_tradingController, &TradingController::portfolioChanged,
                 this, &MainWindow::refreshPortfolio);
-
-        refreshOrders(m_tradingController->orders());
-        refreshPortfolio(m_tradingController->snapshot(),
-                         m_tradingController->positions());
+        connect(m_tradingController, &TradingController::positionChanged,
+                m_positionsModel, &PositionsModel::upsertPosition);
+        connect(m_tradingController, &TradingController::positionClosed,
+                m_positionsModel, &PositionsModel::removePosition);
+
+        m_ordersModel->setOrders(m_tradingController->orders());
+        m_historyModel->setHistory(m_tradingController->orderHistory());
+        m_positionsModel->setPositions(m_tradingController->positions());
+        refreshPortfolio(m_tradingController->snapshot());
     }
 }
 
@@ -641,7 +863,9 @@ void MainWindow::onOrderTypeChanged(int)
 
 void MainWindow::updateOrderPriceVisibility()
 {
-    const bool isLimit = currentOrderType() == OrderManager::OrderType::Limit;
+    const OrderManager::OrderType type = currentOrderType();
+    const bool isLimit = type == OrderManager::OrderType::Limit
+            || type == OrderManager::OrderType::StopLimit;
     m_orderPriceEdit->setEnabled(isLimit);
     if (!isLimit) {
         m_orderPriceEdit->clear();
@@ -649,13 +873,22 @@ void MainWindow::updateOrderPriceVisibility()
     } else {
         m_orderPriceEdit->setPlaceholderText("Price");
     }
+
+    const bool isStop = isStopType(type);
+    m_orderStopEdit->setEnabled(isStop);
+    if (!isStop)
+        m_orderStopEdit->clear();
+    m_orderStopEdit->setPlaceholderText(type == OrderManager::OrderType::TrailingStop
+                                        ? "Trail distance"
+                                        : isStop ? "Stop price" : "—");
+
+    m_orderExpiryEdit->setEnabled(m_orderTifCombo->currentIndex() == static_cast<int>(TimeInForce::GTD));
 }
 
 OrderManager::OrderType MainWindow::currentOrderType() const
 {
-    return (m_orderTypeCombo->currentIndex() == 1)
-            ? OrderManager::OrderType::Limit
-            : OrderManager::OrderType::Market;
+    const int index = std::max(0, m_orderTypeCombo->currentIndex());
+    return static_cast<OrderManager::OrderType>(index);
 }
 
 void MainWindow::onOrderSideChanged(int)
@@ -688,26 +921,6 @@ void MainWindow::updateToggleButtonState(QToolButton *button, bool active)
     button->update();
 }
 
-QString MainWindow::errorCodeToMessage(const QString &code) const
-{
-    const QString upper = code.toUpper();
-    if (upper == QLatin1String("ERR_INVALID_QTY"))
-        return tr("Quantity must be positive");
-    if (upper == QLatin1String("ERR_INVALID_PRICE"))
-        return tr("Enter a valid price");
-    if (upper == QLatin1String("ERR_INVALID_SYMBOL"))
-        return tr("Enter a symbol");
-    if (upper == QLatin1String("ERR_INVALID_SIDE"))
-        return tr("Unsupported order side");
-    if (upper == QLatin1String("ERR_INSUFFICIENT_FUNDS"))
-        return tr("Insufficient available funds");
-    if (upper == QLatin1String("ERR_INSUFFICIENT_MARGIN"))
-        return tr("Insufficient margin");
-    if (upper == QLatin1String("ERR_PARTIAL_FILL"))
-        return tr("Partial fill");
-    return code;
-}
-
 void MainWindow::applyTheme(Theme theme)
 {
     m_theme = theme;
@@ -749,7 +962,7 @@ QString MainWindow::styleSheetForTheme(Theme theme) const
             "QToolButton#panelToggle:hover { background-color: #d0d6ea; }"
             "QToolButton#themeToggle { border: 1px solid #ccd2e2; border-radius: 12px; background-color: #eef1f8; padding: 4px 10px; }"
             "QToolButton#themeToggle:hover { background-color: #d9def0; }"
-            "QListWidget, QTableWidget { background-color: #ffffff; border: 1px solid #d4d9e5; border-radius: 8px; color: #1b2332; }"
+            "QListWidget, QTableView { background-color: #ffffff; border: 1px solid #d4d9e5; border-radius: 8px; color: #1b2332; }"
             "QHeaderView::section { background-color: #eef1f8; border: none; color: #4a556f; }"
             "QLabel#sectionTitle { font-weight: 600; font-size: 14px; color: #4a556f; }"
             "QLabel#metricValue { font-size: 18px; font-weight: 600; color: #1b2332; }"
@@ -772,16 +985,16 @@ QString MainWindow::styleSheetForTheme(Theme theme) const
         "QToolButton#panelToggle:hover { background-color: #283051; }"
         "QToolButton#themeToggle { border: 1px solid rgba(70, 80, 110, 0.7); border-radius: 12px; background-color: #121622; padding: 4px 10px; color: #e6ecf4; }"
         "QToolButton#themeToggle:hover { background-color: #1f2640; }"
-        "QListWidget, QTableWidget { background-color: #0f1320; border: 1px solid #2f3850; border-radius: 8px; color: #e6ecf4; }"
+        "QListWidget, QTableView { background-color: #0f1320; border: 1px solid #2f3850; border-radius: 8px; color: #e6ecf4; }"
         "QHeaderView::section { background-color: #1b2133; border: none; color: #aeb6d9; }"
         "QLabel#sectionTitle { font-weight: 600; font-size: 14px; color: #aeb6d9; }"
         "QLabel#metricValue { font-size: 18px; font-weight: 600; color: #e6ecf4; }"
     );
 }
 
-void MainWindow::onOrderRejected(const QString &symbol, const QString &errorCode, double rejectedQuantity)
+void MainWindow::onOrderRejected(const QString &symbol, RejectReason reason, double rejectedQuantity)
 {
-    QString message = errorCodeToMessage(errorCode);
+    QString message = OrdersModel::reasonMessage(reason);
     if (rejectedQuantity > 0.0) {
         QLocale locale;
         message = tr("%1 (rejected %2)")
@@ -791,6 +1004,38 @@ void MainWindow::onOrderRejected(const QString &symbol, const QString &errorCode
     m_statusLabel->setText(tr("⚠️ %1 [%2]").arg(message, symbol));
 }
 
+void MainWindow::onGridToggled(bool checked)
+{
+    if (checked && m_gridDirty)
+        rebuildChartGrid();
+    m_chartStack->setCurrentIndex(checked ? 1 : 0);
+}
+
+void MainWindow::onExportChart()
+{
+    const QString symbol = m_chart->symbol();
+    if (symbol.isEmpty()) {
+        m_statusLabel->setText(tr("⚠️ Nothing to export"));
+        return;
+    }
+
+    const QString path = QFileDialog::getSaveFileName(this, tr("Export Chart"),
+                                                      symbol + QStringLiteral(".png"),
+                                                      tr("PNG images (*.png)"));
+    if (path.isEmpty())
+        return;
+
+    // Tiles render on the thread pool while the UI thread waits, so no new
+    // candles land mid-export.
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    const QImage image = m_chart->exportImage();
+    const bool saved = !image.isNull() && image.save(path, "PNG");
+    QApplication::restoreOverrideCursor();
+
+    m_statusLabel->setText(saved ? tr("Exported %1").arg(QFileInfo(path).fileName())
+                                 : tr("⚠️ Export failed"));
+}
+
 void MainWindow::onThemeToggled(bool checked)
 {
     applyTheme(checked ? Theme::Light : Theme::Dark);
@@ -975,9 +1220,10 @@ void MainWindow::onPlaceOrder()
         return;
 
     const QString symbol = m_symbolEdit->text().trimmed().toUpper();
-    const QString side = m_orderSideCombo->currentText().toUpper();
+    const OrderSide side = m_orderSideCombo->currentIndex() == 1 ? OrderSide::Sell : OrderSide::Buy;
     const double quantity = m_orderQtyEdit->text().toDouble();
     double price = m_orderPriceEdit->text().toDouble();
+    const double stop = m_orderStopEdit->text().toDouble();
 
     if (symbol.isEmpty() || quantity <= 0.0) {
         m_statusLabel->setText("⚠️ Invalid order");
@@ -985,10 +1231,17 @@ void MainWindow::onPlaceOrder()
     }
 
     const OrderManager::OrderType type = currentOrderType();
-    if (type == OrderManager::OrderType::Limit && price <= 0.0) {
+    if ((type == OrderManager::OrderType::Limit || type == OrderManager::OrderType::StopLimit)
+            && price <= 0.0) {
         m_statusLabel->setText("⚠️ Enter limit price");
         return;
     }
+    if (isStopType(type) && stop <= 0.0) {
+        m_statusLabel->setText(type == OrderManager::OrderType::TrailingStop
+                               ? "⚠️ Enter trail distance"
+                               : "⚠️ Enter stop price");
+        return;
+    }
 
     if (type == OrderManager::OrderType::Market && price <= 0.0) {
         const Quote referenceQuote = m_chartController ? m_chartController->lastQuote() : m_lastQuote;
@@ -1002,32 +1255,35 @@ void MainWindow::onPlaceOrder()
         price = referencePrice;
     }
 
-    const OrderManager::OrderPlacementResult result = m_tradingController->placeOrder(type, symbol, side, quantity, price);
+    OrderRequest request;
+    request.type = type;
+    request.symbol = symbol;
+    request.side = side;
+    request.quantity = quantity;
+    request.price = price;
+    if (type == OrderManager::OrderType::TrailingStop)
+        request.trailAmount = stop;
+    else
+        request.stopPrice = stop;
+    request.timeInForce = static_cast<TimeInForce>(std::max(0, m_orderTifCombo->currentIndex()));
+    if (request.timeInForce == TimeInForce::GTD)
+        request.expiresAt = m_orderExpiryEdit->dateTime().toMSecsSinceEpoch();
+    const OrderManager::OrderPlacementResult result = m_tradingController->placeOrder(request);
 
     if (!result.accepted) {
-        m_statusLabel->setText(QStringLiteral("❌ %1").arg(errorCodeToMessage(result.errorCode)));
+        m_statusLabel->setText(QStringLiteral("❌ %1").arg(OrdersModel::reasonMessage(result.reason)));
         return;
     }
 
     QString statusText;
     if (result.partial) {
-        const QString reason = result.errorCode.isEmpty()
+        const QString reason = result.reason == RejectReason::None
                 ? tr("Partial fill")
-                : errorCodeToMessage(result.errorCode);
+                : OrdersModel::reasonMessage(result.reason);
         const double rejectedQty = result.rejectedQuantity;
         if (rejectedQty > 0.0) {
-            auto formatQty = [this](double value) {
-                QString text = QString::number(value, 'f', m_quantityPrecision);
-                if (text.contains('.')) {
-                    while (text.endsWith('0'))
-                        text.chop(1);
-                    if (text.endsWith('.'))
-                        text.chop(1);
-                }
-                return text;
-            };
             statusText = tr("⚠️ %1 (rejected %2)")
-                    .arg(reason, formatQty(rejectedQty));
+                    .arg(reason, OrdersModel::formatQuantity(rejectedQty, m_quantityPrecision));
         } else {
             statusText = tr("⚠️ %1").arg(reason);
         }
@@ -1045,6 +1301,35 @@ void MainWindow::onPlaceOrder()
     }
 }
 
+void MainWindow::onImportBasket()
+{
+    if (!m_tradingController)
+        return;
+
+    const QString path = QFileDialog::getOpenFileName(this, tr("Import Basket"), QString(),
+                                                      tr("CSV files (*.csv);;All files (*)"));
+    if (path.isEmpty())
+        return;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        m_statusLabel->setText(tr("⚠️ Cannot read %1").arg(QFileInfo(path).fileName()));
+        return;
+    }
+    const BasketImport::Result basket = BasketImport::parseCsv(QString::fromUtf8(file.readAll()));
+    for (const QString &error : basket.errors)
+        qWarning() << "basket import:" << error;
+
+    const auto results = m_tradingController->placeOrders(
+        std::span<const OrderRequest>(basket.orders.constData(), basket.orders.size()));
+    const auto accepted = std::count_if(results.cbegin(), results.cend(),
+                                        [](const auto &result) { return result.accepted; });
+    const int skipped = static_cast<int>(basket.errors.size() + results.size() - accepted);
+    m_statusLabel->setText(skipped == 0
+                           ? tr("✅ Placed %1 orders").arg(accepted)
+                           : tr("⚠️ Placed %1 orders, %2 skipped").arg(accepted).arg(skipped));
+}
+
 void MainWindow::onCancelSelectedOrder()
 {
     if (!m_tradingController)
@@ -1055,77 +1340,56 @@ void MainWindow::onCancelSelectedOrder()
     const QModelIndexList selected = selection->selectedRows();
     if (selected.isEmpty())
         return;
-    const int row = selected.first().row();
-    bool ok = false;
-    QTableWidgetItem *idItem = m_ordersTable->item(row, 0);
-    if (!idItem)
-        return;
-    int id = idItem->data(Qt::UserRole).toInt(&ok);
-    if (!ok)
-        id = idItem->text().toInt(&ok);
-    if (ok && m_tradingController->cancelOrder(id)) {
+    const int id = selected.first().data(OrdersModel::OrderIdRole).toInt();
+    if (m_tradingController->cancelOrder(id)) {
         m_statusLabel->setText("✅ Order cancelled");
     }
 }
 
-void MainWindow::onOrderSelectionChanged()
+void MainWindow::onAmendSelectedOrder()
 {
-    const bool hasSelection = !m_ordersTable->selectedItems().isEmpty();
-    if (m_cancelOrderButton)
-        m_cancelOrderButton->setEnabled(hasSelection);
+    if (!m_tradingController)
+        return;
+    auto *selection = m_ordersTable->selectionModel();
+    if (!selection)
+        return;
+    const QModelIndexList selected = selection->selectedRows();
+    if (selected.isEmpty())
+        return;
+    const int id = selected.first().data(OrdersModel::OrderIdRole).toInt();
+    const auto result = m_tradingController->amendOrder(id,
+                                                        m_orderPriceEdit->text().toDouble(),
+                                                        m_orderQtyEdit->text().toDouble());
+    m_statusLabel->setText(result.accepted
+                           ? QStringLiteral("✅ Order amended")
+                           : QStringLiteral("❌ %1").arg(OrdersModel::reasonMessage(result.reason)));
 }
 
-void MainWindow::refreshOrders(const QList<Order> &orders)
+void MainWindow::onCancelAllOrders()
 {
-    m_ordersTable->setRowCount(orders.size());
-    int row = 0;
-    auto formatQuantity = [this](double value) {
-        QString text = QString::number(value, 'f', m_quantityPrecision);
-        if (text.contains('.')) {
-            while (text.endsWith('0'))
-                text.chop(1);
-            if (text.endsWith('.'))
-                text.chop(1);
-        }
-        return text;
-    };
-    QLocale locale;
-    for (const Order &order : orders) {
-        auto makeItem = [&](int column, const QString &text) {
-            auto *item = new QTableWidgetItem(text);
-            item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
-            if (column == 9 && !order.errorCode.isEmpty())
-                item->setToolTip(errorCodeToMessage(order.errorCode));
-            m_ordersTable->setItem(row, column, item);
-        };
-
-        auto *idItem = new QTableWidgetItem(QString::number(order.id));
-        idItem->setData(Qt::UserRole, order.id);
-        idItem->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
-        m_ordersTable->setItem(row, 0, idItem);
-
-        makeItem(1, order.symbol);
-        makeItem(2, order.side);
-        makeItem(3, order.type);
-        const double requested = order.requestedQuantity > 0.0
-                ? order.requestedQuantity
-                : order.quantity;
-        makeItem(4, formatQuantity(requested));
-        makeItem(5, formatQuantity(order.quantity));
-        makeItem(6, formatQuantity(order.filledQuantity));
-        const double displayPrice = order.filledPrice > 0.0 ? order.filledPrice : order.price;
-        makeItem(7, locale.toString(displayPrice, 'f', 2));
-        makeItem(8, locale.toString(order.fee, 'f', 2));
-        QString status = order.status;
-        if (!order.errorCode.isEmpty())
-            status.append(QStringLiteral(" (%1)").arg(order.errorCode));
-        makeItem(9, status);
-        ++row;
-    }
-    onOrderSelectionChanged();
+    if (!m_tradingController)
+        return;
+    OrderFilter filter;
+    filter.symbol = m_orderSymbolFilter->text();
+    const int status = m_orderStatusFilter->currentData().toInt();
+    if (status >= 0)
+        filter.status = static_cast<OrderStatus>(status);
+    const int cancelled = m_tradingController->cancelAll(filter);
+    m_statusLabel->setText(cancelled > 0 ? tr("✅ Cancelled %1 orders").arg(cancelled)
+                                         : tr("No working orders"));
 }
 
-void MainWindow::refreshPortfolio(const PortfolioSnapshot &snapshot, const QList<Position> &positions)
+void MainWindow::onOrderSelectionChanged()
+{
+    const auto *selection = m_ordersTable->selectionModel();
+    const bool hasSelection = selection && selection->hasSelection();
+    if (m_cancelOrderButton)
+        m_cancelOrderButton->setEnabled(hasSelection);
+    if (m_amendOrderButton)
+        m_amendOrderButton->setEnabled(hasSelection);
+}
+
+void MainWindow::refreshPortfolio(const PortfolioSnapshot &snapshot)
 {
     QLocale locale;
     auto setCurrency = [&](QLabel *label, double value) {
@@ -1156,32 +1420,6 @@ void MainWindow::refreshPortfolio(const PortfolioSnapshot &snapshot, const QList
     } else {
         m_availableFundsLabel->setStyleSheet("");
     }
-
-    m_positionsTable->setRowCount(positions.size());
-    int row = 0;
-    auto formatQuantity = [this](double value) {
-        QString text = QString::number(value, 'f', m_quantityPrecision);
-        if (text.contains('.')) {
-            while (text.endsWith('0'))
-                text.chop(1);
-            if (text.endsWith('.'))
-                text.chop(1);
-        }
-        return text;
-    };
-    for (const Position &pos : positions) {
-        auto setItem = [&](int column, const QString &text) {
-            auto *item = new QTableWidgetItem(text);
-            item->setFlags(Qt::ItemIsEnabled);
-            m_positionsTable->setItem(row, column, item);
-        };
-        setItem(0, pos.symbol);
-        setItem(1, formatQuantity(pos.qty));
-        setItem(2, locale.toString(pos.avgPx, 'f', 2));
-        setItem(3, locale.toString(pos.lastPrice, 'f', 2));
-        setItem(4, locale.toString(pos.unrealizedPnL, 'f', 2));
-        ++row;
-    }
 }
 
 void MainWindow::loadStateFromStorage()
@@ -1235,6 +1473,55 @@ void MainWindow::populateWatchlist(const QString &selectSymbol)
         m_watchlistView->setCurrentRow(0);
     }
     m_watchlistRemoveButton->setEnabled(!m_watchlist.isEmpty());
+
+    m_gridDirty = true;
+    if (m_gridToggle->isChecked())
+        rebuildChartGrid();
+}
+
+void MainWindow::rebuildChartGrid()
+{
+    m_gridDirty = false;
+    while (QLayoutItem *item = m_gridLayout->takeAt(0)) {
+        delete item->widget();
+        delete item;
+    }
+    m_gridCharts.clear();
+
+    CandleStore *store = m_chartController ? m_chartController->candleStore() : nullptr;
+    if (!store)
+        return;
+
+    const int columns = std::clamp(static_cast<int>(std::ceil(std::sqrt(m_watchlist.size()))), 1, 4);
+    const int smaId = store->indicatorId(IndicatorSpec::Kind::SMA);
+    for (int i = 0; i < m_watchlist.size(); ++i) {
+        QFrame *cell = new QFrame(m_gridContainer);
+        cell->setObjectName("chartPanel");
+        QVBoxLayout *cellLayout = new QVBoxLayout(cell);
+        cellLayout->setContentsMargins(6, 4, 6, 6);
+        cellLayout->setSpacing(2);
+        cellLayout->addWidget(new QLabel(m_watchlist.at(i), cell));
+
+        ChartWidget *chart = new ChartWidget(cell);
+        chart->setCompact(true);
+        chart->setSource(store, m_watchlist.at(i));
+        chart->setPriceOverlays({smaId});
+        if (m_tradingController)
+            chart->setOrderOverlays(m_tradingController->orderOverlays());
+        connect(chart, &ChartWidget::historyRequested,
+                m_chartController, &ChartController::requestHistory);
+        // Hovering one cell lines the others up on the same time.
+        connect(chart, &ChartWidget::crosshairMoved, this, [this, chart](qint64 ms) {
+            for (ChartWidget *other : std::as_const(m_gridCharts)) {
+                if (other != chart)
+                    other->setCrosshairTime(ms);
+            }
+        });
+        cellLayout->addWidget(chart, 1);
+
+        m_gridLayout->addWidget(cell, i / columns, i % columns);
+        m_gridCharts.append(chart);
+    }
 }
 
 void MainWindow::persistWatchlist()
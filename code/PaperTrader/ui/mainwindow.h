@@ -4,6 +4,7 @@
 #include <QPushButton>
 #include <QLineEdit>
 #include <QLabel>
+#include <QDoubleSpinBox>
 #include "chartwidget.h"
 #include "core/ordermanager.h"
 #include "core/models/order.h"
@@ -12,15 +13,21 @@
 #include "core/models/quote.h"
 #include "controllers/chartcontroller.h"
 #include "controllers/tradingcontroller.h"
+#include "models/orderhistorymodel.h"
+#include "models/ordersmodel.h"
+#include "models/positionsmodel.h"
 
 class QListWidget;
 class QListWidgetItem;
-class QTableWidget;
+class QTableView;
 class QToolButton;
 class QFrame;
 class QIntValidator;
 class QDoubleValidator;
 class QSplitter;
+class QStackedWidget;
+class QGridLayout;
+class QDateTimeEdit;
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -42,13 +49,17 @@ private slots:
     void onOrderSideChanged(int index);
     void onPlaceOrder();
     void onCancelSelectedOrder();
+    void onAmendSelectedOrder();
+    void onCancelAllOrders();
+    void onImportBasket();
     void onOrderSelectionChanged();
-    void refreshOrders(const QList<Order> &orders);
-    void refreshPortfolio(const PortfolioSnapshot &snapshot, const QList<Position> &positions);
+    void refreshPortfolio(const PortfolioSnapshot &snapshot);
     void onOrderPanelToggled(bool expanded);
     void onPortfolioToggled(bool expanded);
-    void onOrderRejected(const QString &symbol, const QString &errorCode, double rejectedQuantity);
+    void onOrderRejected(const QString &symbol, RejectReason reason, double rejectedQuantity);
     void onThemeToggled(bool checked);
+    void onGridToggled(bool checked);
+    void onExportChart();
 
 private:
     ChartWidget *m_chart;
@@ -59,8 +70,18 @@ private:
     QPushButton *m_startButton;
     QPushButton *m_stopButton;
     QLabel     *m_statusLabel;
+    QToolButton *m_gridToggle;
+    QToolButton *m_tickModeToggle;
+    QToolButton *m_exportButton;
     QToolButton *m_themeToggle;
 
+    // Grid mode: one compact chart per watchlist symbol over the shared store
+    QStackedWidget *m_chartStack = nullptr;
+    QWidget        *m_gridContainer = nullptr;
+    QGridLayout    *m_gridLayout = nullptr;
+    QList<ChartWidget *> m_gridCharts;
+    bool m_gridDirty = true;
+
     // Watchlist UI
     QToolButton *m_watchlistToggle;
     QWidget     *m_watchlistContainer;
@@ -74,9 +95,24 @@ private:
     QComboBox   *m_orderSideCombo;
     QLineEdit   *m_orderQtyEdit;
     QLineEdit   *m_orderPriceEdit;
+    QLineEdit   *m_orderStopEdit;
+    QComboBox   *m_orderTifCombo;
+    QDateTimeEdit *m_orderExpiryEdit;
+    QComboBox   *m_fillModelCombo;
+    QDoubleSpinBox *m_participationSpin;
     QPushButton *m_placeOrderButton;
     QPushButton *m_cancelOrderButton;
-    QTableWidget *m_ordersTable;
+    QPushButton *m_amendOrderButton;
+    QPushButton *m_cancelAllButton;
+    QPushButton *m_importBasketButton;
+    QComboBox   *m_orderStatusFilter;
+    QLineEdit   *m_orderSymbolFilter;
+    QTableView  *m_ordersTable;
+    OrdersModel *m_ordersModel;
+    OrdersFilterModel *m_ordersProxy;
+    QTableView  *m_historyTable;
+    OrderHistoryModel *m_historyModel;
+    OrdersFilterModel *m_historyProxy;
     QToolButton *m_orderToggleButton;
     QWidget     *m_orderContainer;
 
@@ -88,7 +124,8 @@ private:
     QLabel      *m_accountMarginLabel;
     QLabel      *m_orderMarginLabel;
     QLabel      *m_availableFundsLabel;
-    QTableWidget *m_positionsTable;
+    QTableView   *m_positionsTable;
+    PositionsModel *m_positionsModel;
     QToolButton  *m_portfolioToggleButton;
     QWidget      *m_portfolioContent;
 
@@ -125,6 +162,7 @@ private:
     void buildOrderPanel(QFrame *panel);
     void buildPortfolioPanel(QFrame *panel);
     void populateWatchlist(const QString &selectSymbol = QString());
+    void rebuildChartGrid();
     void persistWatchlist();
     void persistSettings();
     void loadStateFromStorage();
@@ -135,7 +173,6 @@ private:
     void togglePortfolioPanel(bool expanded, bool animate);
     void updateOrderButtonAccent();
     void updateToggleButtonState(QToolButton *button, bool active);
-    QString errorCodeToMessage(const QString &code) const;
     void applyTheme(Theme theme);
     QString styleSheetForTheme(Theme theme) const;
 };
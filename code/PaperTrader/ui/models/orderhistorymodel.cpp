@@ -0,0 +1,39 @@
+#include "orderhistorymodel.h"
+
+#include <algorithm>
+
+#include "core/orderhistory.h"
+
+OrderHistoryModel::OrderHistoryModel(QObject *parent)
+    : OrdersModel(parent)
+{
+}
+
+void OrderHistoryModel::setHistory(const OrderHistory *history)
+{
+    m_history = history;
+    m_oldestLoaded = m_newestLoaded = history ? history->size() : 0;
+    setOrders({});
+}
+
+bool OrderHistoryModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && m_history && m_oldestLoaded > 0;
+}
+
+void OrderHistoryModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent))
+        return;
+    const int first = std::max(0, m_oldestLoaded - kPageSize);
+    upsertOrders(m_history->page(first, m_oldestLoaded - first));
+    m_oldestLoaded = first;
+}
+
+void OrderHistoryModel::refresh()
+{
+    if (!m_history || m_history->size() <= m_newestLoaded)
+        return;
+    upsertOrders(m_history->page(m_newestLoaded, m_history->size() - m_newestLoaded));
+    m_newestLoaded = m_history->size();
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "ordersmodel.h"
+
+class OrderHistory;
+
+/**
+ * OrderHistoryModel: finished orders, newest first once sorted.
+ *
+ * Rows are read from the OrderHistory a page at a time as the view scrolls
+ * back (canFetchMore/fetchMore); refresh() picks up orders archived since
+ * the last call.
+ */
+class OrderHistoryModel : public OrdersModel {
+    Q_OBJECT
+public:
+    explicit OrderHistoryModel(QObject *parent = nullptr);
+
+    void setHistory(const OrderHistory *history);
+
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+public slots:
+    void refresh();
+
+private:
+    static constexpr int kPageSize = 200;
+
+    const OrderHistory *m_history = nullptr;
+    int m_oldestLoaded = 0;   // history position of the oldest loaded row
+    int m_newestLoaded = 0;   // one past the newest loaded row
+};
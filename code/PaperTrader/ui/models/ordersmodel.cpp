@@ -0,0 +1,295 @@
+#include "ordersmodel.h"
+
+#include <QLocale>
+
+OrdersModel::OrdersModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int OrdersModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_orders.size();
+}
+
+int OrdersModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant OrdersModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_orders.size())
+        return {};
+
+    const Order &order = m_orders.at(index.row());
+    const double requested = order.requestedQuantity > 0.0 ? order.requestedQuantity : order.quantity;
+    // Unfilled stops without a limit show their trigger level.
+    const double price = order.filledPrice > 0.0 ? order.filledPrice
+                         : order.price > 0.0    ? order.price
+                                                : order.stopPrice;
+
+    if (role == OrderIdRole)
+        return order.id;
+
+    if (role == SortRole) {
+        switch (index.column()) {
+        case Id: return order.id;
+        case Symbol: return order.symbol;
+        case Side: return static_cast<int>(order.side);
+        case Type: return static_cast<int>(order.type);
+        case Requested: return requested;
+        case Working: return order.quantity;
+        case Filled: return order.filledQuantity;
+        case Price: return price;
+        case Fee: return order.fee;
+        case Status: return static_cast<int>(order.status);
+        default: return {};
+        }
+    }
+
+    if (role == Qt::ToolTipRole) {
+        if (index.column() == Status && order.rejectReason != RejectReason::None)
+            return reasonMessage(order.rejectReason);
+        return {};
+    }
+
+    if (role == Qt::TextAlignmentRole) {
+        if (index.column() >= Requested && index.column() <= Fee)
+            return int(Qt::AlignRight | Qt::AlignVCenter);
+        return {};
+    }
+
+    if (role != Qt::DisplayRole)
+        return {};
+
+    QLocale locale;
+    switch (index.column()) {
+    case Id: return QString::number(order.id);
+    case Symbol: return order.symbol;
+    case Side: return sideName(order.side);
+    case Type:
+        if (order.timeInForce == TimeInForce::GTC)
+            return typeName(order.type);
+        return QStringLiteral("%1 %2").arg(typeName(order.type), timeInForceName(order.timeInForce));
+    case Requested: return formatQuantity(requested, m_quantityPrecision);
+    case Working: return formatQuantity(order.quantity, m_quantityPrecision);
+    case Filled: return formatQuantity(order.filledQuantity, m_quantityPrecision);
+    case Price: return locale.toString(price, 'f', 2);
+    case Fee: return locale.toString(order.fee, 'f', 2);
+    case Status:
+        if (order.rejectReason == RejectReason::None)
+            return statusName(order.status);
+        return QStringLiteral("%1 (%2)").arg(statusName(order.status), reasonMessage(order.rejectReason));
+    default: return {};
+    }
+}
+
+QVariant OrdersModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QAbstractTableModel::headerData(section, orientation, role);
+
+    switch (section) {
+    case Id: return tr("ID");
+    case Symbol: return tr("Symbol");
+    case Side: return tr("Side");
+    case Type: return tr("Type");
+    case Requested: return tr("Requested");
+    case Working: return tr("Working");
+    case Filled: return tr("Filled");
+    case Price: return tr("Price");
+    case Fee: return tr("Fee");
+    case Status: return tr("Status");
+    default: return {};
+    }
+}
+
+void OrdersModel::setOrders(const QList<Order> &orders)
+{
+    beginResetModel();
+    m_orders.clear();
+    m_rowById.clear();
+    m_orders.reserve(orders.size());
+    for (const Order &order : orders) {
+        m_rowById.insert(order.id, m_orders.size());
+        m_orders.append(order);
+    }
+    endResetModel();
+}
+
+void OrdersModel::upsertOrder(const Order &order)
+{
+    const int row = rowForId(order.id);
+    if (row >= 0) {
+        m_orders[row] = order;
+        emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+        return;
+    }
+
+    const int last = m_orders.size();
+    beginInsertRows(QModelIndex(), last, last);
+    m_rowById.insert(order.id, last);
+    m_orders.append(order);
+    endInsertRows();
+}
+
+void OrdersModel::upsertOrders(const QList<Order> &orders)
+{
+    QList<Order> added;
+    for (const Order &order : orders) {
+        const int row = rowForId(order.id);
+        if (row < 0) {
+            added.append(order);
+            continue;
+        }
+        m_orders[row] = order;
+        emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+    }
+    if (added.isEmpty())
+        return;
+
+    const int first = m_orders.size();
+    beginInsertRows(QModelIndex(), first, first + added.size() - 1);
+    for (const Order &order : added) {
+        m_rowById.insert(order.id, m_orders.size());
+        m_orders.append(order);
+    }
+    endInsertRows();
+}
+
+void OrdersModel::removeOrder(int orderId)
+{
+    const int row = rowForId(orderId);
+    if (row < 0)
+        return;
+
+    beginRemoveRows(QModelIndex(), row, row);
+    m_orders.remove(row);
+    m_rowById.remove(orderId);
+    // Only the rows after the gap move up.
+    for (int i = row; i < m_orders.size(); ++i)
+        m_rowById.insert(m_orders.at(i).id, i);
+    endRemoveRows();
+}
+
+void OrdersModel::setQuantityPrecision(int precision)
+{
+    if (precision == m_quantityPrecision)
+        return;
+    m_quantityPrecision = precision;
+    if (!m_orders.isEmpty())
+        emit dataChanged(index(0, Requested), index(m_orders.size() - 1, Filled), {Qt::DisplayRole});
+}
+
+QString OrdersModel::sideName(OrderSide side)
+{
+    return side == OrderSide::Buy ? tr("BUY") : tr("SELL");
+}
+
+QString OrdersModel::typeName(OrderType type)
+{
+    switch (type) {
+    case OrderType::Market: return tr("Market");
+    case OrderType::Limit: return tr("Limit");
+    case OrderType::Stop: return tr("Stop");
+    case OrderType::StopLimit: return tr("Stop Limit");
+    case OrderType::TrailingStop: return tr("Trailing Stop");
+    }
+    return {};
+}
+
+QString OrdersModel::statusName(OrderStatus status)
+{
+    switch (status) {
+    case OrderStatus::Open: return tr("Open");
+    case OrderStatus::PartiallyFilled: return tr("Partially Filled");
+    case OrderStatus::Filled: return tr("Filled");
+    case OrderStatus::Cancelled: return tr("Cancelled");
+    case OrderStatus::Rejected: return tr("Rejected");
+    }
+    return {};
+}
+
+QString OrdersModel::timeInForceName(TimeInForce tif)
+{
+    switch (tif) {
+    case TimeInForce::GTC: return tr("GTC");
+    case TimeInForce::IOC: return tr("IOC");
+    case TimeInForce::FOK: return tr("FOK");
+    case TimeInForce::GTD: return tr("GTD");
+    case TimeInForce::DAY: return tr("DAY");
+    }
+    return {};
+}
+
+QString OrdersModel::reasonMessage(RejectReason reason)
+{
+    switch (reason) {
+    case RejectReason::None: return {};
+    case RejectReason::InvalidSymbol: return tr("Enter a symbol");
+    case RejectReason::InvalidQuantity: return tr("Quantity must be positive");
+    case RejectReason::InvalidPrice: return tr("Enter a valid price");
+    case RejectReason::InsufficientFunds: return tr("Insufficient available funds");
+    case RejectReason::InsufficientMargin: return tr("Insufficient margin");
+    case RejectReason::PartialFill: return tr("Partial fill");
+    case RejectReason::InvalidTimeInForce: return tr("Time in force not valid for this order");
+    case RejectReason::Unfillable: return tr("Could not fill immediately");
+    case RejectReason::Expired: return tr("Expired");
+    case RejectReason::NotAmendable: return tr("Order can no longer be amended");
+    }
+    return {};
+}
+
+QString OrdersModel::formatQuantity(double value, int precision)
+{
+    QString text = QString::number(value, 'f', precision);
+    if (text.contains('.')) {
+        while (text.endsWith('0'))
+            text.chop(1);
+        if (text.endsWith('.'))
+            text.chop(1);
+    }
+    return text;
+}
+
+OrdersFilterModel::OrdersFilterModel(QObject *parent)
+    : QSortFilterProxyModel(parent)
+{
+    setSortRole(OrdersModel::SortRole);
+    setDynamicSortFilter(true);
+}
+
+void OrdersFilterModel::setStatusFilter(std::optional<OrderStatus> status)
+{
+    if (status == m_status)
+        return;
+    m_status = status;
+    invalidateFilter();
+}
+
+void OrdersFilterModel::setSymbolFilter(const QString &symbol)
+{
+    const QString trimmed = symbol.trimmed();
+    if (trimmed == m_symbol)
+        return;
+    m_symbol = trimmed;
+    invalidateFilter();
+}
+
+bool OrdersFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+    if (sourceParent.isValid())
+        return false;
+    const auto *orders = qobject_cast<const OrdersModel *>(sourceModel());
+    if (!orders)
+        return true;
+
+    // Read the order directly instead of going through data() and QVariant.
+    const Order &order = orders->orderAt(sourceRow);
+    if (m_status && order.status != *m_status)
+        return false;
+    if (!m_symbol.isEmpty() && !order.symbol.startsWith(m_symbol, Qt::CaseInsensitive))
+        return false;
+    return true;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QList>
+#include <QSortFilterProxyModel>
+#include <QString>
+#include <QVector>
+#include <optional>
+
+#include "core/models/order.h"
+
+/**
+ * OrdersModel: the orders table, one row per order in arrival order.
+ *
+ * Rows change through the order manager's deltas: a new id inserts one row,
+ * a known id reports dataChanged for its row only. Cells are formatted in
+ * data() when the view asks for them, so off-screen rows cost nothing.
+ */
+class OrdersModel : public QAbstractTableModel {
+    Q_OBJECT
+public:
+    enum Column { Id, Symbol, Side, Type, Requested, Working, Filled, Price, Fee, Status, ColumnCount };
+    // Unformatted cell value, for sorting and filtering.
+    static constexpr int SortRole = Qt::UserRole;
+    static constexpr int OrderIdRole = Qt::UserRole + 1;
+
+    explicit OrdersModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    // Replaces every row (initial sync).
+    void setOrders(const QList<Order> &orders);
+    void upsertOrder(const Order &order);
+    // Batch form: changed rows repaint, new rows arrive as one insert.
+    void upsertOrders(const QList<Order> &orders);
+    void removeOrder(int orderId);
+
+    const Order &orderAt(int row) const { return m_orders.at(row); }
+    int rowForId(int orderId) const { return m_rowById.value(orderId, -1); }
+
+    void setQuantityPrecision(int precision);
+
+    // Display text for the core's order enums.
+    static QString sideName(OrderSide side);
+    static QString typeName(OrderType type);
+    static QString statusName(OrderStatus status);
+    static QString timeInForceName(TimeInForce tif);
+    static QString reasonMessage(RejectReason reason);
+    // Fixed-point quantity with trailing zeros dropped ("1.5", not "1.500000").
+    static QString formatQuantity(double value, int precision);
+
+private:
+    QVector<Order> m_orders;
+    QHash<int, int> m_rowById;
+    int m_quantityPrecision = 6;
+};
+
+/**
+ * OrdersFilterModel: sorts the orders table on raw values and narrows it to
+ * one status and/or a symbol prefix. Unset filters accept every row.
+ */
+class OrdersFilterModel : public QSortFilterProxyModel {
+    Q_OBJECT
+public:
+    explicit OrdersFilterModel(QObject *parent = nullptr);
+
+    void setStatusFilter(std::optional<OrderStatus> status);
+    void setSymbolFilter(const QString &symbol);
+    std::optional<OrderStatus> statusFilter() const { return m_status; }
+    QString symbolFilter() const { return m_symbol; }
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+private:
+    std::optional<OrderStatus> m_status;
+    QString m_symbol;
+};
@@ -0,0 +1,136 @@
+#include "positionsmodel.h"
+#include "ordersmodel.h"
+
+#include <QColor>
+#include <QLocale>
+
+PositionsModel::PositionsModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int PositionsModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_positions.size();
+}
+
+int PositionsModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant PositionsModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_positions.size())
+        return {};
+
+    const Position &pos = m_positions.at(index.row());
+    if (role == SortRole) {
+        switch (index.column()) {
+        case Symbol: return pos.symbol;
+        case Quantity: return pos.qty;
+        case AvgPrice: return pos.avgPx;
+        case Last: return pos.lastPrice;
+        case Unrealized: return pos.unrealizedPnL;
+        default: return {};
+        }
+    }
+
+    if (role == Qt::ForegroundRole && index.column() == Unrealized) {
+        if (pos.unrealizedPnL > 0.0)
+            return QColor(0x12, 0xd9, 0x80);
+        if (pos.unrealizedPnL < 0.0)
+            return QColor(0xff, 0x64, 0x76);
+        return {};
+    }
+
+    if (role == Qt::TextAlignmentRole) {
+        if (index.column() != Symbol)
+            return int(Qt::AlignRight | Qt::AlignVCenter);
+        return {};
+    }
+
+    if (role != Qt::DisplayRole)
+        return {};
+
+    QLocale locale;
+    switch (index.column()) {
+    case Symbol: return pos.symbol;
+    case Quantity: return OrdersModel::formatQuantity(pos.qty, m_quantityPrecision);
+    case AvgPrice: return locale.toString(pos.avgPx, 'f', 2);
+    case Last: return locale.toString(pos.lastPrice, 'f', 2);
+    case Unrealized: return locale.toString(pos.unrealizedPnL, 'f', 2);
+    default: return {};
+    }
+}
+
+QVariant PositionsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QAbstractTableModel::headerData(section, orientation, role);
+
+    switch (section) {
+    case Symbol: return tr("Symbol");
+    case Quantity: return tr("Qty");
+    case AvgPrice: return tr("Avg Price");
+    case Last: return tr("Last");
+    case Unrealized: return tr("Unrealized");
+    default: return {};
+    }
+}
+
+void PositionsModel::setPositions(const QList<Position> &positions)
+{
+    beginResetModel();
+    m_positions.clear();
+    m_rowBySymbol.clear();
+    m_positions.reserve(positions.size());
+    for (const Position &pos : positions) {
+        m_rowBySymbol.insert(pos.symbol, m_positions.size());
+        m_positions.append(pos);
+    }
+    endResetModel();
+}
+
+void PositionsModel::upsertPosition(const Position &position)
+{
+    const int row = rowForSymbol(position.symbol);
+    if (row >= 0) {
+        Position &current = m_positions[row];
+        // Price ticks leave quantity and cost untouched; repaint just the
+        // cells that moved.
+        const bool sizeChanged = current.qty != position.qty || current.avgPx != position.avgPx;
+        current = position;
+        emit dataChanged(index(row, sizeChanged ? Quantity : Last), index(row, Unrealized));
+        return;
+    }
+
+    const int last = m_positions.size();
+    beginInsertRows(QModelIndex(), last, last);
+    m_rowBySymbol.insert(position.symbol, last);
+    m_positions.append(position);
+    endInsertRows();
+}
+
+void PositionsModel::removePosition(const QString &symbol)
+{
+    const int row = rowForSymbol(symbol);
+    if (row < 0)
+        return;
+
+    beginRemoveRows(QModelIndex(), row, row);
+    m_positions.remove(row);
+    m_rowBySymbol.remove(symbol);
+    for (int i = row; i < m_positions.size(); ++i)
+        m_rowBySymbol.insert(m_positions.at(i).symbol, i);
+    endRemoveRows();
+}
+
+void PositionsModel::setQuantityPrecision(int precision)
+{
+    if (precision == m_quantityPrecision)
+        return;
+    m_quantityPrecision = precision;
+    if (!m_positions.isEmpty())
+        emit dataChanged(index(0, Quantity), index(m_positions.size() - 1, Quantity), {Qt::DisplayRole});
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QVector>
+
+#include "core/models/position.h"
+
+/**
+ * PositionsModel: open positions, one row per symbol.
+ *
+ * Price updates arrive per symbol and only repaint that row's cells; a new
+ * symbol appends a row and a flattened one removes it.
+ */
+class PositionsModel : public QAbstractTableModel {
+    Q_OBJECT
+public:
+    enum Column { Symbol, Quantity, AvgPrice, Last, Unrealized, ColumnCount };
+    static constexpr int SortRole = Qt::UserRole;
+
+    explicit PositionsModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    // Replaces every row (initial sync).
+    void setPositions(const QList<Position> &positions);
+    void upsertPosition(const Position &position);
+    void removePosition(const QString &symbol);
+
+    const Position &positionAt(int row) const { return m_positions.at(row); }
+    int rowForSymbol(const QString &symbol) const { return m_rowBySymbol.value(symbol, -1); }
+
+    void setQuantityPrecision(int precision);
+
+private:
+    QVector<Position> m_positions;
+    QHash<QString, int> m_rowBySymbol;
+    int m_quantityPrecision = 6;
+};